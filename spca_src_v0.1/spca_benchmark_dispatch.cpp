@@ -0,0 +1,329 @@
+// spca_benchmark_dispatch.
+#include "spca_benchmark_dispatch.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace PSAG_LOGGER;
+
+constexpr const char* ScriptDispatch = R"(
+__kernel void DispatchEmpty(__global const float* MatrixIn, __global float* MatrixOut) {}
+
+__kernel void DispatchTiny(__global const float* MatrixIn, __global float* MatrixOut) {
+    int width = get_global_size(0);
+
+    int i = get_global_id(0);
+    int j = get_global_id(1);
+
+    MatrixOut[j * width + i] = MatrixIn[j * width + i] * 2.0f + 1.0f;
+}
+)";
+
+namespace SpcaBenchmark {
+    using DispatchClock = chrono::steady_clock;
+
+    static double DispatchMicros(DispatchClock::time_point start) {
+        return chrono::duration<double, micro>(DispatchClock::now() - start).count();
+    }
+
+    // one thread launch samples(us).
+    struct DispatchSamples {
+        vector<double> SamplesEnqueue   = {};
+        vector<double> SamplesWait      = {};
+        vector<double> SamplesProfiling = {};
+        vector<double> SamplesSubmit    = {};
+        vector<double> SamplesExec      = {};
+        vector<double> SamplesTotal     = {};
+
+        void Merge(const DispatchSamples& other) {
+            SamplesEnqueue.insert  (SamplesEnqueue.end(),   other.SamplesEnqueue.begin(),   other.SamplesEnqueue.end());
+            SamplesWait.insert     (SamplesWait.end(),      other.SamplesWait.begin(),      other.SamplesWait.end());
+            SamplesProfiling.insert(SamplesProfiling.end(), other.SamplesProfiling.begin(), other.SamplesProfiling.end());
+            SamplesSubmit.insert   (SamplesSubmit.end(),    other.SamplesSubmit.begin(),    other.SamplesSubmit.end());
+            SamplesExec.insert     (SamplesExec.end(),      other.SamplesExec.begin(),      other.SamplesExec.end());
+            SamplesTotal.insert    (SamplesTotal.end(),     other.SamplesTotal.begin(),     other.SamplesTotal.end());
+        }
+    };
+
+    // enqueue => wait => profiling query, per launch.
+    static bool DispatchLaunches(
+        cl_command_queue queue, cl_kernel kernel, const size_t* global, size_t warmup, size_t repeat,
+        DispatchSamples& samples
+    ) {
+        for (size_t i = 0; i < warmup + repeat; ++i) {
+            cl_event Event = nullptr;
+            DispatchClock::time_point TimeEnqueue = DispatchClock::now();
+            // global mutex(enqueue) => contention visible.
+            cl_int ErrorCode = SpcaCLEnqueueNDRangeKernel(queue, kernel, 2, nullptr, global, nullptr, NULL, nullptr, &Event);
+            double TimeEnqueueUs = DispatchMicros(TimeEnqueue);
+            if (ErrorCode != CL_SUCCESS) {
+                PushLogger(LogError, ModuleTagBenchmark, "dispatch enqueue kernel, code: %i", ErrorCode);
+                return false;
+            }
+            DispatchClock::time_point TimeWait = DispatchClock::now();
+            ErrorCode = clWaitForEvents(1, &Event);
+            double TimeWaitUs = DispatchMicros(TimeWait);
+
+            DispatchClock::time_point TimeProfiling = DispatchClock::now();
+            cl_ulong TimeQueued = NULL, TimeStart = NULL, TimeEnd = NULL;
+            clGetEventProfilingInfo(Event, CL_PROFILING_COMMAND_QUEUED, sizeof(cl_ulong), &TimeQueued, nullptr);
+            clGetEventProfilingInfo(Event, CL_PROFILING_COMMAND_START,  sizeof(cl_ulong), &TimeStart,  nullptr);
+            clGetEventProfilingInfo(Event, CL_PROFILING_COMMAND_END,    sizeof(cl_ulong), &TimeEnd,    nullptr);
+            double TimeProfilingUs = DispatchMicros(TimeProfiling);
+            clReleaseEvent(Event);
+
+            if (ErrorCode != CL_SUCCESS) {
+                PushLogger(LogError, ModuleTagBenchmark, "dispatch wait event, code: %i", ErrorCode);
+                return false;
+            }
+            // warmup => discard.
+            if (i < warmup) continue;
+            samples.SamplesEnqueue.push_back(TimeEnqueueUs);
+            samples.SamplesWait.push_back(TimeWaitUs);
+            samples.SamplesProfiling.push_back(TimeProfilingUs);
+            samples.SamplesSubmit.push_back(TimeStart >= TimeQueued ? double(TimeStart - TimeQueued) * 1e-3 : 0.0);
+            samples.SamplesExec.push_back(TimeEnd >= TimeStart ? double(TimeEnd - TimeStart) * 1e-3 : 0.0);
+            samples.SamplesTotal.push_back(TimeEnqueueUs + TimeWaitUs);
+        }
+        return true;
+    }
+
+    bool SpcaBenchmarkDispatch::RunDispatchSetup(size_t device, const SpcaDispatchConfig& config) {
+        vector<double> TimesEnumerate = {}, TimesCalcCreate = {}, TimesContext = {}, TimesQueue = {};
+        vector<double> TimesBuild = {}, TimesKernel = {}, TimesInit = {}, TimesMemory = {}, TimesJob = {};
+
+        size_t MatrixSize = max(config.MatrixSize, (size_t)WORKGROUP_DEFAULT);
+        MatrixSize = MatrixSize / WORKGROUP_DEFAULT * WORKGROUP_DEFAULT;
+
+        SpcaIndexMatrix<float> JobMatrix = SpcaIndexMatrix<float>(SPCA_TYPE_MATRIX2D);
+        JobMatrix.IMatrixAlloc(MatrixSize, MatrixSize);
+
+        bool StatusFlag = true;
+        for (size_t i = 0; StatusFlag && i < config.SetupRepeat; ++i) {
+            DispatchClock::time_point TimeStart = DispatchClock::now();
+            {
+                OPENCL_TYPE_DEVICE DevicesEnumerate = {};
+            }
+            TimesEnumerate.push_back(DispatchMicros(TimeStart));
+
+            // raw phases: context => queue => program(build) => kernel.
+            CalcDeviceIndexCode = device;
+            cl_device_id DeviceHandle = nullptr;
+            TimeStart = DispatchClock::now();
+            cl_context Context = SpcaCreateContext(&DeviceHandle);
+            TimesContext.push_back(DispatchMicros(TimeStart));
+            if (Context == nullptr) {
+                StatusFlag = false;
+                break;
+            }
+            TimeStart = DispatchClock::now();
+            cl_command_queue Queue = SpcaCreateCommandQueue(Context, DeviceHandle);
+            TimesQueue.push_back(DispatchMicros(TimeStart));
+
+            TimeStart = DispatchClock::now();
+            cl_program Program = SpcaCreateProgram(Context, DeviceHandle, false, ScriptDispatch);
+            TimesBuild.push_back(DispatchMicros(TimeStart));
+
+            cl_kernel Kernel = nullptr;
+            if (Program != nullptr) {
+                TimeStart = DispatchClock::now();
+                Kernel = clCreateKernel(Program, "DispatchTiny", nullptr);
+                TimesKernel.push_back(DispatchMicros(TimeStart));
+            }
+            StatusFlag = Queue != nullptr && Program != nullptr && Kernel != nullptr;
+
+            if (Kernel  != nullptr) clReleaseKernel(Kernel);
+            if (Program != nullptr) clReleaseProgram(Program);
+            if (Queue   != nullptr) clReleaseCommandQueue(Queue);
+            clReleaseContext(Context);
+
+            // calc path: create(enumerate) => init system => memory objects => jobs.
+            TimeStart = DispatchClock::now();
+            SpcaMatrixCalc::SpcaMatrix2Calc* DispatchSPCA = new SpcaMatrixCalc::SpcaMatrix2Calc();
+            TimesCalcCreate.push_back(DispatchMicros(TimeStart));
+
+            DispatchSPCA->SpcaSetCalcDevice(device);
+            TimeStart = DispatchClock::now();
+            StatusFlag = StatusFlag && DispatchSPCA->SpcaInitCalcSystem(SpcaMatrixCalc::CL_KERNEL_STRING, ScriptDispatch, "DispatchTiny");
+            TimesInit.push_back(DispatchMicros(TimeStart));
+
+            DispatchSPCA->SpcaPushMatrixAttribute(MatrixSize, MatrixSize, SpcaMatrixCalc::WRITE_ONLY_MATRIX);
+            DispatchSPCA->SpcaPushMatrixAttribute(MatrixSize, MatrixSize, SpcaMatrixCalc::READ_ONLY_MATRIX);
+            TimeStart = DispatchClock::now();
+            StatusFlag = StatusFlag && DispatchSPCA->SpcaCreateMemoryOBJ();
+            TimesMemory.push_back(DispatchMicros(TimeStart));
+
+            // jobs: last setup(warm), first job => warmup.
+            for (size_t j = 0; StatusFlag && i + 1 == config.SetupRepeat && j <= config.JobRepeat; ++j) {
+                TimeStart = DispatchClock::now();
+                StatusFlag =
+                    DispatchSPCA->SpcaPushMatrixData(JobMatrix) &&
+                    DispatchSPCA->SpcaWriteMatrixCalc(MatrixSize, MatrixSize);
+                vector<SpcaIndexMatrix<float>> ResultMatrix = DispatchSPCA->SpcaReadMatrixResult();
+                StatusFlag = StatusFlag && !ResultMatrix.empty();
+                for (auto& Mat : ResultMatrix) Mat.IMatrixFree();
+                if (j > NULL) TimesJob.push_back(DispatchMicros(TimeStart));
+            }
+            delete DispatchSPCA;
+        }
+        JobMatrix.IMatrixFree();
+        if (!StatusFlag) {
+            PushLogger(LogError, ModuleTagBenchmark, "dispatch setup failed, device: %zu", device);
+            return false;
+        }
+        SpcaBenchmarkRecord RecordTemp = {};
+        RecordTemp.BenchmarkName = "dispatch_setup";
+        RecordTemp.DeviceIndex   = device;
+        RecordTemp.RecordParams = {
+            { "repeat", to_string(config.SetupRepeat) }
+        };
+        RecordTemp.RecordStats = {
+            { "enumerate_us",     BenchmarkStatistics(TimesEnumerate) },
+            { "calc_create_us",   BenchmarkStatistics(TimesCalcCreate) },
+            { "context_us",       BenchmarkStatistics(TimesContext) },
+            { "queue_us",         BenchmarkStatistics(TimesQueue) },
+            { "program_build_us", BenchmarkStatistics(TimesBuild) },
+            { "kernel_create_us", BenchmarkStatistics(TimesKernel) },
+            { "init_system_us",   BenchmarkStatistics(TimesInit) },
+            { "memory_obj_us",    BenchmarkStatistics(TimesMemory) }
+        };
+        DispatchReport.AddRecord(RecordTemp);
+
+        if (!TimesJob.empty()) {
+            SpcaBenchmarkRecord JobRecord = {};
+            JobRecord.BenchmarkName = "dispatch_job";
+            JobRecord.DeviceIndex   = device;
+            JobRecord.RecordParams = {
+                { "matrix", to_string(MatrixSize) },
+                { "repeat", to_string(config.JobRepeat) }
+            };
+            JobRecord.RecordStats  = { { "job_us", BenchmarkStatistics(TimesJob) } };
+            JobRecord.RecordValues = { { "jobs_per_sec", 1e6 / JobRecord.RecordStats[0].second.StatsMedian } };
+            DispatchReport.AddRecord(JobRecord);
+        }
+        return true;
+    }
+
+    bool SpcaBenchmarkDispatch::RunDispatchLaunch(size_t device, const SpcaDispatchConfig& config) {
+        CalcDeviceIndexCode = device;
+        cl_device_id DeviceHandle = nullptr;
+        cl_context Context = SpcaCreateContext(&DeviceHandle);
+        if (Context == nullptr) return false;
+
+        size_t ThreadsMax = 1;
+        for (size_t Threads : config.ThreadCounts) ThreadsMax = max(ThreadsMax, Threads);
+        size_t MatrixSize = max(config.MatrixSize, (size_t)1);
+        size_t GlobalSize[2] = { MatrixSize, MatrixSize };
+
+        vector<cl_command_queue> Queues(ThreadsMax, nullptr);
+        bool StatusFlag = true;
+        for (auto& Queue : Queues) {
+            Queue = SpcaCreateCommandQueue(Context, DeviceHandle);
+            StatusFlag &= Queue != nullptr;
+        }
+        cl_int ErrorCode = CL_SUCCESS;
+        cl_mem MatrixIn  = clCreateBuffer(Context, CL_MEM_READ_ONLY,  FLOAT32_LENSIZE(MatrixSize * MatrixSize), nullptr, &ErrorCode);
+        cl_mem MatrixOut = clCreateBuffer(Context, CL_MEM_WRITE_ONLY, FLOAT32_LENSIZE(MatrixSize * MatrixSize), nullptr, &ErrorCode);
+        cl_program Program = SpcaCreateProgram(Context, DeviceHandle, false, ScriptDispatch);
+
+        const char* KernelNames[] = { "DispatchEmpty", "DispatchTiny" };
+        cl_kernel Kernels[2] = {};
+        for (size_t i = 0; i < 2; ++i) {
+            if (Program != nullptr)
+                Kernels[i] = clCreateKernel(Program, KernelNames[i], &ErrorCode);
+            // args once(shared kernel), enqueue only => threads.
+            StatusFlag = StatusFlag && MatrixIn != nullptr && MatrixOut != nullptr && Kernels[i] != nullptr &&
+                clSetKernelArg(Kernels[i], 0, sizeof(cl_mem), &MatrixIn)  == CL_SUCCESS &&
+                clSetKernelArg(Kernels[i], 1, sizeof(cl_mem), &MatrixOut) == CL_SUCCESS;
+        }
+        for (size_t k = 0; StatusFlag && k < 2; ++k) {
+            for (size_t Threads : config.ThreadCounts) {
+                if (Threads == NULL || config.LaunchRepeat == NULL) continue;
+
+                vector<DispatchSamples> ThreadSamples(Threads);
+                vector<char> ThreadStatus(Threads, 1);
+                atomic<bool>   StartFlag(false);
+                atomic<size_t> DoneCount(NULL);
+                vector<thread> LaunchThreads = {};
+                for (size_t t = 0; t < Threads; ++t) {
+                    LaunchThreads.emplace_back([&, t]() {
+                        while (!StartFlag.load(memory_order_acquire))
+                            this_thread::yield();
+                        ThreadStatus[t] = DispatchLaunches(
+                            Queues[t], Kernels[k], GlobalSize, config.LaunchWarmup, config.LaunchRepeat, ThreadSamples[t]
+                        );
+                        DoneCount.fetch_add(1, memory_order_acq_rel);
+                    });
+                }
+                DispatchClock::time_point TimeStart = DispatchClock::now();
+                StartFlag.store(true, memory_order_release);
+                while (DoneCount.load(memory_order_acquire) < Threads)
+                    this_thread::yield();
+                double TimeWallUs = DispatchMicros(TimeStart);
+                for (auto& LaunchThread : LaunchThreads) LaunchThread.join();
+
+                if (find(ThreadStatus.begin(), ThreadStatus.end(), 0) != ThreadStatus.end()) {
+                    StatusFlag = false;
+                    break;
+                }
+                DispatchSamples Samples = {};
+                for (const auto& Thread : ThreadSamples) Samples.Merge(Thread);
+
+                SpcaBenchmarkRecord RecordTemp = {};
+                RecordTemp.BenchmarkName = "dispatch_launch";
+                RecordTemp.DeviceIndex   = device;
+                RecordTemp.RecordParams = {
+                    { "kernel",  KernelNames[k] },
+                    { "threads", to_string(Threads) },
+                    { "matrix",  to_string(MatrixSize) },
+                    { "repeat",  to_string(config.LaunchRepeat) }
+                };
+                RecordTemp.RecordStats = {
+                    { "enqueue_us",   BenchmarkStatistics(Samples.SamplesEnqueue) },
+                    { "wait_us",      BenchmarkStatistics(Samples.SamplesWait) },
+                    { "profiling_us", BenchmarkStatistics(Samples.SamplesProfiling) },
+                    { "submit_us",    BenchmarkStatistics(Samples.SamplesSubmit) },
+                    { "exec_us",      BenchmarkStatistics(Samples.SamplesExec) },
+                    { "total_us",     BenchmarkStatistics(Samples.SamplesTotal) }
+                };
+                // warmup included(wall), all threads.
+                RecordTemp.RecordValues = {
+                    { "launches_per_sec", double(Threads * (config.LaunchWarmup + config.LaunchRepeat)) / (TimeWallUs * 1e-6) }
+                };
+                DispatchReport.AddRecord(RecordTemp);
+            }
+        }
+        for (cl_kernel Kernel : Kernels)
+            if (Kernel != nullptr) clReleaseKernel(Kernel);
+        if (Program   != nullptr) clReleaseProgram(Program);
+        if (MatrixIn  != nullptr) clReleaseMemObject(MatrixIn);
+        if (MatrixOut != nullptr) clReleaseMemObject(MatrixOut);
+        for (cl_command_queue Queue : Queues)
+            if (Queue != nullptr) clReleaseCommandQueue(Queue);
+        clReleaseContext(Context);
+
+        if (!StatusFlag)
+            PushLogger(LogError, ModuleTagBenchmark, "dispatch launch failed, device: %zu", device);
+        return StatusFlag;
+    }
+
+    size_t SpcaBenchmarkDispatch::RunDispatchBenchmark(const SpcaDispatchConfig& config) {
+        vector<size_t> Devices = config.Devices;
+        if (Devices.empty())
+            for (size_t i = 0; i < PlatformDevicesArray.size(); ++i) Devices.push_back(i);
+
+        size_t RecordCount = DispatchReport.GetRecords().size();
+        for (size_t Device : Devices) {
+            if (Device >= PlatformDevicesArray.size()) {
+                PushLogger(LogWarning, ModuleTagBenchmark, "dispatch invalid device: %zu", Device);
+                continue;
+            }
+            DispatchReport.AddDevice(BenchmarkDeviceInfo(PlatformDevicesArray[Device], Device));
+            RunDispatchSetup(Device, config);
+            RunDispatchLaunch(Device, config);
+        }
+        RecordCount = DispatchReport.GetRecords().size() - RecordCount;
+        PushLogger(LogInfo, ModuleTagBenchmark, "dispatch complete, devices: %zu, records: %zu", Devices.size(), RecordCount);
+        return RecordCount;
+    }
+}
@@ -0,0 +1,42 @@
+// spca_benchmark_dispatch, (fixed per job cost: setup, enqueue, wait, profiling), v0.1, RCSZ 2026.10.19
+// setup phases => launch latency(empty | tiny kernel, n threads) => small job end-to-end, host wall(us).
+
+#ifndef _SPCA_BENCHMARK_DISPATCH_H
+#define _SPCA_BENCHMARK_DISPATCH_H
+#include "spca_benchmark_suite.h"
+
+namespace SpcaBenchmark {
+	struct SpcaDispatchConfig {
+		// setup phases(cold => warm): enumerate, context, build, ...
+		size_t SetupRepeat = 5;
+		// launches per thread.
+		size_t LaunchWarmup = 10;
+		size_t LaunchRepeat = 1000;
+		// concurrent enqueue threads(one queue per thread, shared kernel).
+		std::vector<size_t> ThreadCounts = { 1, 2, 4, 8 };
+		// SpcaMatrix2Calc push => write calc => read.
+		size_t JobRepeat = 100;
+		// tiny kernel & job matrix(n x n).
+		size_t MatrixSize = 16;
+		// device index, empty: all devices.
+		std::vector<size_t> Devices = {};
+	};
+
+	class SpcaBenchmarkDispatch :protected SPCA_CORE_OPENCL {
+	protected:
+		SpcaBenchmarkReport DispatchReport = {};
+
+		// record "dispatch_setup", "dispatch_job".
+		bool RunDispatchSetup(size_t device, const SpcaDispatchConfig& config);
+		// record "dispatch_launch"(kernel, threads).
+		bool RunDispatchLaunch(size_t device, const SpcaDispatchConfig& config);
+	public:
+		// setup stats: enumerate, calc_create, context, queue, program_build, kernel_create,
+		// init_system, memory_obj(us). launch stats: enqueue, wait, profiling, submit(queued => start),
+		// exec(start => end), total(us). return: recorded configs.
+		size_t RunDispatchBenchmark(const SpcaDispatchConfig& config);
+		SpcaBenchmarkReport& GetDispatchReport() { return DispatchReport; }
+	};
+}
+
+#endif
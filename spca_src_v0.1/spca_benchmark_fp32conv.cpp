@@ -1,6 +1,8 @@
 // spca_benchmark_fp32conv.
 #include "spca_benchmark_fp32conv.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace PSAG_LOGGER;
 
@@ -65,7 +67,83 @@ __kernel void BenchmarkMatrixCopy(
 }
 )";
 
+// suite conv: "CALC_T" => prefix(dtype), 32 mad per tap(dependent chain).
+constexpr const char* ScriptBenchmarkSuiteConv = R"(
+__kernel void BenchmarkSuiteConv(
+    __global const float* MatrixIn, __global const float* ConvKernel,
+    __global const float* ConvParam, __global float* MatrixOut
+) {
+    int width  = get_global_size(0);
+    int height = get_global_size(1);
+
+    int i = get_global_id(0);
+    int j = get_global_id(1);
+
+    int RangeSize   = (int)ConvParam[0];
+    int RangeCenter = RangeSize / 2;
+
+    CALC_T ResultValue = (CALC_T)0;
+    for (int ky = 0; ky < RangeSize; ++ky) {
+        for (int kx = 0; kx < RangeSize; ++kx) {
+            // clamp edge => same oper per item.
+            int InputX = clamp(i + kx - RangeCenter, 0, width  - 1);
+            int InputY = clamp(j + ky - RangeCenter, 0, height - 1);
+
+            CALC_T Temp = (CALC_T)MatrixIn[InputY * width + InputX] * (CALC_T)ConvKernel[ky * RangeSize + kx];
+            // blend 32-cycles, bounded: result => temp / (1 - 0.96875).
+            for (int idx = 0; idx < 32; ++idx)
+                ResultValue = mad(ResultValue, (CALC_T)0.96875, Temp);
+        }
+    }
+    MatrixOut[j * width + i] = (float)ResultValue;
+}
+)";
+// "BenchmarkSuiteConv" oper = n * n * k * k * const(1 mul + 32 mad).
+constexpr size_t BenchmarkSuiteTapOper = 65;
+
 namespace SpcaBenchmarkFP32 {
+    const char* BenchmarkTypeName(BenchmarkDTYPE type) {
+        switch (type) {
+        case(BENCHMARK_FP16): return "fp16";
+        case(BENCHMARK_FP64): return "fp64";
+        default:              return "fp32";
+        }
+    }
+
+    static string BenchmarkTypeScript(BenchmarkDTYPE type) {
+        switch (type) {
+        case(BENCHMARK_FP16): return "#pragma OPENCL EXTENSION cl_khr_fp16 : enable\n#define CALC_T half\n";
+        case(BENCHMARK_FP64): return "#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n#define CALC_T double\n";
+        default:              return "#define CALC_T float\n";
+        }
+    }
+
+    SpcaBenchmarkConfig BenchmarkLevelConfig(BenchmarkLEVEL level) {
+        SpcaBenchmarkConfig ConfigTemp = {};
+        switch (level) {
+        case(BENCHMARK_STANDARD): {
+            ConfigTemp.MatrixSizes = { 512, 1024, 2048 };
+            ConfigTemp.KernelSizes = { 3, 5, 9 };
+            ConfigTemp.LocalSizes  = { 0, 8, 16 };
+            ConfigTemp.DataTypes   = { BENCHMARK_FP32, BENCHMARK_FP16 };
+            ConfigTemp.WarmupCount = 2;
+            ConfigTemp.RepeatCount = 10;
+            break;
+        }
+        case(BENCHMARK_FULL): {
+            ConfigTemp.MatrixSizes = { 256, 512, 1024, 2048, 4096 };
+            ConfigTemp.KernelSizes = { 3, 5, 9, 15 };
+            ConfigTemp.LocalSizes  = { 0, 4, 8, 16, 32 };
+            ConfigTemp.DataTypes   = { BENCHMARK_FP32, BENCHMARK_FP16, BENCHMARK_FP64 };
+            ConfigTemp.WarmupCount = 3;
+            ConfigTemp.RepeatCount = 30;
+            break;
+        }
+        // quick: defaults(one config).
+        default: break;
+        }
+        return ConfigTemp;
+    }
 
     SpcaBenchmarkConvFP32::SpcaBenchmarkConvFP32() {
         BenchmarkSPCA = new SpcaMatrixCalc::SpcaMatrix2Calc();
@@ -94,6 +172,8 @@ namespace SpcaBenchmarkFP32 {
 
         // create calc object.
         BenchmarkSPCA = new SpcaMatrixCalc::SpcaMatrix2Calc();
+        // device => before init(context).
+        BenchmarkSPCA->SpcaSetCalcDevice(0);
         BenchmarkSPCA->SpcaInitCalcSystem(
             SpcaMatrixCalc::CL_KERNEL_STRING,
             ScriptBenchmarkConvFP32, "BenchmarkMatrixCalculate"
@@ -104,7 +184,6 @@ namespace SpcaBenchmarkFP32 {
         size_t WorkgroupDim   = size_t(sqrt(WorkgroupTotal));
 
         BenchmarkSPCA->SpcaAllocWorkgroup(WorkgroupDim, WorkgroupDim);
-        BenchmarkSPCA->SpcaSetCalcDevice(0);
 
         BenchmarkSPCA->SpcaPushMatrixAttribute(DataMatrixSize[0], DataMatrixSize[1], SpcaMatrixCalc::WRITE_ONLY_MATRIX);
         BenchmarkSPCA->SpcaPushMatrixAttribute(ConvMatrixSize[0], ConvMatrixSize[1], SpcaMatrixCalc::WRITE_ONLY_MATRIX);
@@ -149,6 +228,8 @@ namespace SpcaBenchmarkFP32 {
 
         // create calc object.
         BenchmarkSPCA = new SpcaMatrixCalc::SpcaMatrix2Calc();
+        // device => before init(context).
+        BenchmarkSPCA->SpcaSetCalcDevice(0);
         BenchmarkSPCA->SpcaInitCalcSystem(
             SpcaMatrixCalc::CL_KERNEL_STRING,
             ScriptBenchmarkBandwidth, "BenchmarkMatrixCopy"
@@ -159,7 +240,6 @@ namespace SpcaBenchmarkFP32 {
         size_t WorkgroupDim = size_t(sqrt(WorkgroupTotal));
 
         BenchmarkSPCA->SpcaAllocWorkgroup(WorkgroupDim, WorkgroupDim);
-        BenchmarkSPCA->SpcaSetCalcDevice(0);
 
         BenchmarkSPCA->SpcaPushMatrixAttribute(BigMatrixSize[0], BigMatrixSize[1], SpcaMatrixCalc::WRITE_ONLY_MATRIX);
         BenchmarkSPCA->SpcaPushMatrixAttribute(BigMatrixSize[0], BigMatrixSize[1], SpcaMatrixCalc::READ_ONLY_MATRIX);
@@ -183,6 +263,167 @@ namespace SpcaBenchmarkFP32 {
         delete BenchmarkSPCA;
     }
 
+    bool SpcaBenchmarkConvFP32::RunSuiteConfig(
+        size_t device, BenchmarkDTYPE type, size_t matrix_size, size_t kernel_size, size_t local_size,
+        const SpcaBenchmarkConfig& config
+    ) {
+        SpcaMatrixCalc::SpcaMatrix2Calc* SuiteSPCA = new SpcaMatrixCalc::SpcaMatrix2Calc();
+        vector<SpcaCalcDevice>* Devices = SuiteSPCA->SpcaGetDevicesIndex();
+        if (Devices == nullptr || device >= Devices->size()) {
+            PushLogger(LogWarning, ModuleTagBenchmark, "suite invalid device: %zu", device);
+            delete SuiteSPCA;
+            return false;
+        }
+        SpcaBenchmark::SpcaBenchmarkDevice DeviceInfo = SpcaBenchmark::BenchmarkDeviceInfo((*Devices)[device], device);
+        SuiteReport.AddDevice(DeviceInfo);
+
+        if ((type == BENCHMARK_FP16 && !DeviceInfo.SupportFP16) || (type == BENCHMARK_FP64 && !DeviceInfo.SupportFP64)) {
+            PushLogger(LogInfo, ModuleTagBenchmark, "suite skip device %zu: %s unsupported.", device, BenchmarkTypeName(type));
+            delete SuiteSPCA;
+            return false;
+        }
+        // 0 => largest pow2 <= sqrt(max), divides matrix size. 1 x 1: workgroup rejected => skip.
+        size_t LocalDim = local_size;
+        if (LocalDim == NULL) {
+            LocalDim = 1;
+            while ((LocalDim * 2) * (LocalDim * 2) <= DeviceInfo.WorkgroupMax && matrix_size % (LocalDim * 2) == NULL)
+                LocalDim *= 2;
+        }
+        if (matrix_size == NULL || kernel_size == NULL || LocalDim < 2 ||
+            matrix_size % LocalDim != NULL || LocalDim * LocalDim > DeviceInfo.WorkgroupMax
+        ) {
+            PushLogger(LogInfo, ModuleTagBenchmark, "suite skip local %zu: matrix %zu, workgroup max %zu.",
+                LocalDim, matrix_size, DeviceInfo.WorkgroupMax);
+            delete SuiteSPCA;
+            return false;
+        }
+
+        // device => before init(context).
+        SuiteSPCA->SpcaSetCalcDevice(device);
+        if (!SuiteSPCA->SpcaInitCalcSystem(
+            SpcaMatrixCalc::CL_KERNEL_STRING,
+            BenchmarkTypeScript(type) + ScriptBenchmarkSuiteConv, "BenchmarkSuiteConv"
+        )) {
+            PushLogger(LogError, ModuleTagBenchmark, "suite failed init device %zu: %s", device, BenchmarkTypeName(type));
+            delete SuiteSPCA;
+            return false;
+        }
+        SuiteSPCA->SpcaAllocWorkgroup(LocalDim, LocalDim);
+
+        SpcaIndexMatrix<float> SuiteMatrixIn     = SpcaIndexMatrix<float>(SPCA_TYPE_MATRIX2D);
+        SpcaIndexMatrix<float> SuiteMatrixConv   = SpcaIndexMatrix<float>(SPCA_TYPE_MATRIX2D);
+        SpcaIndexMatrix<float> SuiteMatrixParams = SpcaIndexMatrix<float>(SPCA_TYPE_MATRIX2D);
+
+        SuiteMatrixIn.IMatrixAlloc(matrix_size, matrix_size);
+        SuiteMatrixConv.IMatrixAlloc(kernel_size, kernel_size);
+        SuiteMatrixParams.IMatrixAlloc(ConvParamsMatSize[0], ConvParamsMatSize[1]);
+
+        fill(SuiteMatrixIn.GetIMatrixRawData()->begin(),   SuiteMatrixIn.GetIMatrixRawData()->end(),   0.5f);
+        fill(SuiteMatrixConv.GetIMatrixRawData()->begin(), SuiteMatrixConv.GetIMatrixRawData()->end(), 1.0f / float(kernel_size * kernel_size));
+        *SuiteMatrixParams.IMatrixAddressing2D(0, 0) = (float)kernel_size;
+
+        SuiteSPCA->SpcaPushMatrixAttribute(matrix_size, matrix_size, SpcaMatrixCalc::WRITE_ONLY_MATRIX);
+        SuiteSPCA->SpcaPushMatrixAttribute(kernel_size, kernel_size, SpcaMatrixCalc::WRITE_ONLY_MATRIX);
+        SuiteSPCA->SpcaPushMatrixAttribute(ConvParamsMatSize[0], ConvParamsMatSize[1], SpcaMatrixCalc::WRITE_ONLY_MATRIX);
+        SuiteSPCA->SpcaPushMatrixAttribute(matrix_size, matrix_size, SpcaMatrixCalc::READ_ONLY_MATRIX);
+
+        bool StatusFlag = SuiteSPCA->SpcaCreateMemoryOBJ();
+        vector<double> KernelSamples = {}, UploadSamples = {}, DownloadSamples = {};
+
+        for (size_t i = 0; StatusFlag && i < config.WarmupCount + config.RepeatCount; ++i) {
+            vector<SpcaIndexMatrix<float>> Dataset = {}, Result = {};
+            vector<cl_event> WriteEvents = {}, RunEvents(1, nullptr), ReadEvents = {};
+
+            StatusFlag =
+                SuiteSPCA->SpcaPushMatrixData(SuiteMatrixIn)   &&
+                SuiteSPCA->SpcaPushMatrixData(SuiteMatrixConv) &&
+                SuiteSPCA->SpcaPushMatrixData(SuiteMatrixParams) &&
+                SuiteSPCA->SpcaAsyncWriteDataset(Dataset, WriteEvents);
+            if (StatusFlag) StatusFlag = SuiteSPCA->SpcaAsyncMatrixCalc(RunEvents[0], matrix_size, matrix_size);
+            if (StatusFlag) StatusFlag = SuiteSPCA->SpcaAsyncReadResult(Result, ReadEvents);
+
+            // events => release(all paths).
+            vector<double> WriteTimes = {}, RunTimes = {}, ReadTimes = {};
+            if (RunEvents[0] == nullptr) RunEvents.clear();
+            StatusFlag &= SpcaBenchmark::BenchmarkEventsTimes(WriteEvents, WriteTimes);
+            StatusFlag &= SpcaBenchmark::BenchmarkEventsTimes(RunEvents,   RunTimes);
+            StatusFlag &= SpcaBenchmark::BenchmarkEventsTimes(ReadEvents,  ReadTimes);
+
+            for (auto& Mat : Result)  Mat.IMatrixFree();
+            for (auto& Mat : Dataset) Mat.IMatrixFree();
+            if (!StatusFlag || i < config.WarmupCount)
+                continue;
+            KernelSamples.push_back(SpcaBenchmark::BenchmarkTimesSum(RunTimes));
+            UploadSamples.push_back(SpcaBenchmark::BenchmarkTimesSum(WriteTimes));
+            DownloadSamples.push_back(SpcaBenchmark::BenchmarkTimesSum(ReadTimes));
+        }
+        SuiteMatrixIn.IMatrixFree();
+        SuiteMatrixConv.IMatrixFree();
+        SuiteMatrixParams.IMatrixFree();
+        delete SuiteSPCA;
+
+        if (!StatusFlag) {
+            PushLogger(LogError, ModuleTagBenchmark, "suite failed device %zu: %s, matrix %zu, kernel %zu, local %zu.",
+                device, BenchmarkTypeName(type), matrix_size, kernel_size, LocalDim);
+            return false;
+        }
+        SpcaBenchmark::SpcaBenchmarkRecord RecordTemp = {};
+        RecordTemp.BenchmarkName = "conv";
+        RecordTemp.DeviceIndex   = device;
+        RecordTemp.RecordParams = {
+            { "dtype",  BenchmarkTypeName(type) },
+            { "matrix", to_string(matrix_size) },
+            { "kernel", to_string(kernel_size) },
+            { "local",  to_string(LocalDim) },
+            { "repeat", to_string(config.RepeatCount) }
+        };
+        RecordTemp.RecordStats = {
+            { "kernel_ms",   SpcaBenchmark::BenchmarkStatistics(KernelSamples) },
+            { "upload_ms",   SpcaBenchmark::BenchmarkStatistics(UploadSamples) },
+            { "download_ms", SpcaBenchmark::BenchmarkStatistics(DownloadSamples) }
+        };
+        // derived(median): gflops, mib/s.
+        double OperCalc   = double(matrix_size * matrix_size * kernel_size * kernel_size * BenchmarkSuiteTapOper);
+        double UploadMiB  = double(FLOAT32_LENSIZE((matrix_size * matrix_size + kernel_size * kernel_size + 2))) / 1048576.0;
+        double ResultMiB  = double(FLOAT32_LENSIZE((matrix_size * matrix_size))) / 1048576.0;
+        RecordTemp.RecordValues = {
+            { "gflops",        OperCalc  / 1e6 / RecordTemp.RecordStats[0].second.StatsMedian },
+            { "upload_mibs",   UploadMiB / (RecordTemp.RecordStats[1].second.StatsMedian / 1000.0) },
+            { "download_mibs", ResultMiB / (RecordTemp.RecordStats[2].second.StatsMedian / 1000.0) }
+        };
+        SuiteReport.AddRecord(RecordTemp);
+        return true;
+    }
+
+    size_t SpcaBenchmarkConvFP32::RunBenchmarkSuite(const SpcaBenchmarkConfig& config) {
+        vector<size_t> Devices = config.Devices;
+        if (Devices.empty()) {
+            SpcaMatrixCalc::SpcaMatrix2Calc* DevicesSPCA = new SpcaMatrixCalc::SpcaMatrix2Calc();
+            vector<SpcaCalcDevice>* DevicesArray = DevicesSPCA->SpcaGetDevicesIndex();
+            for (size_t i = 0; DevicesArray != nullptr && i < DevicesArray->size(); ++i)
+                Devices.push_back(i);
+            delete DevicesSPCA;
+        }
+        if (config.RepeatCount == NULL) {
+            PushLogger(LogWarning, ModuleTagBenchmark, "suite repeat count = 0.");
+            return NULL;
+        }
+        size_t RecordCount = NULL;
+        for (size_t Device : Devices)
+            for (BenchmarkDTYPE Type : config.DataTypes)
+                for (size_t MatrixSize : config.MatrixSizes)
+                    for (size_t KernelSize : config.KernelSizes)
+                        for (size_t LocalSize : config.LocalSizes)
+                            RecordCount += (size_t)RunSuiteConfig(Device, Type, MatrixSize, KernelSize, LocalSize, config);
+
+        PushLogger(LogInfo, ModuleTagBenchmark, "suite complete, devices: %zu, records: %zu", Devices.size(), RecordCount);
+        return RecordCount;
+    }
+
+    size_t SpcaBenchmarkConvFP32::RunBenchmarkSuite(BenchmarkLEVEL level) {
+        return RunBenchmarkSuite(BenchmarkLevelConfig(level));
+    }
+
     constexpr const char* L = "[BINFO]: ";
     void SpcaBenchmarkConvFP32::PrintResult(const SpcaBenchmarkResult& msg) {
         ostringstream StringTemp = {};
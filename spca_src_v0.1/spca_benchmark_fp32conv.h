@@ -2,11 +2,39 @@
 #ifndef _SPCA_BENCHMARK_FP32CONV_H
 #define _SPCA_BENCHMARK_FP32CONV_H
 #include"spca_opencl.h"
+#include"spca_benchmark_suite.h"
 
 namespace SpcaBenchmarkFP32 {
+	// suite presets: sweep size & repeats.
 	enum BenchmarkLEVEL {
-		
+		BENCHMARK_QUICK    = 1 << 1,
+		BENCHMARK_STANDARD = 1 << 2,
+		BENCHMARK_FULL     = 1 << 3
 	};
+	// kernel calc type, storage(mem_objects): fp32.
+	enum BenchmarkDTYPE {
+		BENCHMARK_FP32 = 1 << 1,
+		BENCHMARK_FP16 = 1 << 2,
+		BENCHMARK_FP64 = 1 << 3
+	};
+	const char* BenchmarkTypeName(BenchmarkDTYPE type);
+
+	// sweep: devices x dtypes x matrix sizes x kernel sizes x local sizes.
+	struct SpcaBenchmarkConfig {
+		// square matrix(n x n) => global size.
+		std::vector<size_t> MatrixSizes = { 512 };
+		// conv kernel(k x k).
+		std::vector<size_t> KernelSizes = { 3 };
+		// square workgroup, 0: device max(sqrt, divides matrix size).
+		std::vector<size_t> LocalSizes = { 0 };
+		std::vector<BenchmarkDTYPE> DataTypes = { BENCHMARK_FP32 };
+		// device index, empty: all devices.
+		std::vector<size_t> Devices = {};
+
+		size_t WarmupCount = 1;
+		size_t RepeatCount = 5;
+	};
+	SpcaBenchmarkConfig BenchmarkLevelConfig(BenchmarkLEVEL level);
 
 	struct SpcaBenchmarkResult {
 		// conv benchmark test, v20250203.
@@ -34,12 +62,26 @@ namespace SpcaBenchmarkFP32 {
 
 		SpcaMatrixCalc::SpcaMatrix2Calc* BenchmarkSPCA = nullptr;
 		SpcaBenchmarkResult ResultMessage = {};
+		SpcaBenchmark::SpcaBenchmarkReport SuiteReport = {};
+
+		// one sweep point => record(report), false: skipped | failed.
+		bool RunSuiteConfig(
+			size_t device, BenchmarkDTYPE type, size_t matrix_size, size_t kernel_size, size_t local_size,
+			const SpcaBenchmarkConfig& config
+		);
 	public:
 		SpcaBenchmarkConvFP32();
 
 		void RunBenchmarkTestConvFP32();
 		void RunBenchmarkTestBandwidth();
 
+		// warmup + repeats per config, stats: kernel, upload, download(ms).
+		// return: recorded configs.
+		size_t RunBenchmarkSuite(const SpcaBenchmarkConfig& config);
+		size_t RunBenchmarkSuite(BenchmarkLEVEL level);
+		// write json / csv | print.
+		SpcaBenchmark::SpcaBenchmarkReport& GetSuiteReport() { return SuiteReport; }
+
 		SpcaBenchmarkResult GetResult() const { return ResultMessage; }
 		void PrintResult(const SpcaBenchmarkResult& msg);
 	};
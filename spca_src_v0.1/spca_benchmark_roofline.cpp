@@ -0,0 +1,346 @@
+// spca_benchmark_roofline.
+#include "spca_benchmark_roofline.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace PSAG_LOGGER;
+
+// "CALC_T" & sizes => prefix(build), storage: fp32.
+constexpr const char* ScriptRoofline = R"(
+__kernel void RooflinePeakFMA(__global float* Output, float Seed) {
+    // distinct lanes => non-scalarized chains.
+    CALC_T4 AccA = (CALC_T4)((CALC_T)Seed) + (CALC_T4)((CALC_T)0, (CALC_T)0.25, (CALC_T)0.5, (CALC_T)0.75);
+    CALC_T4 AccB = AccA + (CALC_T)1;
+    CALC_T4 AccC = AccA + (CALC_T)2;
+    CALC_T4 AccD = AccA + (CALC_T)3;
+
+    const CALC_T4 Scale = (CALC_T4)((CALC_T)0.96875);
+    const CALC_T4 Bias  = (CALC_T4)((CALC_T)0.03125);
+    // 4 independent chains => latency hidden.
+    for (int i = 0; i < ROOFLINE_FMA_LOOP; ++i) {
+        AccA = mad(AccA, Scale, Bias);
+        AccB = mad(AccB, Scale, Bias);
+        AccC = mad(AccC, Scale, Bias);
+        AccD = mad(AccD, Scale, Bias);
+    }
+    // all lanes(all chains) => output, non-eliminated.
+    CALC_T4 AccSum = AccA + AccB + AccC + AccD;
+    Output[get_global_id(0)] = (float)(AccSum.x + AccSum.y + AccSum.z + AccSum.w);
+}
+
+__kernel void RooflineGlobalCopy(__global const float4* Input, __global float4* Output) {
+    size_t i = get_global_id(0);
+    Output[i] = Input[i];
+}
+
+__kernel void RooflineLocalRead(__global float* Output) {
+    __local float4 Tile[ROOFLINE_LOCAL];
+    int Index = (int)get_local_id(0);
+
+    Tile[Index] = (float4)((float)Index);
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    float4 Acc = (float4)(0.0f);
+    for (int i = 0; i < ROOFLINE_LOCAL_LOOP; ++i)
+        Acc += Tile[(Index + i) & (ROOFLINE_LOCAL - 1)];
+    Output[get_global_id(0)] = Acc.x + Acc.y + Acc.z + Acc.w;
+}
+)";
+
+namespace SpcaBenchmark {
+    SpcaRooflinePoint RooflinePlace(const SpcaRooflinePeaks& peaks, const SpcaRooflineKernel& kernel) {
+        SpcaRooflinePoint PointTemp = {};
+        PointTemp.KernelName = kernel.KernelName;
+        if (kernel.KernelBytes <= 0.0 || kernel.KernelTimeMs <= 0.0)
+            return PointTemp;
+
+        PointTemp.ArithmeticIntensity = kernel.KernelFLOPs / kernel.KernelBytes;
+        PointTemp.AchievedGFLOPS      = kernel.KernelFLOPs / (kernel.KernelTimeMs * 1e6);
+        PointTemp.AchievedBandwidth   = kernel.KernelBytes / (kernel.KernelTimeMs * 1e6);
+
+        // fp16 unsupported => fp32 roof.
+        double ComputeRoof = kernel.KernelHalf && peaks.PeakFP16 > 0.0 ? peaks.PeakFP16 : peaks.PeakFP32;
+        double MemoryRoof  = PointTemp.ArithmeticIntensity * peaks.BandwidthGlobal;
+
+        PointTemp.MemoryBound      = MemoryRoof < ComputeRoof;
+        PointTemp.AttainableGFLOPS = min(ComputeRoof, MemoryRoof);
+        PointTemp.PeakFraction     = PointTemp.AttainableGFLOPS > 0.0 ? PointTemp.AchievedGFLOPS / PointTemp.AttainableGFLOPS : 0.0;
+        return PointTemp;
+    }
+
+    double RooflineCountFLOPs(double item_ops, size_t global_x, size_t global_y, size_t global_z) {
+        return item_ops * double(global_x) * double(max(global_y, (size_t)1)) * double(max(global_z, (size_t)1));
+    }
+
+    SpcaRooflineKernel RooflineKernelCalc(const string& name, SpcaMatrixCalc::SpcaMatrix2Calc& calc, double flops) {
+        SpcaRooflineKernel KernelTemp = {};
+        KernelTemp.KernelName   = name;
+        KernelTemp.KernelFLOPs  = flops;
+        KernelTemp.KernelBytes  = (double)calc.SpcaGetMemoryBytes();
+        KernelTemp.KernelTimeMs = calc.SystemRunTotalTime;
+        return KernelTemp;
+    }
+
+    // warmup(1) + repeats => min ms, failed: 0.
+    static double RooflineKernelTime(
+        cl_command_queue queue, cl_kernel kernel, size_t global, const size_t* local, size_t repeat
+    ) {
+        vector<double> KernelTimes = {};
+        for (size_t i = 0; i <= repeat; ++i) {
+            vector<cl_event> Events(1, nullptr);
+            cl_int ErrorCode = SpcaCLEnqueueNDRangeKernel(queue, kernel, 1, nullptr, &global, local, NULL, nullptr, &Events[0]);
+            if (ErrorCode != CL_SUCCESS) {
+                PushLogger(LogError, ModuleTagBenchmark, "roofline enqueue kernel, code: %i", ErrorCode);
+                return 0.0;
+            }
+            vector<double> RunTimes = {};
+            if (!BenchmarkEventsTimes(Events, RunTimes) || RunTimes.empty())
+                return 0.0;
+            if (i > NULL) KernelTimes.push_back(RunTimes[0]);
+        }
+        return KernelTimes.empty() ? 0.0 : BenchmarkStatistics(KernelTimes).StatsMin;
+    }
+
+    cl_program SpcaBenchmarkRoofline::RooflineProgram(cl_context context, cl_device_id device, bool half, size_t local) {
+        ostringstream ScriptTemp = {};
+        if (half)
+            ScriptTemp << "#pragma OPENCL EXTENSION cl_khr_fp16 : enable\n#define CALC_T half\n#define CALC_T4 half4\n";
+        else
+            ScriptTemp << "#define CALC_T float\n#define CALC_T4 float4\n";
+        ScriptTemp << "#define ROOFLINE_FMA_LOOP "   << ROOFLINE_FMA_LOOP   << "\n";
+        ScriptTemp << "#define ROOFLINE_LOCAL_LOOP " << ROOFLINE_LOCAL_LOOP << "\n";
+        ScriptTemp << "#define ROOFLINE_LOCAL "      << local               << "\n";
+        ScriptTemp << ScriptRoofline;
+        return SpcaCreateProgram(context, device, false, ScriptTemp.str());
+    }
+
+    double SpcaBenchmarkRoofline::MeasurePeakFMA(cl_context context, cl_command_queue queue, cl_program program, size_t repeat) {
+        cl_int ErrorCode = CL_SUCCESS;
+        cl_kernel Kernel = clCreateKernel(program, "RooflinePeakFMA", &ErrorCode);
+        cl_mem Output = clCreateBuffer(context, CL_MEM_WRITE_ONLY, FLOAT32_LENSIZE(ROOFLINE_FMA_ITEMS), nullptr, &ErrorCode);
+
+        double KernelTime = 0.0;
+        float Seed = 0.5f;
+        if (Kernel != nullptr && Output != nullptr &&
+            clSetKernelArg(Kernel, 0, sizeof(cl_mem), &Output) == CL_SUCCESS &&
+            clSetKernelArg(Kernel, 1, sizeof(float),  &Seed)   == CL_SUCCESS
+        )
+            KernelTime = RooflineKernelTime(queue, Kernel, ROOFLINE_FMA_ITEMS, nullptr, repeat);
+
+        if (Output != nullptr) clReleaseMemObject(Output);
+        if (Kernel != nullptr) clReleaseKernel(Kernel);
+        return KernelTime;
+    }
+
+    double SpcaBenchmarkRoofline::MeasureGlobalCopy(
+        cl_context context, cl_command_queue queue, cl_program program, size_t bytes, size_t repeat
+    ) {
+        cl_int ErrorCode = CL_SUCCESS;
+        cl_kernel Kernel = clCreateKernel(program, "RooflineGlobalCopy", &ErrorCode);
+        cl_mem Input  = clCreateBuffer(context, CL_MEM_READ_ONLY,  bytes, nullptr, &ErrorCode);
+        cl_mem Output = clCreateBuffer(context, CL_MEM_WRITE_ONLY, bytes, nullptr, &ErrorCode);
+
+        double KernelTime = 0.0;
+        if (Kernel != nullptr && Input != nullptr && Output != nullptr &&
+            clSetKernelArg(Kernel, 0, sizeof(cl_mem), &Input)  == CL_SUCCESS &&
+            clSetKernelArg(Kernel, 1, sizeof(cl_mem), &Output) == CL_SUCCESS
+        )
+            // float4 per item.
+            KernelTime = RooflineKernelTime(queue, Kernel, bytes / 16, nullptr, repeat);
+
+        if (Input  != nullptr) clReleaseMemObject(Input);
+        if (Output != nullptr) clReleaseMemObject(Output);
+        if (Kernel != nullptr) clReleaseKernel(Kernel);
+        return KernelTime;
+    }
+
+    double SpcaBenchmarkRoofline::MeasureLocalRead(
+        cl_context context, cl_command_queue queue, cl_program program, size_t local, size_t repeat
+    ) {
+        cl_int ErrorCode = CL_SUCCESS;
+        cl_kernel Kernel = clCreateKernel(program, "RooflineLocalRead", &ErrorCode);
+        cl_mem Output = clCreateBuffer(context, CL_MEM_WRITE_ONLY, FLOAT32_LENSIZE(ROOFLINE_FMA_ITEMS), nullptr, &ErrorCode);
+
+        double KernelTime = 0.0;
+        if (Kernel != nullptr && Output != nullptr &&
+            clSetKernelArg(Kernel, 0, sizeof(cl_mem), &Output) == CL_SUCCESS
+        )
+            // items: pow2, local: pow2 <= 256.
+            KernelTime = RooflineKernelTime(queue, Kernel, ROOFLINE_FMA_ITEMS, &local, repeat);
+
+        if (Output != nullptr) clReleaseMemObject(Output);
+        if (Kernel != nullptr) clReleaseKernel(Kernel);
+        return KernelTime;
+    }
+
+    bool SpcaBenchmarkRoofline::MeasureHostTransfer(
+        cl_context context, cl_command_queue queue, size_t bytes, size_t repeat,
+        double& write_ms, double& read_ms
+    ) {
+        cl_int ErrorCode = CL_SUCCESS;
+        cl_mem Buffer = clCreateBuffer(context, CL_MEM_READ_WRITE, bytes, nullptr, &ErrorCode);
+        if (Buffer == nullptr) {
+            PushLogger(LogError, ModuleTagBenchmark, "roofline create buffer, code: %i", ErrorCode);
+            return false;
+        }
+        vector<uint8_t> HostData(bytes, 0x5A);
+        vector<double> WriteTimes = {}, ReadTimes = {};
+
+        bool StatusFlag = true;
+        for (size_t i = 0; StatusFlag && i <= repeat; ++i) {
+            vector<cl_event> WriteEvents(1, nullptr), ReadEvents(1, nullptr);
+            vector<double> RunTimes = {};
+
+            StatusFlag = clEnqueueWriteBuffer(queue, Buffer, CL_FALSE, 0, bytes, HostData.data(), NULL, nullptr, &WriteEvents[0]) == CL_SUCCESS;
+            StatusFlag = StatusFlag && BenchmarkEventsTimes(WriteEvents, RunTimes);
+            if (StatusFlag && i > NULL) WriteTimes.push_back(RunTimes.back());
+
+            StatusFlag = StatusFlag && clEnqueueReadBuffer(queue, Buffer, CL_FALSE, 0, bytes, HostData.data(), NULL, nullptr, &ReadEvents[0]) == CL_SUCCESS;
+            StatusFlag = StatusFlag && BenchmarkEventsTimes(ReadEvents, RunTimes);
+            if (StatusFlag && i > NULL) ReadTimes.push_back(RunTimes.back());
+        }
+        clReleaseMemObject(Buffer);
+        if (!StatusFlag || WriteTimes.empty()) {
+            PushLogger(LogError, ModuleTagBenchmark, "roofline host transfer failed, bytes: %zu", bytes);
+            return false;
+        }
+        write_ms = BenchmarkStatistics(WriteTimes).StatsMin;
+        read_ms  = BenchmarkStatistics(ReadTimes).StatsMin;
+        return true;
+    }
+
+    bool SpcaBenchmarkRoofline::MeasureDevicePeaks(size_t device, size_t repeat) {
+        if (device >= PlatformDevicesArray.size()) {
+            PushLogger(LogWarning, ModuleTagBenchmark, "roofline invalid device: %zu", device);
+            return false;
+        }
+        SpcaBenchmarkDevice DeviceInfo = BenchmarkDeviceInfo(PlatformDevicesArray[device], device);
+        RooflineReport.AddDevice(DeviceInfo);
+
+        CalcDeviceIndexCode = device;
+        cl_device_id DeviceHandle = nullptr;
+        cl_context Context = SpcaCreateContext(&DeviceHandle);
+        if (Context == nullptr) return false;
+        cl_command_queue Queue = SpcaCreateCommandQueue(Context, DeviceHandle);
+        if (Queue == nullptr) {
+            clReleaseContext(Context);
+            return false;
+        }
+        // local read workgroup: pow2 <= min(256, max), tile fits local memory.
+        size_t LocalSize = 1;
+        while (LocalSize * 2 <= min(DeviceInfo.WorkgroupMax, (size_t)256) && LocalSize * 2 * 16 <= DeviceInfo.LocalMemory)
+            LocalSize *= 2;
+        // buffers: <= global memory / 8, float4 aligned.
+        size_t BufferBytes = min((size_t)ROOFLINE_BUFFER_BYTES, DeviceInfo.GlobalMemory / 8) / 16 * 16;
+
+        SpcaRooflinePeaks PeaksTemp = {};
+        PeaksTemp.DeviceIndex = device;
+
+        cl_program ProgramFP32 = RooflineProgram(Context, DeviceHandle, false, LocalSize);
+        if (ProgramFP32 != nullptr) {
+            double TimeFMA    = MeasurePeakFMA(Context, Queue, ProgramFP32, repeat);
+            double TimeGlobal = BufferBytes > NULL ? MeasureGlobalCopy(Context, Queue, ProgramFP32, BufferBytes, repeat) : 0.0;
+            double TimeLocal  = MeasureLocalRead(Context, Queue, ProgramFP32, LocalSize, repeat);
+
+            if (TimeFMA    > 0.0) PeaksTemp.PeakFP32        = double(ROOFLINE_FMA_ITEMS) * ROOFLINE_FMA_LOOP * 32.0 / (TimeFMA * 1e6);
+            if (TimeGlobal > 0.0) PeaksTemp.BandwidthGlobal = double(BufferBytes) * 2.0 / (TimeGlobal * 1e6);
+            if (TimeLocal  > 0.0) PeaksTemp.BandwidthLocal  = double(ROOFLINE_FMA_ITEMS) * ROOFLINE_LOCAL_LOOP * 16.0 / (TimeLocal * 1e6);
+            clReleaseProgram(ProgramFP32);
+        }
+        if (DeviceInfo.SupportFP16) {
+            cl_program ProgramFP16 = RooflineProgram(Context, DeviceHandle, true, LocalSize);
+            if (ProgramFP16 != nullptr) {
+                double TimeFMA = MeasurePeakFMA(Context, Queue, ProgramFP16, repeat);
+                if (TimeFMA > 0.0) PeaksTemp.PeakFP16 = double(ROOFLINE_FMA_ITEMS) * ROOFLINE_FMA_LOOP * 32.0 / (TimeFMA * 1e6);
+                clReleaseProgram(ProgramFP16);
+            }
+        }
+        double WriteTime = 0.0, ReadTime = 0.0;
+        if (BufferBytes > NULL && MeasureHostTransfer(Context, Queue, BufferBytes, repeat, WriteTime, ReadTime)) {
+            if (WriteTime > 0.0) PeaksTemp.BandwidthHostWrite = double(BufferBytes) / (WriteTime * 1e6);
+            if (ReadTime  > 0.0) PeaksTemp.BandwidthHostRead  = double(BufferBytes) / (ReadTime  * 1e6);
+        }
+        clReleaseCommandQueue(Queue);
+        clReleaseContext(Context);
+
+        if (PeaksTemp.PeakFP32 <= 0.0 || PeaksTemp.BandwidthGlobal <= 0.0) {
+            PushLogger(LogError, ModuleTagBenchmark, "roofline failed peaks, device: %zu", device);
+            return false;
+        }
+        auto It = find_if(RooflinePeaks.begin(), RooflinePeaks.end(),
+            [&](const SpcaRooflinePeaks& Peaks) { return Peaks.DeviceIndex == device; });
+        if (It != RooflinePeaks.end()) *It = PeaksTemp;
+        else RooflinePeaks.push_back(PeaksTemp);
+
+        SpcaBenchmarkRecord RecordTemp = {};
+        RecordTemp.BenchmarkName = "roofline_peak";
+        RecordTemp.DeviceIndex   = device;
+        RecordTemp.RecordParams = {
+            { "repeat", to_string(repeat) },
+            { "buffer_bytes", to_string(BufferBytes) },
+            { "local", to_string(LocalSize) }
+        };
+        RecordTemp.RecordValues = {
+            { "peak_fp32_gflops", PeaksTemp.PeakFP32 },
+            { "peak_fp16_gflops", PeaksTemp.PeakFP16 },
+            { "global_gbs",       PeaksTemp.BandwidthGlobal },
+            { "local_gbs",        PeaksTemp.BandwidthLocal },
+            { "host_write_gbs",   PeaksTemp.BandwidthHostWrite },
+            { "host_read_gbs",    PeaksTemp.BandwidthHostRead },
+            { "ridge_fp32",       PeaksTemp.RidgeFP32() }
+        };
+        RooflineReport.AddRecord(RecordTemp);
+
+        PushLogger(LogPerfmac, ModuleTagBenchmark, "roofline device %zu: fp32 %.1f gflops, fp16 %.1f gflops, global %.1f gb/s, local %.1f gb/s, ridge %.2f flop/b",
+            device, PeaksTemp.PeakFP32, PeaksTemp.PeakFP16, PeaksTemp.BandwidthGlobal, PeaksTemp.BandwidthLocal, PeaksTemp.RidgeFP32());
+        return true;
+    }
+
+    size_t SpcaBenchmarkRoofline::MeasureAllPeaks(size_t repeat) {
+        size_t MeasuredCount = NULL;
+        for (size_t i = 0; i < PlatformDevicesArray.size(); ++i)
+            MeasuredCount += (size_t)MeasureDevicePeaks(i, repeat);
+        return MeasuredCount;
+    }
+
+    const SpcaRooflinePeaks* SpcaBenchmarkRoofline::GetDevicePeaks(size_t device) const {
+        for (const auto& Peaks : RooflinePeaks)
+            if (Peaks.DeviceIndex == device) return &Peaks;
+        return nullptr;
+    }
+
+    bool SpcaBenchmarkRoofline::PlaceKernel(size_t device, const SpcaRooflineKernel& kernel, SpcaRooflinePoint& point) {
+        const SpcaRooflinePeaks* Peaks = GetDevicePeaks(device);
+        if (Peaks == nullptr) {
+            PushLogger(LogWarning, ModuleTagBenchmark, "roofline device %zu not measured.", device);
+            return false;
+        }
+        point = RooflinePlace(*Peaks, kernel);
+
+        SpcaBenchmarkRecord RecordTemp = {};
+        RecordTemp.BenchmarkName = "roofline_kernel";
+        RecordTemp.DeviceIndex   = device;
+        RecordTemp.RecordParams = {
+            { "kernel", kernel.KernelName },
+            { "dtype",  kernel.KernelHalf ? "fp16" : "fp32" },
+            { "bound",  point.MemoryBound ? "memory" : "compute" }
+        };
+        RecordTemp.RecordValues = {
+            { "flops",             kernel.KernelFLOPs },
+            { "bytes",             kernel.KernelBytes },
+            { "time_ms",           kernel.KernelTimeMs },
+            { "intensity",         point.ArithmeticIntensity },
+            { "achieved_gflops",   point.AchievedGFLOPS },
+            { "achieved_gbs",      point.AchievedBandwidth },
+            { "attainable_gflops", point.AttainableGFLOPS },
+            { "peak_fraction",     point.PeakFraction }
+        };
+        RooflineReport.AddRecord(RecordTemp);
+
+        PushLogger(LogPerfmac, ModuleTagBenchmark, "roofline %s: %.3f flop/b, %.2f / %.2f gflops(%.1f%%), %s bound.",
+            kernel.KernelName.c_str(), point.ArithmeticIntensity, point.AchievedGFLOPS, point.AttainableGFLOPS,
+            point.PeakFraction * 100.0, point.MemoryBound ? "memory" : "compute");
+        return true;
+    }
+}
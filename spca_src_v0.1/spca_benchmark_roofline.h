@@ -0,0 +1,97 @@
+// spca_benchmark_roofline, (device peaks, kernel arithmetic intensity), v0.1, RCSZ 2026.10.19
+// peaks: fma(fp32, fp16), global & local memory, host <=> device => kernel(flops, bytes) => roofline point.
+
+#ifndef _SPCA_BENCHMARK_ROOFLINE_H
+#define _SPCA_BENCHMARK_ROOFLINE_H
+#include "spca_benchmark_suite.h"
+
+// peak fma: per item loop(4 x vec4 chains), flops = loop * 32.
+#define ROOFLINE_FMA_LOOP  256
+#define ROOFLINE_FMA_ITEMS (1 << 20)
+// local read: per item loop(vec4), bytes = loop * 16.
+#define ROOFLINE_LOCAL_LOOP 256
+// global copy & host transfer: buffer bytes(max).
+#define ROOFLINE_BUFFER_BYTES (128 << 20)
+
+namespace SpcaBenchmark {
+	// device peaks: gflops, gb/s(1e9 bytes), best(min time) of repeats.
+	struct SpcaRooflinePeaks {
+		size_t DeviceIndex = 0;
+
+		double PeakFP32 = 0.0;
+		// fp16 unsupported: 0.
+		double PeakFP16 = 0.0;
+
+		double BandwidthGlobal    = 0.0; // read + write.
+		double BandwidthLocal     = 0.0; // read.
+		double BandwidthHostWrite = 0.0; // host => device.
+		double BandwidthHostRead  = 0.0; // device => host.
+
+		// ridge point(flop / byte): compute bound >= ridge.
+		double RidgeFP32() const { return BandwidthGlobal > 0.0 ? PeakFP32 / BandwidthGlobal : 0.0; }
+	};
+
+	// user kernel: declared | counted flops & bytes(global memory), time: ms.
+	struct SpcaRooflineKernel {
+		std::string KernelName = {};
+
+		double KernelFLOPs  = 0.0;
+		double KernelBytes  = 0.0;
+		double KernelTimeMs = 0.0;
+		// true: fp16 peak(compute roof).
+		bool KernelHalf = false;
+	};
+
+	struct SpcaRooflinePoint {
+		std::string KernelName = {};
+
+		double ArithmeticIntensity = 0.0; // flop / byte.
+		double AchievedGFLOPS      = 0.0;
+		double AchievedBandwidth   = 0.0; // gb/s.
+		// min(compute roof, intensity * bandwidth).
+		double AttainableGFLOPS = 0.0;
+		// achieved / attainable.
+		double PeakFraction = 0.0;
+		bool   MemoryBound  = false;
+	};
+	SpcaRooflinePoint RooflinePlace(const SpcaRooflinePeaks& peaks, const SpcaRooflineKernel& kernel);
+
+	// counted: per item ops x ndrange.
+	double RooflineCountFLOPs(double item_ops, size_t global_x, size_t global_y = 1, size_t global_z = 1);
+	// counted: calc mem_objects bytes(compulsory traffic), time: last run(profiling).
+	SpcaRooflineKernel RooflineKernelCalc(
+		const std::string& name, SpcaMatrixCalc::SpcaMatrix2Calc& calc, double flops
+	);
+
+	class SpcaBenchmarkRoofline :protected SPCA_CORE_OPENCL {
+	protected:
+		std::vector<SpcaRooflinePeaks> RooflinePeaks = {};
+		SpcaBenchmarkReport RooflineReport = {};
+
+		// script: "CALC_T"(fp32 | fp16), local read workgroup => build.
+		cl_program RooflineProgram(cl_context context, cl_device_id device, bool half, size_t local);
+		// kernel ms(min of repeats), failed: 0.
+		double MeasurePeakFMA(cl_context context, cl_command_queue queue, cl_program program, size_t repeat);
+		double MeasureGlobalCopy(cl_context context, cl_command_queue queue, cl_program program, size_t bytes, size_t repeat);
+		double MeasureLocalRead(cl_context context, cl_command_queue queue, cl_program program, size_t local, size_t repeat);
+		// host => device | device => host(pageable).
+		bool MeasureHostTransfer(
+			cl_context context, cl_command_queue queue, size_t bytes, size_t repeat,
+			double& write_ms, double& read_ms
+		);
+	public:
+		// device peaks => report("roofline_peak"), same device => replace.
+		bool MeasureDevicePeaks(size_t device, size_t repeat = 10);
+		// all devices, return: measured count.
+		size_t MeasureAllPeaks(size_t repeat = 10);
+		// not measured: nullptr.
+		const SpcaRooflinePeaks* GetDevicePeaks(size_t device) const;
+
+		// kernel => point & report("roofline_kernel"), false: device not measured.
+		bool PlaceKernel(size_t device, const SpcaRooflineKernel& kernel, SpcaRooflinePoint& point);
+
+		SpcaBenchmarkReport& GetRooflineReport() { return RooflineReport; }
+	};
+}
+
+#endif
@@ -0,0 +1,281 @@
+// spca_benchmark_suite.
+#include "spca_benchmark_suite.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace PSAG_LOGGER;
+
+#define BENCHMARK_CHAR_LENGTH 256
+
+namespace SpcaBenchmark {
+	SpcaBenchmarkStats BenchmarkStatistics(vector<double> samples) {
+		SpcaBenchmarkStats StatsTemp = {};
+		if (samples.empty()) return StatsTemp;
+		sort(samples.begin(), samples.end());
+
+		size_t Count = samples.size();
+		StatsTemp.SampleCount = Count;
+		StatsTemp.StatsMin = samples.front();
+		StatsTemp.StatsMax = samples.back();
+		StatsTemp.StatsMedian = Count % 2 ? samples[Count / 2] : (samples[Count / 2 - 1] + samples[Count / 2]) * 0.5;
+		// nearest rank: ceil(p * n).
+		size_t RankP95 = (size_t)ceil(0.95 * (double)Count);
+		size_t RankP99 = (size_t)ceil(0.99 * (double)Count);
+		StatsTemp.StatsP95 = samples[max(RankP95, (size_t)1) - 1];
+		StatsTemp.StatsP99 = samples[max(RankP99, (size_t)1) - 1];
+
+		double Sum = 0.0;
+		for (double Sample : samples) Sum += Sample;
+		StatsTemp.StatsMean = Sum / (double)Count;
+		// sample stddev(n - 1).
+		double Variance = 0.0;
+		for (double Sample : samples)
+			Variance += (Sample - StatsTemp.StatsMean) * (Sample - StatsTemp.StatsMean);
+		StatsTemp.StatsStddev = Count > 1 ? sqrt(Variance / double(Count - 1)) : 0.0;
+		return StatsTemp;
+	}
+
+	static string DeviceInfoString(cl_device_id device, cl_device_info param) {
+		char ParamCharTemp[BENCHMARK_CHAR_LENGTH] = {};
+		clGetDeviceInfo(device, param, BENCHMARK_CHAR_LENGTH - 1, ParamCharTemp, nullptr);
+		return string(ParamCharTemp);
+	}
+
+	SpcaBenchmarkDevice BenchmarkDeviceInfo(const SpcaCalcDevice& device, size_t index) {
+		SpcaBenchmarkDevice DeviceTemp = {};
+		DeviceTemp.DeviceIndex = index;
+
+		char ParamCharTemp[BENCHMARK_CHAR_LENGTH] = {};
+		clGetPlatformInfo(device.PlatformHandle, CL_PLATFORM_NAME, BENCHMARK_CHAR_LENGTH - 1, ParamCharTemp, nullptr);
+		DeviceTemp.PlatformName  = ParamCharTemp;
+		DeviceTemp.DeviceName    = DeviceInfoString(device.DeviceHandle, CL_DEVICE_NAME);
+		DeviceTemp.DeviceVendor  = DeviceInfoString(device.DeviceHandle, CL_DEVICE_VENDOR);
+		DeviceTemp.DeviceVersion = DeviceInfoString(device.DeviceHandle, CL_DEVICE_VERSION);
+		DeviceTemp.DriverVersion = DeviceInfoString(device.DeviceHandle, CL_DRIVER_VERSION);
+
+		cl_uint  ParamUint  = NULL;
+		cl_ulong ParamUlong = NULL;
+		size_t   ParamSize  = NULL;
+		if (clGetDeviceInfo(device.DeviceHandle, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(cl_uint), &ParamUint, nullptr) == CL_SUCCESS)
+			DeviceTemp.ComputeUnits = ParamUint;
+		if (clGetDeviceInfo(device.DeviceHandle, CL_DEVICE_MAX_CLOCK_FREQUENCY, sizeof(cl_uint), &ParamUint, nullptr) == CL_SUCCESS)
+			DeviceTemp.ClockFrequency = ParamUint;
+		if (clGetDeviceInfo(device.DeviceHandle, CL_DEVICE_GLOBAL_MEM_SIZE, sizeof(cl_ulong), &ParamUlong, nullptr) == CL_SUCCESS)
+			DeviceTemp.GlobalMemory = (size_t)ParamUlong;
+		if (clGetDeviceInfo(device.DeviceHandle, CL_DEVICE_LOCAL_MEM_SIZE, sizeof(cl_ulong), &ParamUlong, nullptr) == CL_SUCCESS)
+			DeviceTemp.LocalMemory = (size_t)ParamUlong;
+		if (clGetDeviceInfo(device.DeviceHandle, CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(size_t), &ParamSize, nullptr) == CL_SUCCESS)
+			DeviceTemp.WorkgroupMax = ParamSize;
+
+		// extensions: long list => size query.
+		size_t ExtensionsBytes = NULL;
+		if (clGetDeviceInfo(device.DeviceHandle, CL_DEVICE_EXTENSIONS, 0, nullptr, &ExtensionsBytes) == CL_SUCCESS && ExtensionsBytes > NULL) {
+			string Extensions(ExtensionsBytes, '\0');
+			clGetDeviceInfo(device.DeviceHandle, CL_DEVICE_EXTENSIONS, ExtensionsBytes, Extensions.data(), nullptr);
+			DeviceTemp.SupportFP16 = Extensions.find("cl_khr_fp16") != string::npos;
+			DeviceTemp.SupportFP64 = Extensions.find("cl_khr_fp64") != string::npos;
+		}
+		return DeviceTemp;
+	}
+
+	const SpcaBenchmarkDevice* SpcaBenchmarkReport::FindDevice(size_t index) {
+		for (const auto& Device : ReportDevices)
+			if (Device.DeviceIndex == index) return &Device;
+		return nullptr;
+	}
+
+	void SpcaBenchmarkReport::AddDevice(const SpcaBenchmarkDevice& device) {
+		lock_guard<mutex> Lock(ReportMutex);
+		for (auto& Device : ReportDevices) {
+			if (Device.DeviceIndex == device.DeviceIndex) {
+				Device = device;
+				return;
+			}
+		}
+		ReportDevices.push_back(device);
+	}
+
+	void SpcaBenchmarkReport::AddRecord(const SpcaBenchmarkRecord& record) {
+		lock_guard<mutex> Lock(ReportMutex);
+		ReportRecords.push_back(record);
+	}
+
+	vector<SpcaBenchmarkRecord> SpcaBenchmarkReport::GetRecords() {
+		lock_guard<mutex> Lock(ReportMutex);
+		return ReportRecords;
+	}
+
+	void SpcaBenchmarkReport::ClearReport() {
+		lock_guard<mutex> Lock(ReportMutex);
+		ReportDevices.clear();
+		ReportRecords.clear();
+	}
+
+	// json string escape: quote, backslash, control.
+	static string ReportString(const string& str) {
+		string StringTemp = "\"";
+		for (char Char : str) {
+			if (Char == '"' || Char == '\\') {
+				StringTemp.push_back('\\');
+				StringTemp.push_back(Char);
+			}
+			else if ((unsigned char)Char < 0x20)
+				StringTemp.push_back(' ');
+			else
+				StringTemp.push_back(Char);
+		}
+		return StringTemp + "\"";
+	}
+
+	static string ReportNumber(double value) {
+		// json: non-finite => null.
+		if (!isfinite(value)) return "null";
+		char NumberTemp[32] = {};
+		snprintf(NumberTemp, sizeof(NumberTemp), "%.6g", value);
+		return string(NumberTemp);
+	}
+
+	static string ReportStatsJSON(const SpcaBenchmarkStats& stats) {
+		return "{\"samples\":" + to_string(stats.SampleCount) +
+			",\"min\":"    + ReportNumber(stats.StatsMin)    + ",\"median\":" + ReportNumber(stats.StatsMedian) +
+			",\"p95\":"    + ReportNumber(stats.StatsP95)    + ",\"p99\":"    + ReportNumber(stats.StatsP99) +
+			",\"max\":"    + ReportNumber(stats.StatsMax)    + ",\"mean\":"   + ReportNumber(stats.StatsMean) +
+			",\"stddev\":" + ReportNumber(stats.StatsStddev) + "}";
+	}
+
+	bool SpcaBenchmarkReport::WriteReportJSON(const string& filename) {
+		lock_guard<mutex> Lock(ReportMutex);
+		ofstream ReportFile(filename, ios::out | ios::trunc);
+		if (!ReportFile.is_open()) {
+			PushLogger(LogError, ModuleTagBenchmark, "failed open report(json): %s", filename.c_str());
+			return false;
+		}
+		ReportFile << "{\n\"devices\":[";
+		for (size_t i = 0; i < ReportDevices.size(); ++i) {
+			const SpcaBenchmarkDevice& Device = ReportDevices[i];
+			ReportFile << (i ? ",\n" : "\n") << "{\"index\":" << Device.DeviceIndex
+				<< ",\"platform\":"       << ReportString(Device.PlatformName)
+				<< ",\"name\":"           << ReportString(Device.DeviceName)
+				<< ",\"vendor\":"         << ReportString(Device.DeviceVendor)
+				<< ",\"device_version\":" << ReportString(Device.DeviceVersion)
+				<< ",\"driver_version\":" << ReportString(Device.DriverVersion)
+				<< ",\"compute_units\":"  << Device.ComputeUnits
+				<< ",\"clock_mhz\":"      << Device.ClockFrequency
+				<< ",\"global_memory\":"  << Device.GlobalMemory
+				<< ",\"local_memory\":"   << Device.LocalMemory
+				<< ",\"workgroup_max\":"  << Device.WorkgroupMax
+				<< ",\"fp16\":" << (Device.SupportFP16 ? "true" : "false")
+				<< ",\"fp64\":" << (Device.SupportFP64 ? "true" : "false") << "}";
+		}
+		ReportFile << "\n],\n\"records\":[";
+		for (size_t i = 0; i < ReportRecords.size(); ++i) {
+			const SpcaBenchmarkRecord& Record = ReportRecords[i];
+			ReportFile << (i ? ",\n" : "\n") << "{\"benchmark\":" << ReportString(Record.BenchmarkName)
+				<< ",\"device\":" << Record.DeviceIndex << ",\"params\":{";
+			for (size_t j = 0; j < Record.RecordParams.size(); ++j)
+				ReportFile << (j ? "," : "") << ReportString(Record.RecordParams[j].first) << ":" << ReportString(Record.RecordParams[j].second);
+			ReportFile << "},\"stats\":{";
+			for (size_t j = 0; j < Record.RecordStats.size(); ++j)
+				ReportFile << (j ? "," : "") << ReportString(Record.RecordStats[j].first) << ":" << ReportStatsJSON(Record.RecordStats[j].second);
+			ReportFile << "},\"values\":{";
+			for (size_t j = 0; j < Record.RecordValues.size(); ++j)
+				ReportFile << (j ? "," : "") << ReportString(Record.RecordValues[j].first) << ":" << ReportNumber(Record.RecordValues[j].second);
+			ReportFile << "}}";
+		}
+		ReportFile << "\n]\n}\n";
+		PushLogger(LogInfo, ModuleTagBenchmark, "write report(json): %s, records: %zu", filename.c_str(), ReportRecords.size());
+		return ReportFile.good();
+	}
+
+	// csv field: quote(comma, quote).
+	static string ReportField(const string& str) {
+		if (str.find_first_of(",\"\n") == string::npos)
+			return str;
+		string FieldTemp = "\"";
+		for (char Char : str) {
+			if (Char == '"') FieldTemp.push_back('"');
+			FieldTemp.push_back(Char == '\n' ? ' ' : Char);
+		}
+		return FieldTemp + "\"";
+	}
+
+	bool SpcaBenchmarkReport::WriteReportCSV(const string& filename) {
+		lock_guard<mutex> Lock(ReportMutex);
+		ofstream ReportFile(filename, ios::out | ios::trunc);
+		if (!ReportFile.is_open()) {
+			PushLogger(LogError, ModuleTagBenchmark, "failed open report(csv): %s", filename.c_str());
+			return false;
+		}
+		ReportFile << "benchmark,device,device_name,driver_version,params,metric,samples,min,median,p95,p99,max,mean,stddev\n";
+		for (const SpcaBenchmarkRecord& Record : ReportRecords) {
+			const SpcaBenchmarkDevice* Device = FindDevice(Record.DeviceIndex);
+			string Params = {};
+			for (const auto& Param : Record.RecordParams)
+				Params += (Params.empty() ? "" : ";") + Param.first + "=" + Param.second;
+
+			string RowPrefix = ReportField(Record.BenchmarkName) + "," + to_string(Record.DeviceIndex) + "," +
+				ReportField(Device != nullptr ? Device->DeviceName : "") + "," +
+				ReportField(Device != nullptr ? Device->DriverVersion : "") + "," + ReportField(Params) + ",";
+			for (const auto& Stats : Record.RecordStats) {
+				ReportFile << RowPrefix << ReportField(Stats.first) << "," << Stats.second.SampleCount << ","
+					<< ReportNumber(Stats.second.StatsMin)  << "," << ReportNumber(Stats.second.StatsMedian) << ","
+					<< ReportNumber(Stats.second.StatsP95)  << "," << ReportNumber(Stats.second.StatsP99)    << ","
+					<< ReportNumber(Stats.second.StatsMax)  << "," << ReportNumber(Stats.second.StatsMean)   << ","
+					<< ReportNumber(Stats.second.StatsStddev) << "\n";
+			}
+			// derived value => one sample row.
+			for (const auto& Value : Record.RecordValues) {
+				string Number = ReportNumber(Value.second);
+				ReportFile << RowPrefix << ReportField(Value.first) << ",1," << Number << "," << Number << ","
+					<< Number << "," << Number << "," << Number << "," << Number << ",0\n";
+			}
+		}
+		PushLogger(LogInfo, ModuleTagBenchmark, "write report(csv): %s, records: %zu", filename.c_str(), ReportRecords.size());
+		return ReportFile.good();
+	}
+
+	void SpcaBenchmarkReport::PrintReport() {
+		lock_guard<mutex> Lock(ReportMutex);
+		for (const SpcaBenchmarkRecord& Record : ReportRecords) {
+			ostringstream StringTemp = {};
+			StringTemp << Record.BenchmarkName << " [" << Record.DeviceIndex << "]";
+			for (const auto& Param : Record.RecordParams)
+				StringTemp << " " << Param.first << "=" << Param.second;
+			for (const auto& Stats : Record.RecordStats)
+				StringTemp << ", " << Stats.first << ": " << ReportNumber(Stats.second.StatsMedian)
+					<< " (p95 " << ReportNumber(Stats.second.StatsP95) << ")";
+			for (const auto& Value : Record.RecordValues)
+				StringTemp << ", " << Value.first << ": " << ReportNumber(Value.second);
+			PushLogger(LogPerfmac, ModuleTagBenchmark, "%s", StringTemp.str().c_str());
+		}
+	}
+
+	bool BenchmarkEventsTimes(vector<cl_event>& events, vector<double>& times) {
+		bool StatusFlag = true;
+		if (events.empty()) return StatusFlag;
+		if (clWaitForEvents((cl_uint)events.size(), events.data()) != CL_SUCCESS)
+			StatusFlag = false;
+
+		for (cl_event& Event : events) {
+			cl_ulong TimeStart = NULL, TimeEnd = NULL;
+			if (clGetEventProfilingInfo(Event, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &TimeStart, nullptr) != CL_SUCCESS ||
+				clGetEventProfilingInfo(Event, CL_PROFILING_COMMAND_END,   sizeof(cl_ulong), &TimeEnd,   nullptr) != CL_SUCCESS ||
+				TimeEnd < TimeStart
+			)
+				StatusFlag = false;
+			else
+				times.push_back(double(TimeEnd - TimeStart) * 1e-6);
+			clReleaseEvent(Event);
+		}
+		events.clear();
+		return StatusFlag;
+	}
+
+	double BenchmarkTimesSum(const vector<double>& times) {
+		double TimeTotal = 0.0;
+		for (double Time : times) TimeTotal += Time;
+		return TimeTotal;
+	}
+}
@@ -0,0 +1,82 @@
+// spca_benchmark_suite, (statistics, device metadata, json / csv report), v0.1, RCSZ 2026.10.19
+// benchmarks: warmup + repeats => samples => statistics => records(report).
+
+#ifndef _SPCA_BENCHMARK_SUITE_H
+#define _SPCA_BENCHMARK_SUITE_H
+#include "spca_opencl.h"
+
+namespace SpcaBenchmark {
+	// samples(unit: metric name) => statistics, p95, p99: nearest rank.
+	struct SpcaBenchmarkStats {
+		size_t SampleCount = 0;
+
+		double StatsMin    = 0.0;
+		double StatsMedian = 0.0;
+		double StatsP95    = 0.0;
+		double StatsP99    = 0.0;
+		double StatsMax    = 0.0;
+		double StatsMean   = 0.0;
+		double StatsStddev = 0.0;
+	};
+	SpcaBenchmarkStats BenchmarkStatistics(std::vector<double> samples);
+
+	// device & driver metadata(tracking).
+	struct SpcaBenchmarkDevice {
+		size_t DeviceIndex = 0;
+
+		std::string PlatformName  = {};
+		std::string DeviceName    = {};
+		std::string DeviceVendor  = {};
+		std::string DeviceVersion = {};
+		std::string DriverVersion = {};
+
+		uint32_t ComputeUnits    = 0;
+		uint32_t ClockFrequency  = 0; // mhz.
+		size_t   GlobalMemory    = 0; // bytes.
+		size_t   LocalMemory     = 0; // bytes.
+		size_t   WorkgroupMax    = 0;
+
+		bool SupportFP16 = false;
+		bool SupportFP64 = false;
+	};
+	SpcaBenchmarkDevice BenchmarkDeviceInfo(const SpcaCalcDevice& device, size_t index);
+
+	// one configuration result: params(key, value), stats(metric, samples), values(metric, derived).
+	struct SpcaBenchmarkRecord {
+		std::string BenchmarkName = {};
+		size_t      DeviceIndex   = 0;
+
+		std::vector<std::pair<std::string, std::string>>        RecordParams = {};
+		std::vector<std::pair<std::string, SpcaBenchmarkStats>> RecordStats  = {};
+		std::vector<std::pair<std::string, double>>             RecordValues = {};
+	};
+
+	class SpcaBenchmarkReport {
+	protected:
+		std::vector<SpcaBenchmarkDevice> ReportDevices = {};
+		std::vector<SpcaBenchmarkRecord> ReportRecords = {};
+		std::mutex ReportMutex;
+
+		const SpcaBenchmarkDevice* FindDevice(size_t index);
+	public:
+		// same index => replace.
+		void AddDevice(const SpcaBenchmarkDevice& device);
+		void AddRecord(const SpcaBenchmarkRecord& record);
+		std::vector<SpcaBenchmarkRecord> GetRecords();
+		void ClearReport();
+
+		// json: { devices[], records[] }.
+		bool WriteReportJSON(const std::string& filename);
+		// csv(long): one row per record metric, params => "key=value;..".
+		bool WriteReportCSV(const std::string& filename);
+		// records => logger(perfmac), median.
+		void PrintReport();
+	};
+
+	// wait events => profiling(start => end) ms per event, release events.
+	// return false: wait | profiling failed(error status).
+	bool BenchmarkEventsTimes(std::vector<cl_event>& events, std::vector<double>& times);
+	double BenchmarkTimesSum(const std::vector<double>& times);
+}
+
+#endif
@@ -0,0 +1,311 @@
+// spca_benchmark_transfer.
+#include "spca_benchmark_transfer.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace PSAG_LOGGER;
+
+// rect: buffer row bytes(max), host row pitch = 2 x row.
+#define TRANSFER_RECT_ROW (4 << 10)
+
+namespace SpcaBenchmark {
+    const char* TransferModeName(TransferMODE mode) {
+        switch (mode) {
+        case(TRANSFER_PINNED): return "pinned";
+        case(TRANSFER_MAPPED): return "mapped";
+        case(TRANSFER_RECT):   return "rect";
+        default:               return "pageable";
+        }
+    }
+
+    // one queue resources(mode, size).
+    struct TransferLane {
+        cl_command_queue LaneQueue   = nullptr;
+        cl_mem           LaneBuffer  = nullptr; // device | zero-copy(alloc host ptr).
+        cl_mem           LaneStaging = nullptr; // pinned staging.
+        uint8_t*         LaneHost    = nullptr; // pageable | pinned transfer pointer.
+        vector<uint8_t>  LaneData    = {};      // pageable, rect(pitched), mapped(memcpy).
+        size_t           LaneRowBytes = NULL;
+    };
+
+    static void TransferLaneFree(TransferLane& lane) {
+        if (lane.LaneStaging != nullptr) {
+            if (lane.LaneHost != nullptr)
+                clEnqueueUnmapMemObject(lane.LaneQueue, lane.LaneStaging, lane.LaneHost, NULL, nullptr, nullptr);
+            clFinish(lane.LaneQueue);
+            clReleaseMemObject(lane.LaneStaging);
+        }
+        if (lane.LaneBuffer != nullptr)
+            clReleaseMemObject(lane.LaneBuffer);
+        lane.LaneBuffer  = nullptr;
+        lane.LaneStaging = nullptr;
+        lane.LaneHost    = nullptr;
+        lane.LaneData    = vector<uint8_t>();
+    }
+
+    static bool TransferLaneAlloc(TransferLane& lane, cl_context context, TransferMODE mode, size_t bytes) {
+        cl_int ErrorCode = CL_SUCCESS;
+        try {
+            switch (mode) {
+            case(TRANSFER_PINNED): {
+                lane.LaneBuffer  = clCreateBuffer(context, CL_MEM_READ_WRITE, bytes, nullptr, &ErrorCode);
+                lane.LaneStaging = clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, bytes, nullptr, &ErrorCode);
+                // mapped once => pinned host pointer(lane lifetime).
+                if (lane.LaneStaging != nullptr)
+                    lane.LaneHost = (uint8_t*)clEnqueueMapBuffer(
+                        lane.LaneQueue, lane.LaneStaging, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, bytes,
+                        NULL, nullptr, nullptr, &ErrorCode
+                    );
+                break;
+            }
+            case(TRANSFER_MAPPED): {
+                lane.LaneBuffer = clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, bytes, nullptr, &ErrorCode);
+                lane.LaneData.assign(bytes, 0x5A);
+                break;
+            }
+            case(TRANSFER_RECT): {
+                lane.LaneBuffer = clCreateBuffer(context, CL_MEM_READ_WRITE, bytes, nullptr, &ErrorCode);
+                lane.LaneRowBytes = min(bytes, (size_t)TRANSFER_RECT_ROW);
+                lane.LaneData.assign(bytes * 2, 0x5A);
+                break;
+            }
+            default: {
+                lane.LaneBuffer = clCreateBuffer(context, CL_MEM_READ_WRITE, bytes, nullptr, &ErrorCode);
+                lane.LaneData.assign(bytes, 0x5A);
+                lane.LaneHost = lane.LaneData.data();
+                break;
+            }
+            }
+        }
+        catch (const bad_alloc&) {
+            ErrorCode = CL_OUT_OF_HOST_MEMORY;
+        }
+        bool StatusFlag = ErrorCode == CL_SUCCESS && lane.LaneBuffer != nullptr &&
+            (mode != TRANSFER_PINNED || lane.LaneHost != nullptr);
+        if (!StatusFlag) {
+            PushLogger(LogWarning, ModuleTagBenchmark, "transfer alloc %s, bytes: %zu, code: %i",
+                TransferModeName(mode), bytes, ErrorCode);
+            TransferLaneFree(lane);
+        }
+        return StatusFlag;
+    }
+
+    // one transfer => lane events(profiling), blocking: complete at return.
+    static bool TransferOnce(TransferLane& lane, TransferMODE mode, bool write, bool blocking, size_t bytes, vector<cl_event>& events) {
+        cl_bool Blocking = blocking ? CL_TRUE : CL_FALSE;
+        cl_event Event = nullptr;
+        cl_int ErrorCode = CL_SUCCESS;
+
+        switch (mode) {
+        case(TRANSFER_MAPPED): {
+            cl_event MapEvent = nullptr;
+            // memcpy needs pointer => map always waits.
+            void* Mapped = clEnqueueMapBuffer(
+                lane.LaneQueue, lane.LaneBuffer, CL_TRUE, write ? CL_MAP_WRITE_INVALIDATE_REGION : CL_MAP_READ,
+                0, bytes, NULL, nullptr, &MapEvent, &ErrorCode
+            );
+            if (MapEvent != nullptr) events.push_back(MapEvent);
+            if (Mapped == nullptr || ErrorCode != CL_SUCCESS) return false;
+
+            if (write) memcpy(Mapped, lane.LaneData.data(), bytes);
+            else       memcpy(lane.LaneData.data(), Mapped, bytes);
+            ErrorCode = clEnqueueUnmapMemObject(lane.LaneQueue, lane.LaneBuffer, Mapped, NULL, nullptr, &Event);
+            if (ErrorCode == CL_SUCCESS && blocking)
+                ErrorCode = clWaitForEvents(1, &Event);
+            break;
+        }
+        case(TRANSFER_RECT): {
+            size_t Origin[3] = { 0, 0, 0 };
+            size_t Region[3] = { lane.LaneRowBytes, bytes / lane.LaneRowBytes, 1 };
+            ErrorCode = write ?
+                clEnqueueWriteBufferRect(
+                    lane.LaneQueue, lane.LaneBuffer, Blocking, Origin, Origin, Region,
+                    lane.LaneRowBytes, 0, lane.LaneRowBytes * 2, 0, lane.LaneData.data(), NULL, nullptr, &Event
+                ) :
+                clEnqueueReadBufferRect(
+                    lane.LaneQueue, lane.LaneBuffer, Blocking, Origin, Origin, Region,
+                    lane.LaneRowBytes, 0, lane.LaneRowBytes * 2, 0, lane.LaneData.data(), NULL, nullptr, &Event
+                );
+            break;
+        }
+        default: {
+            ErrorCode = write ?
+                clEnqueueWriteBuffer(lane.LaneQueue, lane.LaneBuffer, Blocking, 0, bytes, lane.LaneHost, NULL, nullptr, &Event) :
+                clEnqueueReadBuffer (lane.LaneQueue, lane.LaneBuffer, Blocking, 0, bytes, lane.LaneHost, NULL, nullptr, &Event);
+            break;
+        }
+        }
+        if (Event != nullptr) events.push_back(Event);
+        return ErrorCode == CL_SUCCESS;
+    }
+
+    // warmup + runs => latency(host wall, us) & device(max lane profiling sum, us).
+    static bool TransferMeasure(
+        vector<TransferLane>& lanes, size_t queues, TransferMODE mode, bool write, bool blocking, size_t bytes,
+        size_t warmup, size_t runs, vector<double>& latency, vector<double>& device
+    ) {
+        for (size_t i = 0; i < warmup + runs; ++i) {
+            vector<vector<cl_event>> LaneEvents(queues);
+            vector<char> LaneStatus(queues, 1);
+
+            chrono::steady_clock::time_point TimeStart = {};
+            if (blocking && queues > 1) {
+                // one thread per queue, started => spin(release) => timed.
+                atomic<bool>   StartFlag(false);
+                atomic<size_t> DoneCount(NULL);
+                vector<thread> LaneThreads = {};
+                for (size_t q = 0; q < queues; ++q) {
+                    LaneThreads.emplace_back([&, q]() {
+                        while (!StartFlag.load(memory_order_acquire))
+                            this_thread::yield();
+                        LaneStatus[q] = TransferOnce(lanes[q], mode, write, true, bytes, LaneEvents[q]);
+                        DoneCount.fetch_add(1, memory_order_acq_rel);
+                    });
+                }
+                TimeStart = chrono::steady_clock::now();
+                StartFlag.store(true, memory_order_release);
+                while (DoneCount.load(memory_order_acquire) < queues)
+                    this_thread::yield();
+                auto TimeEnd = chrono::steady_clock::now();
+                for (auto& LaneThread : LaneThreads) LaneThread.join();
+                latency.push_back(chrono::duration<double, micro>(TimeEnd - TimeStart).count());
+            }
+            else {
+                TimeStart = chrono::steady_clock::now();
+                for (size_t q = 0; q < queues; ++q)
+                    LaneStatus[q] = TransferOnce(lanes[q], mode, write, blocking, bytes, LaneEvents[q]);
+                if (!blocking) {
+                    vector<cl_event> WaitEvents = {};
+                    for (const auto& Events : LaneEvents)
+                        WaitEvents.insert(WaitEvents.end(), Events.begin(), Events.end());
+                    if (!WaitEvents.empty() && clWaitForEvents((cl_uint)WaitEvents.size(), WaitEvents.data()) != CL_SUCCESS)
+                        LaneStatus[0] = 0;
+                }
+                latency.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - TimeStart).count());
+            }
+            double DeviceTime = 0.0;
+            bool StatusFlag = true;
+            for (size_t q = 0; q < queues; ++q) {
+                vector<double> EventTimes = {};
+                StatusFlag &= BenchmarkEventsTimes(LaneEvents[q], EventTimes) && LaneStatus[q];
+                DeviceTime = max(DeviceTime, BenchmarkTimesSum(EventTimes) * 1000.0);
+            }
+            if (!StatusFlag) {
+                PushLogger(LogError, ModuleTagBenchmark, "transfer %s failed, bytes: %zu, queues: %zu",
+                    TransferModeName(mode), bytes, queues);
+                return false;
+            }
+            // warmup => discard.
+            if (i < warmup) latency.pop_back();
+            else            device.push_back(DeviceTime);
+        }
+        return true;
+    }
+
+    size_t SpcaBenchmarkTransfer::RunTransferDevice(size_t device, const SpcaTransferConfig& config) {
+        SpcaBenchmarkDevice DeviceInfo = BenchmarkDeviceInfo(PlatformDevicesArray[device], device);
+        TransferReport.AddDevice(DeviceInfo);
+
+        CalcDeviceIndexCode = device;
+        cl_device_id DeviceHandle = nullptr;
+        cl_context Context = SpcaCreateContext(&DeviceHandle);
+        if (Context == nullptr) return NULL;
+
+        size_t QueueMax = 1;
+        for (size_t Queues : config.QueueCounts) QueueMax = max(QueueMax, Queues);
+        vector<TransferLane> Lanes(QueueMax);
+        bool StatusFlag = true;
+        for (auto& Lane : Lanes) {
+            Lane.LaneQueue = SpcaCreateCommandQueue(Context, DeviceHandle);
+            StatusFlag &= Lane.LaneQueue != nullptr;
+        }
+        cl_ulong MaxAlloc = NULL;
+        clGetDeviceInfo(DeviceHandle, CL_DEVICE_MAX_MEM_ALLOC_SIZE, sizeof(cl_ulong), &MaxAlloc, nullptr);
+
+        vector<bool> BlockingModes = {};
+        if (config.TestBlocking)    BlockingModes.push_back(true);
+        if (config.TestNonBlocking) BlockingModes.push_back(false);
+
+        size_t RecordCount = NULL;
+        const TransferMODE Modes[] = { TRANSFER_PAGEABLE, TRANSFER_PINNED, TRANSFER_MAPPED, TRANSFER_RECT };
+        for (TransferMODE Mode : Modes) {
+            if (!StatusFlag || !(config.Modes & Mode)) continue;
+            // device buffers per lane, pinned: buffer + staging(alloc host ptr).
+            size_t LaneBuffers = Mode == TRANSFER_PINNED ? 2 : 1;
+
+            for (size_t Bytes = config.SizeMin; Bytes > NULL && Bytes <= config.SizeMax; Bytes *= max(config.SizeStep, (size_t)2)) {
+                // all lanes buffers => half global memory.
+                if (Bytes > (size_t)MaxAlloc || Bytes * QueueMax * LaneBuffers > DeviceInfo.GlobalMemory / 2) {
+                    PushLogger(LogInfo, ModuleTagBenchmark, "transfer device %zu: %s stop at %zu bytes(memory).",
+                        device, TransferModeName(Mode), Bytes);
+                    break;
+                }
+                if (Mode == TRANSFER_RECT && Bytes % min(Bytes, (size_t)TRANSFER_RECT_ROW) != NULL)
+                    continue;
+
+                bool AllocFlag = true;
+                for (auto& Lane : Lanes)
+                    AllocFlag = AllocFlag && TransferLaneAlloc(Lane, Context, Mode, Bytes);
+                size_t Runs = Bytes < (1 << 20) ? max(config.RepeatSmallCount, config.RepeatCount) : config.RepeatCount;
+
+                for (bool Blocking : BlockingModes) {
+                    for (size_t Queues : config.QueueCounts) {
+                        for (bool Write : { true, false }) {
+                            if (!AllocFlag || Queues == NULL || Runs == NULL) continue;
+
+                            vector<double> Latency = {}, DeviceTimes = {};
+                            if (!TransferMeasure(Lanes, Queues, Mode, Write, Blocking, Bytes, config.WarmupCount, Runs, Latency, DeviceTimes))
+                                continue;
+                            SpcaBenchmarkRecord RecordTemp = {};
+                            RecordTemp.BenchmarkName = "transfer";
+                            RecordTemp.DeviceIndex   = device;
+                            RecordTemp.RecordParams = {
+                                { "mode",      TransferModeName(Mode) },
+                                { "direction", Write ? "write" : "read" },
+                                { "blocking",  Blocking ? "1" : "0" },
+                                { "queues",    to_string(Queues) },
+                                { "bytes",     to_string(Bytes) }
+                            };
+                            RecordTemp.RecordStats = {
+                                { "latency_us", BenchmarkStatistics(Latency) },
+                                { "device_us",  BenchmarkStatistics(DeviceTimes) }
+                            };
+                            // gib/s: bytes(all queues) / latency.
+                            double TotalGiB = double(Bytes * Queues) / 1073741824.0;
+                            RecordTemp.RecordValues = {
+                                { "bandwidth_gibs", TotalGiB / (RecordTemp.RecordStats[0].second.StatsMedian * 1e-6) },
+                                { "peak_gibs",      TotalGiB / (RecordTemp.RecordStats[0].second.StatsMin    * 1e-6) }
+                            };
+                            TransferReport.AddRecord(RecordTemp);
+                            ++RecordCount;
+                        }
+                    }
+                }
+                for (auto& Lane : Lanes) TransferLaneFree(Lane);
+                if (!AllocFlag) break;
+            }
+        }
+        for (auto& Lane : Lanes)
+            if (Lane.LaneQueue != nullptr) clReleaseCommandQueue(Lane.LaneQueue);
+        clReleaseContext(Context);
+        return RecordCount;
+    }
+
+    size_t SpcaBenchmarkTransfer::RunTransferBenchmark(const SpcaTransferConfig& config) {
+        vector<size_t> Devices = config.Devices;
+        if (Devices.empty())
+            for (size_t i = 0; i < PlatformDevicesArray.size(); ++i) Devices.push_back(i);
+
+        size_t RecordCount = NULL;
+        for (size_t Device : Devices) {
+            if (Device >= PlatformDevicesArray.size()) {
+                PushLogger(LogWarning, ModuleTagBenchmark, "transfer invalid device: %zu", Device);
+                continue;
+            }
+            RecordCount += RunTransferDevice(Device, config);
+        }
+        PushLogger(LogInfo, ModuleTagBenchmark, "transfer complete, devices: %zu, records: %zu", Devices.size(), RecordCount);
+        return RecordCount;
+    }
+}
@@ -0,0 +1,52 @@
+// spca_benchmark_transfer, (host <=> device latency & bandwidth curves), v0.1, RCSZ 2026.10.19
+// sweep: sizes x memory modes x blocking x concurrent queues x direction => report("transfer").
+
+#ifndef _SPCA_BENCHMARK_TRANSFER_H
+#define _SPCA_BENCHMARK_TRANSFER_H
+#include "spca_benchmark_suite.h"
+
+namespace SpcaBenchmark {
+	// host memory modes.
+	enum TransferMODE {
+		TRANSFER_PAGEABLE = 1 << 1, // host vector => read/write buffer.
+		TRANSFER_PINNED   = 1 << 2, // alloc host ptr(staging, mapped once) => read/write buffer.
+		TRANSFER_MAPPED   = 1 << 3, // zero-copy: map => memcpy => unmap.
+		TRANSFER_RECT     = 1 << 4  // pitched host rows(2x) => read/write buffer rect.
+	};
+	const char* TransferModeName(TransferMODE mode);
+
+	struct SpcaTransferConfig {
+		// sizes: min, min * step.. <= max(bytes), clamped: max alloc, global memory / 2.
+		size_t SizeMin  = 4 << 10;
+		size_t SizeMax  = size_t(4) << 30;
+		size_t SizeStep = 2;
+
+		uint32_t Modes = TRANSFER_PAGEABLE | TRANSFER_PINNED | TRANSFER_MAPPED | TRANSFER_RECT;
+		bool TestBlocking    = true;
+		bool TestNonBlocking = true;
+		// concurrent queues(one host thread per queue when blocking).
+		std::vector<size_t> QueueCounts = { 1, 2, 4 };
+		// device index, empty: all devices.
+		std::vector<size_t> Devices = {};
+
+		size_t WarmupCount = 2;
+		size_t RepeatCount = 10;
+		// size < 1mib: latency bound => more repeats.
+		size_t RepeatSmallCount = 100;
+	};
+
+	class SpcaBenchmarkTransfer :protected SPCA_CORE_OPENCL {
+	protected:
+		SpcaBenchmarkReport TransferReport = {};
+		// one device sweep, return: records.
+		size_t RunTransferDevice(size_t device, const SpcaTransferConfig& config);
+	public:
+		// stats: latency_us(host wall, per op), device_us(profiling, max of queues).
+		// values: bandwidth_gibs(median), peak_gibs(min latency), all queues bytes.
+		// return: recorded configs.
+		size_t RunTransferBenchmark(const SpcaTransferConfig& config);
+		SpcaBenchmarkReport& GetTransferReport() { return TransferReport; }
+	};
+}
+
+#endif
@@ -0,0 +1,142 @@
+// spca_coroutine.
+#include "spca_coroutine.hpp"
+
+#ifdef SPCA_COROUTINE_ENABLE
+using namespace std;
+using namespace PSAG_LOGGER;
+
+#define MODULE_LABEL_COROUTINE "SPCA_COROUTINE"
+
+namespace SpcaCoroutine {
+    void CoScheduler::Resume(coroutine_handle<> handle, SpcaTasks::TaskPriority priority) {
+        try {
+            SchedulerPool->PostPriority(priority, [handle]() { handle.resume(); });
+        }
+        catch (...) {
+            // paused(free) pool => frame never lost.
+            PushLogger(LogWarning, MODULE_LABEL_COROUTINE, "pool paused, resume on caller thread.");
+            handle.resume();
+        }
+    }
+
+    void CL_CALLBACK CoEventsAwaiter::EventCallback(cl_event, cl_int status, void* user_data) {
+        CoEventsAwaiter* Awaiter = (CoEventsAwaiter*)user_data;
+        Awaiter->SetStatus(status);
+        // driver thread => pool worker.
+        if (Awaiter->CountDown())
+            Awaiter->AwaitScheduler->Resume(Awaiter->AwaitHandle);
+    }
+
+    void CoEventsAwaiter::SetStatus(cl_int status) {
+        cl_int Expected = CL_COMPLETE;
+        if (status < CL_COMPLETE)
+            AwaitStatus.compare_exchange_strong(Expected, status);
+    }
+
+    bool CoEventsAwaiter::CountDown() {
+        return AwaitRemaining.fetch_sub(1, memory_order_acq_rel) == 1;
+    }
+
+    CoEventsAwaiter::~CoEventsAwaiter() {
+        for (cl_event Event : AwaitEvents)
+            if (Event != nullptr) clReleaseEvent(Event);
+    }
+
+    bool CoEventsAwaiter::await_ready() {
+        for (cl_event Event : AwaitEvents) {
+            if (Event == nullptr) {
+                SetStatus(CL_INVALID_EVENT);
+                continue;
+            }
+            cl_int ExecutionStatus = CL_QUEUED;
+            if (clGetEventInfo(Event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(cl_int), &ExecutionStatus, nullptr) != CL_SUCCESS)
+                return false;
+            if (ExecutionStatus > CL_COMPLETE)
+                return false;
+            SetStatus(ExecutionStatus);
+        }
+        return true;
+    }
+
+    bool CoEventsAwaiter::await_suspend(coroutine_handle<> handle) {
+        AwaitHandle = handle;
+        // remaining: events + registration.
+        AwaitRemaining.store(AwaitEvents.size() + 1, memory_order_release);
+        for (cl_event Event : AwaitEvents) {
+            cl_int ErrorCode = Event != nullptr ?
+                clSetEventCallback(Event, CL_COMPLETE, EventCallback, this) : CL_INVALID_EVENT;
+            if (ErrorCode != CL_SUCCESS) {
+                PushLogger(LogError, MODULE_LABEL_COROUTINE, "failed event callback, code: %d", ErrorCode);
+                SetStatus(ErrorCode);
+                CountDown();
+            }
+        }
+        // all callbacks done => non-suspend(this thread).
+        return !CountDown();
+    }
+
+    CoTask<bool> CoWriteDataset(CoScheduler& scheduler, SpcaMatrixCalc::SpcaMatrix2Calc& calc) {
+        // dataset(host) => frame, alive until writes complete.
+        vector<SpcaIndexMatrix<float>> Dataset = {};
+        vector<cl_event> Events = {};
+        if (!calc.SpcaAsyncWriteDataset(Dataset, Events))
+            co_return false;
+
+        cl_int Status = co_await scheduler.AwaitEvents(move(Events));
+        if (Status != CL_COMPLETE) {
+            PushLogger(LogError, MODULE_LABEL_COROUTINE, "write dataset event, status: %d", Status);
+            co_return false;
+        }
+        co_return true;
+    }
+
+    CoTask<bool> CoMatrixCalc(
+        CoScheduler& scheduler, SpcaMatrixCalc::SpcaMatrix2Calc& calc,
+        size_t global_size_x, size_t global_size_y, size_t global_size_z
+    ) {
+        cl_event RunEvent = nullptr;
+        if (!calc.SpcaAsyncMatrixCalc(RunEvent, global_size_x, global_size_y, global_size_z))
+            co_return false;
+        // profiling after complete, awaiter releases.
+        clRetainEvent(RunEvent);
+        cl_int Status = co_await scheduler.AwaitEvent(RunEvent);
+
+        cl_ulong TimeStart = NULL, TimeEnd = NULL;
+        clGetEventProfilingInfo(RunEvent, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &TimeStart, nullptr);
+        clGetEventProfilingInfo(RunEvent, CL_PROFILING_COMMAND_END,   sizeof(cl_ulong), &TimeEnd,   nullptr);
+        clReleaseEvent(RunEvent);
+        if (Status != CL_COMPLETE) {
+            SpcaGetRuntimeMetrics().CalcFailed.Add();
+            PushLogger(LogError, MODULE_LABEL_COROUTINE, "kernel event, status: %d", Status);
+            co_return false;
+        }
+        calc.SystemRunTotalTime = double(TimeEnd - TimeStart) * 1e-6;
+        SpcaGetRuntimeMetrics().KernelTime.Observe(calc.SystemRunTotalTime);
+        co_return true;
+    }
+
+    CoTask<vector<SpcaIndexMatrix<float>>> CoReadResult(CoScheduler& scheduler, SpcaMatrixCalc::SpcaMatrix2Calc& calc) {
+        vector<SpcaIndexMatrix<float>> Result = {};
+        vector<cl_event> Events = {};
+        if (!calc.SpcaAsyncReadResult(Result, Events))
+            co_return vector<SpcaIndexMatrix<float>>();
+
+        cl_int Status = co_await scheduler.AwaitEvents(move(Events));
+        if (Status != CL_COMPLETE) {
+            PushLogger(LogError, MODULE_LABEL_COROUTINE, "read result event, status: %d", Status);
+            co_return vector<SpcaIndexMatrix<float>>();
+        }
+        co_return move(Result);
+    }
+
+    CoTask<size_t> CoMatrixFileRead(
+        CoScheduler& scheduler, string filename, SpcaIndexMatrix<float>& matrix_data,
+        SpcaTasks::ThreadTasks* codec_tasks
+    ) {
+        // blocking read => pool task, frame suspended(non-thread) until ready.
+        co_return co_await scheduler.Await(scheduler.GetPool().Submit([&]() {
+            return SpcaMatrixCalc::SpcaMatrixFilesys::SpacFTmatrixFileRead(filename, matrix_data, codec_tasks);
+        }));
+    }
+}
+#endif
@@ -0,0 +1,246 @@
+// spca_coroutine, (c++20 coroutines: tasks, pool scheduler, opencl events), v0.1, RCSZ 2026.10.19
+// co_await: uploads, kernels, readbacks(event callbacks), file loads(pool tasks) => resume on pool workers.
+// non-coroutine compiler(c++17) => empty module.
+
+#ifndef _SPCA_COROUTINE_HPP
+#define _SPCA_COROUTINE_HPP
+#include "spca_opencl.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define SPCA_COROUTINE_ENABLE
+
+namespace SpcaCoroutine {
+    template<typename ResultType>
+    class CoTask;
+
+    // promise result: value | void.
+    template<typename ResultType>
+    struct CoPromiseResult {
+        std::optional<ResultType> PromiseResult = {};
+
+        template<typename ValueType>
+        void return_value(ValueType&& value) { PromiseResult.emplace(std::forward<ValueType>(value)); }
+        ResultType TakeResult() { return std::move(*PromiseResult); }
+    };
+    template<>
+    struct CoPromiseResult<void> {
+        void return_void() {}
+        void TakeResult() {}
+    };
+
+    // lazy task: start => co_await(caller frame) | scheduler spawn, end => continuation(symmetric).
+    template<typename ResultType>
+    class CoTask {
+    public:
+        struct promise_type :public CoPromiseResult<ResultType> {
+            std::exception_ptr      PromiseException = nullptr;
+            std::coroutine_handle<> PromiseContinuation = nullptr;
+
+            CoTask get_return_object() {
+                return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            struct FinalAwaiter {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                    std::coroutine_handle<> Continuation = handle.promise().PromiseContinuation;
+                    return Continuation ? Continuation : std::noop_coroutine();
+                }
+                void await_resume() noexcept {}
+            };
+            FinalAwaiter final_suspend() noexcept { return {}; }
+            void unhandled_exception() { PromiseException = std::current_exception(); }
+        };
+    protected:
+        std::coroutine_handle<promise_type> TaskHandle = nullptr;
+    public:
+        CoTask() = default;
+        explicit CoTask(std::coroutine_handle<promise_type> handle) : TaskHandle(handle) {}
+        CoTask(CoTask&& other) noexcept : TaskHandle(other.TaskHandle) { other.TaskHandle = nullptr; }
+        CoTask& operator=(CoTask&& other) noexcept {
+            if (this != &other) {
+                if (TaskHandle) TaskHandle.destroy();
+                TaskHandle = other.TaskHandle;
+                other.TaskHandle = nullptr;
+            }
+            return *this;
+        }
+        CoTask(const CoTask&) = delete;
+        CoTask& operator=(const CoTask&) = delete;
+        ~CoTask() {
+            if (TaskHandle) TaskHandle.destroy();
+        }
+        bool Valid() const { return (bool)TaskHandle; }
+
+        struct TaskAwaiter {
+            std::coroutine_handle<promise_type> AwaitHandle;
+
+            bool await_ready() noexcept { return !AwaitHandle || AwaitHandle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+                AwaitHandle.promise().PromiseContinuation = caller;
+                return AwaitHandle;
+            }
+            ResultType await_resume() {
+                if (!AwaitHandle)
+                    throw std::future_error(std::future_errc::no_state);
+                if (AwaitHandle.promise().PromiseException != nullptr)
+                    std::rethrow_exception(AwaitHandle.promise().PromiseException);
+                return AwaitHandle.promise().TakeResult();
+            }
+        };
+        TaskAwaiter operator co_await() && noexcept { return TaskAwaiter{ TaskHandle }; }
+        TaskAwaiter operator co_await() &  noexcept { return TaskAwaiter{ TaskHandle }; }
+    };
+
+    // fire and forget frame(spawn), end => self destroy.
+    struct CoDetached {
+        struct promise_type {
+            CoDetached get_return_object() {
+                return CoDetached{ std::coroutine_handle<promise_type>::from_promise(*this) };
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_never  final_suspend()   noexcept { return {}; }
+            void return_void() {}
+            // body catches all(spawn => future exception).
+            void unhandled_exception() {}
+        };
+        std::coroutine_handle<promise_type> DetachedHandle;
+    };
+
+    template<typename ResultType>
+    CoDetached CoSpawnExecution(CoTask<ResultType> task, SpcaTasks::TaskPromise<ResultType> promise) {
+        try {
+            if constexpr (std::is_void_v<ResultType>) {
+                co_await std::move(task);
+                promise.SetValue();
+            }
+            else
+                promise.SetValue(co_await std::move(task));
+        }
+        catch (...) {
+            promise.SetException(std::current_exception());
+        }
+    }
+
+    class CoScheduler;
+
+    // opencl events => one resume(last callback), events owned(released at destruct).
+    // result: CL_COMPLETE | first error status.
+    class CoEventsAwaiter {
+    protected:
+        CoScheduler*            AwaitScheduler;
+        std::vector<cl_event>   AwaitEvents;
+        std::atomic<size_t>     AwaitRemaining{NULL};
+        std::atomic<cl_int>     AwaitStatus{CL_COMPLETE};
+        std::coroutine_handle<> AwaitHandle = nullptr;
+
+        static void CL_CALLBACK EventCallback(cl_event, cl_int status, void* user_data);
+        void SetStatus(cl_int status);
+        // true: last(resume).
+        bool CountDown();
+    public:
+        CoEventsAwaiter(CoScheduler* scheduler, std::vector<cl_event>&& events) :
+            AwaitScheduler(scheduler), AwaitEvents(std::move(events))
+        {}
+        CoEventsAwaiter(const CoEventsAwaiter&) = delete;
+        ~CoEventsAwaiter();
+
+        // all events complete(query) => non-suspend.
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        cl_int await_resume() { return AwaitStatus.load(); }
+    };
+
+    // pool workers => coroutines, few threads: suspended frames non-thread.
+    class CoScheduler {
+    protected:
+        SpcaTasks::ThreadTasks* SchedulerPool;
+    public:
+        CoScheduler(SpcaTasks::ThreadTasks& pool) : SchedulerPool(&pool) {}
+        SpcaTasks::ThreadTasks& GetPool() { return *SchedulerPool; }
+
+        // handle => pool worker(resume), paused pool => resume this thread.
+        void Resume(std::coroutine_handle<> handle, SpcaTasks::TaskPriority priority = SpcaTasks::PriorityNormal);
+
+        // co_await: continue on pool worker.
+        struct ScheduleAwaiter {
+            CoScheduler*            AwaitScheduler;
+            SpcaTasks::TaskPriority AwaitPriority;
+
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { AwaitScheduler->Resume(handle, AwaitPriority); }
+            void await_resume() noexcept {}
+        };
+        ScheduleAwaiter Schedule(SpcaTasks::TaskPriority priority = SpcaTasks::PriorityNormal) {
+            return ScheduleAwaiter{ this, priority };
+        }
+
+        // task => pool worker(start), result => future(then, when_all, wait).
+        template<typename ResultType>
+        SpcaTasks::TaskFuture<ResultType> Spawn(CoTask<ResultType> task) {
+            SpcaTasks::TaskPromise<ResultType> Promise;
+            SpcaTasks::TaskFuture<ResultType> ResultFuture = Promise.GetFuture();
+            CoDetached Detached = CoSpawnExecution<ResultType>(std::move(task), std::move(Promise));
+            Resume(Detached.DetachedHandle);
+            return ResultFuture;
+        }
+        // spawn & caller helps(execute tasks) => result, non-worker entry(main).
+        template<typename ResultType>
+        ResultType RunSync(CoTask<ResultType> task) {
+            SpcaTasks::TaskFuture<ResultType> Future = Spawn(std::move(task));
+            SchedulerPool->WaitFuture(Future);
+            return Future.Get();
+        }
+
+        // co_await pool future: ready => resume(pool worker), non-blocking.
+        template<typename ResultType>
+        struct FutureAwaiter {
+            CoScheduler*                      AwaitScheduler;
+            SpcaTasks::TaskFuture<ResultType> AwaitFuture;
+
+            bool await_ready() { return !AwaitFuture.Valid() || AwaitFuture.IsReady(); }
+            void await_suspend(std::coroutine_handle<> handle) {
+                auto Continuation = [Scheduler = AwaitScheduler, handle]() { Scheduler->Resume(handle); };
+                AwaitFuture.GetFutureState()->AddContinuation(
+                    SpcaTasks::CreateTaskNode<decltype(Continuation)>(Continuation)
+                );
+            }
+            ResultType await_resume() { return AwaitFuture.Get(); }
+        };
+        template<typename ResultType>
+        FutureAwaiter<ResultType> Await(SpcaTasks::TaskFuture<ResultType> future) {
+            return FutureAwaiter<ResultType>{ this, std::move(future) };
+        }
+
+        // events: ownership => awaiter(release), enqueued & flushed.
+        CoEventsAwaiter AwaitEvents(std::vector<cl_event> events) {
+            return CoEventsAwaiter(this, std::move(events));
+        }
+        CoEventsAwaiter AwaitEvent(cl_event event) {
+            return CoEventsAwaiter(this, std::vector<cl_event>{ event });
+        }
+    };
+
+    // calc stages(SpcaMatrix2Calc async) => co_await, "calc" lifetime > task.
+    // false: enqueue failed | event error status.
+    CoTask<bool> CoWriteDataset(CoScheduler& scheduler, SpcaMatrixCalc::SpcaMatrix2Calc& calc);
+    // complete => "calc.SystemRunTotalTime"(profiling, ms).
+    CoTask<bool> CoMatrixCalc(
+        CoScheduler& scheduler, SpcaMatrixCalc::SpcaMatrix2Calc& calc,
+        size_t global_size_x, size_t global_size_y, size_t global_size_z = 0
+    );
+    // failed: empty result.
+    CoTask<std::vector<SpcaIndexMatrix<float>>> CoReadResult(CoScheduler& scheduler, SpcaMatrixCalc::SpcaMatrix2Calc& calc);
+
+    // matrix file read => pool task(blocking io), "matrix_data" mode == file mode.
+    // "codec_tasks": any pool, scheduler pool allowed(block decode: caller helps, non-deadlock).
+    // success: return file_time_code, failed: return 0.
+    CoTask<size_t> CoMatrixFileRead(
+        CoScheduler& scheduler, std::string filename, SpcaIndexMatrix<float>& matrix_data,
+        SpcaTasks::ThreadTasks* codec_tasks = nullptr
+    );
+}
+#endif
+#endif
@@ -1,5 +1,8 @@
 // cdc_opencl.
 #include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <unordered_set>
 #include "spca_opencl.h"
 
 using namespace std;
@@ -63,6 +66,119 @@ cl_int SpcaCLEnqueueNDRangeKernel(
 	);
 }
 
+SpcaRuntimeMetrics& SpcaGetRuntimeMetrics() {
+	SpcaMetrics::MetricsRegistry& Registry = SpcaMetrics::GlobalMetrics();
+	static SpcaRuntimeMetrics RuntimeMetrics = {
+		Registry.GetCounter("spca_calc_jobs_total",   "ndrange jobs executed."),
+		Registry.GetCounter("spca_calc_failed_total", "ndrange jobs failed."),
+		Registry.GetHistogram("spca_kernel_time_ms",  "kernel execution time(ms).", SpcaMetrics::ExponentialBounds(0.01, 4.0, 12)),
+
+		Registry.GetCounter("spca_transfer_write_bytes_total", "host => device bytes."),
+		Registry.GetCounter("spca_transfer_read_bytes_total",  "device => host bytes."),
+		Registry.GetHistogram("spca_memobj_alloc_bytes",       "memory object size(bytes).", SpcaMetrics::ExponentialBounds(4096.0, 4.0, 12)),
+
+		Registry.GetCounter("spca_loader_recycle_hits_total",   "prefetch loader recycled storage reuse."),
+		Registry.GetCounter("spca_loader_recycle_misses_total", "prefetch loader new storage."),
+		Registry.GetCounter("spca_loader_read_bytes_total",     "prefetch loader payload bytes.")
+	};
+	return RuntimeMetrics;
+}
+
+struct SpcaTraceEventContext {
+	const char* EventName;
+	uint64_t    HostEnqueueTime;
+	size_t      EventBytes;
+	uint32_t    QueueTrack;
+};
+
+static void CL_CALLBACK SpcaTraceEventCallback(cl_event event, cl_int status, void* user_data) {
+	unique_ptr<SpcaTraceEventContext> Context((SpcaTraceEventContext*)user_data);
+
+	cl_ulong TimeQueued = NULL, TimeSubmit = NULL, TimeStart = NULL, TimeEnd = NULL;
+	if (status == CL_COMPLETE &&
+		clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_QUEUED, sizeof(cl_ulong), &TimeQueued, nullptr) == CL_SUCCESS &&
+		clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_SUBMIT, sizeof(cl_ulong), &TimeSubmit, nullptr) == CL_SUCCESS &&
+		clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START,  sizeof(cl_ulong), &TimeStart,  nullptr) == CL_SUCCESS &&
+		clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END,    sizeof(cl_ulong), &TimeEnd,    nullptr) == CL_SUCCESS &&
+		TimeQueued <= TimeStart && TimeStart <= TimeEnd
+	) {
+		// device clock => host clock.
+		uint64_t HostQueued = Context->HostEnqueueTime;
+		uint32_t TrackDevice = SPCA_TRACE_TRACK_DEVICE + Context->QueueTrack * 2;
+
+		char ArgsTemp[160] = {};
+		snprintf(ArgsTemp, sizeof(ArgsTemp),
+			"\"bytes\":%llu,\"queued_submit_ns\":%llu,\"submit_start_ns\":%llu,\"start_end_ns\":%llu",
+			(unsigned long long)Context->EventBytes, (unsigned long long)(TimeSubmit - TimeQueued),
+			(unsigned long long)(TimeStart - TimeSubmit), (unsigned long long)(TimeEnd - TimeStart)
+		);
+		// track(n): execution, track(n + 1): queued => start.
+		SpcaTracer::TracePushSpan(
+			Context->EventName, "opencl", HostQueued + (TimeStart - TimeQueued), TimeEnd - TimeStart, TrackDevice, ArgsTemp
+		);
+		SpcaTracer::TracePushSpan(
+			Context->EventName, "opencl_wait", HostQueued, TimeStart - TimeQueued, TrackDevice + 1
+		);
+	}
+	clReleaseEvent(event);
+}
+
+// queue tracks named(once): bits queue < 64, others => set(mutex).
+static atomic<uint64_t> TraceNamedQueueBits = {};
+static mutex TraceNamedQueueMutex = {};
+static unordered_set<uint32_t> TraceNamedQueues = {};
+
+static void SpcaTraceQueueName(uint32_t queue_track) {
+	if (queue_track < 64) {
+		uint64_t QueueBit = (uint64_t)1 << queue_track;
+		if (TraceNamedQueueBits.fetch_or(QueueBit, memory_order_relaxed) & QueueBit)
+			return;
+	}
+	else {
+		lock_guard<mutex> Lock(TraceNamedQueueMutex);
+		if (!TraceNamedQueues.insert(queue_track).second)
+			return;
+	}
+	uint32_t TrackDevice = SPCA_TRACE_TRACK_DEVICE + queue_track * 2;
+	SpcaTracer::TraceSetTrackName(TrackDevice,     "opencl queue " + to_string(queue_track));
+	SpcaTracer::TraceSetTrackName(TrackDevice + 1, "opencl queue " + to_string(queue_track) + " (wait)");
+}
+
+void SpcaTraceEventCL(cl_event event, const char* name, size_t bytes, uint32_t queue_track) {
+	if (event == nullptr || !SpcaTracer::TraceEnabled()) return;
+	SpcaTraceQueueName(queue_track);
+
+	// retain => callback release.
+	auto Context = new SpcaTraceEventContext{ name, SpcaTracer::TraceTimeNow(), bytes, queue_track };
+	clRetainEvent(event);
+	if (clSetEventCallback(event, CL_COMPLETE, SpcaTraceEventCallback, Context) != CL_SUCCESS) {
+		clReleaseEvent(event);
+		delete Context;
+	}
+}
+
+static void CL_CALLBACK SpcaEventFutureCallback(cl_event event, cl_int status, void* user_data) {
+	unique_ptr<SpcaTasks::TaskPromise<cl_int>> Promise((SpcaTasks::TaskPromise<cl_int>*)user_data);
+	Promise->SetValue(status);
+	clReleaseEvent(event);
+}
+
+SpcaTasks::TaskFuture<cl_int> SpcaEventFutureCL(cl_event event) {
+	auto Promise = new SpcaTasks::TaskPromise<cl_int>();
+	SpcaTasks::TaskFuture<cl_int> ResultFuture = Promise->GetFuture();
+	// retain => callback release.
+	if (event != nullptr && clRetainEvent(event) == CL_SUCCESS) {
+		cl_int ErrorCode = clSetEventCallback(event, CL_COMPLETE, SpcaEventFutureCallback, Promise);
+		if (ErrorCode == CL_SUCCESS)
+			return ResultFuture;
+		clReleaseEvent(event);
+		PSAG_LOGGER::PushLogger(LogError, ModuleTagOpenCL, "failed event future callback, code: %d", ErrorCode);
+	}
+	Promise->SetException(make_exception_ptr(runtime_error("spca opencl invalid event.")));
+	delete Promise;
+	return ResultFuture;
+}
+
 void SpcaContextTimer::TimerContextStart() {
 	TimerStartPoint = chrono::steady_clock::now();
 }
@@ -164,7 +280,9 @@ cl_program SPCA_CORE_OPENCL::SpcaCreateProgram(cl_context context, cl_device_id
 }
 
 //  OpenCL ڴ.
-bool SPCA_CORE_OPENCL::SpcaCreateMemoryObjects(cl_context context, vector<SpcaDeviceMemoryObject>& mem_objects) {
+bool SPCA_CORE_OPENCL::SpcaCreateMemoryObjects(
+	cl_context context, vector<SpcaDeviceMemoryObject>& mem_objects, cl_mem_flags in_flags
+) {
 	int32_t OCLerrorCode = NULL;
 
 	auto MemoryObjectInfo = [&](const char* mode, size_t size, int32_t errorcode) {
@@ -181,11 +299,12 @@ bool SPCA_CORE_OPENCL::SpcaCreateMemoryObjects(cl_context context, vector<SpcaDe
 		if (mem_objects[i].MemoryModeType == SPCA_MEMOBJ_MODE_IN) {
 			// read_only memory.
 			mem_objects[i].MemoryObject = clCreateBuffer(
-				context, CL_MEM_READ_ONLY,
+				context, CL_MEM_READ_ONLY | in_flags,
 				mem_objects[i].MemorySizeBytes, nullptr,
 				&OCLerrorCode
 			);
 			MemoryObjectInfo("input", mem_objects[i].MemorySizeBytes, OCLerrorCode);
+			SpcaGetRuntimeMetrics().AllocBytes.Observe((double)mem_objects[i].MemorySizeBytes);
 		}
 		// create opencl: read_write mem, spca: read_only.
 		if (mem_objects[i].MemoryModeType == SPCA_MEMOBJ_MODE_OUT) {
@@ -196,30 +315,60 @@ bool SPCA_CORE_OPENCL::SpcaCreateMemoryObjects(cl_context context, vector<SpcaDe
 				&OCLerrorCode
 			);
 			MemoryObjectInfo("output", mem_objects[i].MemorySizeBytes, OCLerrorCode);
+			SpcaGetRuntimeMetrics().AllocBytes.Observe((double)mem_objects[i].MemorySizeBytes);
 		}
 	}
 	return SPCA_STATUS_SUCCESS;
 }
 
 
+// wait memory events => oper time(ms) => release events.
+void SPCA_CORE_OPENCL::SpcaMemoryEventsWait(vector<cl_event>& events, vector<double>* mem_times) {
+	if (events.empty()) return;
+	clWaitForEvents((cl_uint)events.size(), events.data());
+
+	for (cl_event& MemoryEvent : events) {
+		if (mem_times != nullptr) {
+			// opencl events => oper time.
+			cl_ulong TimeStart = NULL, TimeEnd = NULL;
+			clGetEventProfilingInfo(MemoryEvent, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &TimeStart, nullptr);
+			clGetEventProfilingInfo(MemoryEvent, CL_PROFILING_COMMAND_END,   sizeof(cl_ulong), &TimeEnd,   nullptr);
+			// calc memory oper time: ms.
+			mem_times->push_back(double(TimeEnd - TimeStart) * 1e-6);
+		}
+		clReleaseEvent(MemoryEvent);
+	}
+	events.clear();
+}
+
 //  OpenCL ݼ[matrix] (host => calc_device).
 bool SPCA_CORE_OPENCL::SpcaMemoryDatasetLoad(
 	cl_command_queue command, const vector<SpcaDeviceMemoryObject>& mem_objects,
 	vector<SpcaIndexMatrix<float>>& in_data, size_t& bytes,
-	vector<double>* mem_times
+	vector<double>* mem_times, vector<cl_event>* events
 ) {
+	SPCA_TRACE_SCOPE("dataset_load", "host");
 	size_t DatasetTotalSizeBytes = NULL;
 	size_t InDataCount = NULL;
+	// non-blocking uploads => one sync point.
+	vector<cl_event> MemoryEvents = {};
 
 	for (size_t i = NULL; i < mem_objects.size(); ++i) {
 		if (mem_objects[i].MemoryModeType == SPCA_MEMOBJ_MODE_IN) {
-			// memory_object != null, matrix_mode = 2d, matrix_data != empty.
+			// file => mapping uploaded, placeholder matrix.
+			if (mem_objects[i].MemoryPreloaded && mem_objects[i].MemoryObject != nullptr) {
+				++InDataCount;
+				continue;
+			}
+			// memory_object != null, matrix_mode = 2d | 3d(stack), matrix_data != empty.
 			if (mem_objects[i].MemoryObject == nullptr ||
-				in_data[InDataCount].GetIMatrixMode() != SPCA_TYPE_MATRIX2D ||
+				!(in_data[InDataCount].GetIMatrixMode() & (SPCA_TYPE_MATRIX2D | SPCA_TYPE_MATRIX3D)) ||
 				in_data[InDataCount].GetIMatrixRawData()->empty()
 				) {
 				PushLogger(LogError, ModuleTagOpenCL, "invaild mem_object, count: %u, (obj)count: %u",
 					InDataCount, i);
+				// queued uploads(source: in_data) => complete, release events.
+				SpcaMemoryEventsWait(MemoryEvents, nullptr);
 				return SPCA_STATUS_FAILED;
 			}
 
@@ -232,31 +381,28 @@ bool SPCA_CORE_OPENCL::SpcaMemoryDatasetLoad(
 				in_data[InDataCount].GetIMatrixRawData()->data(), // + offset_ptr
 				NULL, nullptr, &MemoryEvent
 			);
-			// ϴʱ. (host =upload=> calc device)
-			if (mem_times != nullptr) {
-				// opencl events => oper time.
-				cl_ulong TimeStart = NULL, TimeEnd = NULL;
-				clWaitForEvents(1, &MemoryEvent);
-
-				clGetEventProfilingInfo(MemoryEvent, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &TimeStart, nullptr);
-				clGetEventProfilingInfo(MemoryEvent, CL_PROFILING_COMMAND_END,   sizeof(cl_ulong), &TimeEnd,   nullptr);
-				// calc memory oper time: ms.
-				mem_times->push_back(double(TimeEnd - TimeStart) * 1e-6);
-			}
 			// check upload status code.
 			if (OCLerrorCode != CL_SUCCESS) {
 				// opencl loader error.
 				PushLogger(LogError, ModuleTagOpenCL, "loader opencl dataset, code: %i, (obj)count: %u",
 					OCLerrorCode, i);
+				SpcaMemoryEventsWait(MemoryEvents, nullptr);
 				return SPCA_STATUS_FAILED;
 			}
+			SpcaTraceEventCL(MemoryEvent, "write_buffer", mem_objects[i].MemorySizeBytes);
+			MemoryEvents.push_back(MemoryEvent);
 			// size_bytes count.
 			DatasetTotalSizeBytes += mem_objects[i].MemorySizeBytes;
 			++InDataCount;
 		}
 	}
-	PushLogger(LogTrace, ModuleTagOpenCL, "input dataset (total)size: %.4f mib",
+	if (events != nullptr)
+		events->insert(events->end(), MemoryEvents.begin(), MemoryEvents.end());
+	else
+		SpcaMemoryEventsWait(MemoryEvents, mem_times);
+	PSAG_LOGGER_DEFER(LogTrace, ModuleTagOpenCL, "input dataset (total)size: %.4f mib",
 		(double)DatasetTotalSizeBytes / 1048576.0);
+	SpcaGetRuntimeMetrics().WriteBytes.Add(DatasetTotalSizeBytes);
 	bytes = DatasetTotalSizeBytes;
 	return SPCA_STATUS_SUCCESS;
 }
@@ -265,10 +411,13 @@ bool SPCA_CORE_OPENCL::SpcaMemoryDatasetLoad(
 bool SPCA_CORE_OPENCL::SpcaMemoryDatasetRead(
 	cl_command_queue command, const vector<SpcaDeviceMemoryObject>& mem_objects,
 	vector<SpcaIndexMatrix<float>>& out_data, size_t& bytes,
-	vector<double>* mem_times
+	vector<double>* mem_times, vector<cl_event>* events
 ) {
+	SPCA_TRACE_SCOPE("dataset_read", "host");
 	size_t ReadDataTotalSizeBytes = NULL;
 	size_t OutDataCount = NULL;
+	// non-blocking downloads => one sync point.
+	vector<cl_event> MemoryEvents = {};
 
 	for (size_t i = NULL; i < mem_objects.size(); ++i) {
 		if (mem_objects[i].MemoryModeType == SPCA_MEMOBJ_MODE_OUT) {
@@ -276,11 +425,15 @@ bool SPCA_CORE_OPENCL::SpcaMemoryDatasetRead(
 			if (mem_objects[i].MemoryObject == nullptr) {
 				PushLogger(LogError, ModuleTagOpenCL, "reader opencl dataset, (data)count: %i, (obj)count: %i",
 					OutDataCount, i);
+				// queued downloads(target: out_data) => complete, release events.
+				SpcaMemoryEventsWait(MemoryEvents, nullptr);
 				return SPCA_STATUS_FAILED;
 			}
 			// reassign matrix.
 			out_data[OutDataCount].IMatrixFree();
-			out_data[OutDataCount].IMatrixAlloc(mem_objects[i].MatrixWidth, mem_objects[i].MatrixHeight);
+			out_data[OutDataCount].IMatrixAlloc(
+				mem_objects[i].MatrixWidth, mem_objects[i].MatrixHeight, mem_objects[i].MatrixDepth
+			);
 
 			cl_event MemoryEvent = nullptr;
 			int32_t OCLerrorCode = clEnqueueReadBuffer(
@@ -291,31 +444,28 @@ bool SPCA_CORE_OPENCL::SpcaMemoryDatasetRead(
 				out_data[OutDataCount].GetIMatrixRawData()->data(), // + offset_ptr
 				NULL, nullptr, &MemoryEvent
 			);
-			// ʱ. (calc device =download=> host)
-			if (mem_times != nullptr) {
-				// opencl events => oper time.
-				cl_ulong TimeStart = NULL, TimeEnd = NULL;
-				clWaitForEvents(1, &MemoryEvent);
-
-				clGetEventProfilingInfo(MemoryEvent, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &TimeStart, NULL);
-				clGetEventProfilingInfo(MemoryEvent, CL_PROFILING_COMMAND_END,   sizeof(cl_ulong), &TimeEnd,   NULL);
-				// calc memory oper time: ms.
-				mem_times->push_back(double(TimeEnd - TimeStart) * 1e-6);
-			}
 			// check download status code.
 			if (OCLerrorCode != CL_SUCCESS) {
 				// opencl loader error.
 				PushLogger(LogError, ModuleTagOpenCL, "reader opencl dataset, code: %i, (obj)count: %u",
 					OCLerrorCode, i);
+				SpcaMemoryEventsWait(MemoryEvents, nullptr);
 				return SPCA_STATUS_FAILED;
 			}
+			SpcaTraceEventCL(MemoryEvent, "read_buffer", mem_objects[i].MemorySizeBytes);
+			MemoryEvents.push_back(MemoryEvent);
 			// size_bytes count.
 			ReadDataTotalSizeBytes += mem_objects[i].MemorySizeBytes;
 			++OutDataCount;
 		}
 	}
-	PushLogger(LogTrace, ModuleTagOpenCL, "output dataset (total)size: %.4f mib",
+	if (events != nullptr)
+		events->insert(events->end(), MemoryEvents.begin(), MemoryEvents.end());
+	else
+		SpcaMemoryEventsWait(MemoryEvents, mem_times);
+	PSAG_LOGGER_DEFER(LogTrace, ModuleTagOpenCL, "output dataset (total)size: %.4f mib",
 		(double)ReadDataTotalSizeBytes / 1048576.0);
+	SpcaGetRuntimeMetrics().ReadBytes.Add(ReadDataTotalSizeBytes);
 	bytes = ReadDataTotalSizeBytes;
 	return SPCA_STATUS_SUCCESS;
 }
@@ -353,17 +503,29 @@ bool SPCA_CORE_OPENCL::SpcaSetKernelFuncParameters(cl_kernel kernel, const vecto
 namespace SpcaMatrixCalc {
 	namespace SpcaMatrixFilesys {
 
-		bool SpacFTmatrixFileGroupWrite(string group_folder, string group_name, SpcaIndexMatrix<float>& matrix_data) {
-			// convert: float_array => bin_bytes.
-			vector<uint8_t> OutBinBytes(matrix_data.GetIMatrixSizeBytes());
-
-			for (size_t i = 0; i < matrix_data.GetIMatrixRawData()->size(); ++i)
-				memcpy(&OutBinBytes[i * sizeof(float)], &(*matrix_data.GetIMatrixRawData())[i], sizeof(float));
+		bool SpacFTmatrixFileGroupWrite(
+			string group_folder, string group_name, SpcaIndexMatrix<float>& matrix_data, uint32_t write_flags
+		) {
+			// matrix storage => view, non-copy.
+			return SpacFTmatrixFileGroupWrite(group_folder, group_name, SpcaMatrixView<float>(matrix_data), write_flags);
+		}
 
+		bool SpacFTmatrixFileGroupWrite(
+			string group_folder, string group_name, const SpcaMatrixView<float>& matrix_view, uint32_t write_flags
+		) {
+			// mode: matrix3d.
+			if (matrix_view.GetIMatrixMode() != SPCA_TYPE_MATRIX3D) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed write matrix file_group, mode != 3d.");
+				return SPCA_STATUS_FAILED;
+			}
 			string FilepathTemp = group_folder + group_name + GROUP_FILEEXT_BIN;
-			FileLoaderBinary WriteBinaryFile;
-			if (!WriteBinaryFile.WriterBinaryFile(FilepathTemp, OutBinBytes)) {
-				// loader binary err: unable write.
+			// stream write: float_array => file chunks(non-copy).
+			FileStreamWriter WriteStreamFile;
+			if (!WriteStreamFile.OpenStreamFile(FilepathTemp, write_flags) ||
+				!WriteStreamFile.WriteStreamData(matrix_view.GetIMatrixViewData(), matrix_view.GetIMatrixSizeBytes()) ||
+				!WriteStreamFile.CloseStreamFile()
+			) {
+				// stream binary err: unable write.
 				PushLogger(LogError, MODULE_LABEL_TOOL, "failed write matrix file_group, no-path(wb).");
 				return SPCA_STATUS_FAILED;
 			}
@@ -372,17 +534,10 @@ namespace SpcaMatrixCalc {
 				chrono::steady_clock::now().time_since_epoch()
 			).count()) + " ";
 
-			// mode: matrix3d.
-			if (matrix_data.GetIMatrixMode() != SPCA_TYPE_MATRIX3D) {
-				PushLogger(LogError, MODULE_LABEL_TOOL, "failed write matrix file_group, mode != 3d.");
-				return SPCA_STATUS_FAILED;
-			}
-			else {
-				for (size_t i = 0; i < 3; ++i)
-					MatrixTimeParam += to_string(matrix_data.GetIMatrixDimParam(i)) + " ";
-				// matrix data filepath.
-				MatrixTimeParam += '\n' + FilepathTemp;
-			}
+			for (size_t i = 0; i < 3; ++i)
+				MatrixTimeParam += to_string(matrix_view.GetIMatrixDimParam(i)) + " ";
+			// matrix data filepath.
+			MatrixTimeParam += '\n' + FilepathTemp;
 
 			// write config(str) file.
 			FileLoaderString WriteConfigFile;
@@ -394,6 +549,33 @@ namespace SpcaMatrixCalc {
 			return SPCA_STATUS_SUCCESS;
 		}
 
+		// matrix file_group config => dim, data_path. failed: return 0.
+		static size_t MatrixFileGroupConfig(
+			const string& group_folder, const string& group_name, size_t* dim_param, string& data_path
+		) {
+			FileLoaderString ReadStringFile;
+			if (!ReadStringFile.ReadStringFile(group_folder + group_name + GROUP_FILEEXT_CFG)) {
+				// loader string err: unable read.
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file_group, no-path(rs).");
+				return NULL;
+			}
+			/* config format:
+			* time_code dim.x dim.x Dim.z
+			* matrix_srcdata_filepath
+			*/
+			string CfgInfoTemp = ReadStringFile.GetStringData();
+			stringstream ISS(CfgInfoTemp);
+
+			string DimParamTemp = {};
+			getline(ISS, DimParamTemp, '\n');
+			getline(ISS, data_path, '\n');
+
+			stringstream PARAM(DimParamTemp);
+			size_t TimeCode = NULL;
+			PARAM >> TimeCode >> dim_param[0] >> dim_param[1] >> dim_param[2];
+			return TimeCode;
+		}
+
 		size_t SpacFTmatrixFileGroupRead(string group_folder, string group_name, SpcaIndexMatrix<float>& matrix_data) {
 			// mode: matrix3d.
 			if (matrix_data.GetIMatrixMode() != SPCA_TYPE_MATRIX3D) {
@@ -404,49 +586,483 @@ namespace SpcaMatrixCalc {
 				if (matrix_data.GetIMatrixSizeBytes() > NULL)
 					matrix_data.IMatrixFree();
 
-				FileLoaderString ReadStringFile;
-				if (!ReadStringFile.ReadStringFile(group_folder + group_name + GROUP_FILEEXT_CFG)) {
-					// loader string err: unable read.
-					PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file_group, no-path(rs).");
+				FileMappingBinary MappingBinaryFile;
+				SpcaMatrixView<float> MatrixViewTemp = {};
+
+				size_t TimeCode = SpacFTmatrixFileGroupView(group_folder, group_name, MappingBinaryFile, MatrixViewTemp);
+				if (TimeCode == NULL) return NULL;
+
+				// convert: mapped pages => float_array, one bulk copy.
+				if (!MatrixViewTemp.IMatrixCopyTo(matrix_data)) {
+					PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file_group, alloc matrix.");
 					return NULL;
 				}
-				/* config format:
-				* time_code dim.x dim.x Dim.z
-				* matrix_srcdata_filepath
-				*/
-				string CfgInfoTemp = ReadStringFile.GetStringData();
-				stringstream ISS(CfgInfoTemp);
-
-				string DimParamTemp = {}, DataPathTemp = {};
-				getline(ISS, DimParamTemp, '\n');
-				getline(ISS, DataPathTemp, '\n');
-
-				stringstream PARAM(DimParamTemp);
-				size_t TimeCode = NULL, DimParam[3] = {};
-				PARAM >> TimeCode >> DimParam[0] >> DimParam[1] >> DimParam[2];
-				// write dim, alloc_mem.
-				matrix_data.IMatrixAlloc(DimParam[0], DimParam[1], DimParam[2]);
-
-				FileLoaderBinary ReadBinaryFile;
-				if (!ReadBinaryFile.ReadBinaryFile(DataPathTemp)) {
-					// loader binary err: unable read.
-					PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file_group, no-path(rb).");
-					return NULL;
+				return TimeCode;
+			}
+		}
+
+		size_t SpacFTmatrixFileGroupView(
+			string group_folder, string group_name, FileMappingBinary& mapping, SpcaMatrixView<float>& matrix_view
+		) {
+			size_t DimParam[3] = {};
+			string DataPathTemp = {};
+
+			size_t TimeCode = MatrixFileGroupConfig(group_folder, group_name, DimParam, DataPathTemp);
+			if (TimeCode == NULL) return NULL;
+
+			if (!mapping.MapBinaryFile(DataPathTemp)) {
+				// mapping binary err: unable read.
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file_group, no-path(rb).");
+				return NULL;
+			}
+			if (mapping.GetTotalSize() != DimParam[0] * DimParam[1] * DimParam[2] * sizeof(float)) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file_group, dim != data_len.");
+				mapping.UnmapBinaryFile();
+				return NULL;
+			}
+			// view => file pages(non-copy).
+			matrix_view = SpcaMatrixView<float>(
+				SPCA_TYPE_MATRIX3D, (const float*)mapping.GetMappingData(), DimParam[0], DimParam[1], DimParam[2]
+			);
+			return TimeCode;
+		}
+
+		// a * b => result, overflow(> SIZE_MAX): false.
+		static bool MatrixFileMulCheck(uint64_t a, uint64_t b, uint64_t& result) {
+			if (b != NULL && a > (uint64_t)SIZE_MAX / b) return false;
+			result = a * b;
+			return true;
+		}
+
+		// header => check fields & crc32c, failed: return false.
+		static bool MatrixFileHeaderCheck(const SpcaMatrixFileHeader& header, size_t file_size) {
+			if (header.MagicCode != SPCA_MATFILE_MAGIC) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, magic: %x", header.MagicCode);
+				return false;
+			}
+			// v1: header crc32c before encoding fields(layout changed), unsupported.
+			if (header.FormatVersion != SPCA_MATFILE_VERSION) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, unsupported version: %u(%u)", 
+					header.FormatVersion, SPCA_MATFILE_VERSION);
+				return false;
+			}
+			if (header.HeaderCRC32C != FileChecksumCRC32C(&header, offsetof(SpcaMatrixFileHeader, HeaderCRC32C))) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, header crc32c.");
+				return false;
+			}
+			if (header.DataType != SPCA_MATFILE_DTYPE_FP32) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, dtype: %u", header.DataType);
+				return false;
+			}
+			size_t DimsCount = NULL;
+			switch (header.MatrixMode) {
+			case(SPCA_TYPE_MATRIX1D): { DimsCount = 1; break; }
+			case(SPCA_TYPE_MATRIX2D): { DimsCount = 2; break; }
+			case(SPCA_TYPE_MATRIX3D): { DimsCount = 3; break; }
+			default:
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, mode: %u", header.MatrixMode);
+				return false;
+			}
+			// untrusted fields: dims product & payload range, overflow checked.
+			uint64_t MatrixBytes = sizeof(float);
+			bool RangeStatus = true;
+			for (size_t i = 0; i < DimsCount; ++i)
+				RangeStatus &= MatrixFileMulCheck(MatrixBytes, header.DimParam[i], MatrixBytes);
+
+			if (!RangeStatus || header.PayloadBytes != MatrixBytes || header.PayloadOffset % SPCA_MATFILE_ALIGN != NULL ||
+				header.PayloadOffset > file_size || header.StoredBytes > file_size - header.PayloadOffset
+			) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, dim != data_len.");
+				return false;
+			}
+			switch (header.PayloadEncoding) {
+			case(SPCA_MATFILE_ENCODING_RAW): {
+				if (header.StoredBytes == header.PayloadBytes) return true;
+				break;
+			}
+			case(SPCA_MATFILE_ENCODING_BLOCKLZ): {
+				// block count = payload / block(ceil).
+				if (header.BlockBytes > NULL &&
+					header.BlockCount == header.PayloadBytes / header.BlockBytes + (header.PayloadBytes % header.BlockBytes != NULL) &&
+					header.StoredBytes >= header.BlockCount * sizeof(SpcaMatrixFileBlock)
+				)
+					return true;
+				break;
+			}
+			}
+			PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, encoding: %u", header.PayloadEncoding);
+			return false;
+		}
+
+		// block table => check offsets(contiguous, stored range).
+		static bool MatrixFileReadTable(
+			FileStreamReader& reader, const SpcaMatrixFileHeader& header, vector<SpcaMatrixFileBlock>& table
+		) {
+			table.resize(header.BlockCount);
+			if (!reader.ReadStreamData(header.PayloadOffset, table.data(), table.size() * sizeof(SpcaMatrixFileBlock))) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, block table(rb).");
+				return false;
+			}
+			uint64_t BlockOffset = header.PayloadOffset + table.size() * sizeof(SpcaMatrixFileBlock);
+			for (const auto& Block : table) {
+				if (Block.BlockOffset != BlockOffset) break;
+				BlockOffset += Block.BlockBytes;
+			}
+			if (BlockOffset != header.PayloadOffset + header.StoredBytes) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, block table offsets.");
+				return false;
+			}
+			return true;
+		}
+
+		// payload => blocks(SPCA_MATFILE_BLOCK) => table + encoded, header: encoding fields.
+		static bool MatrixFileEncodeBlocks(
+			SpcaMatrixFileHeader& header, const uint8_t* data, vector<SpcaMatrixFileBlock>& table, 
+			vector<vector<uint8_t>>& blocks, SpcaTasks::ThreadTasks* codec_tasks
+		) {
+			size_t BlockCount = (size_t)((header.PayloadBytes + SPCA_MATFILE_BLOCK - 1) / SPCA_MATFILE_BLOCK);
+			table.assign(BlockCount, SpcaMatrixFileBlock());
+			blocks.resize(BlockCount);
+
+			auto BlockRawBytes = [&](size_t index) {
+				return min(SPCA_MATFILE_BLOCK, (size_t)header.PayloadBytes - index * SPCA_MATFILE_BLOCK);
+			};
+			bool EncodeStatus = true;
+			auto EncodeBlock = [&](size_t index) {
+				table[index].BlockFlags = SpcaCodec::BlockEncode(
+					data + index * SPCA_MATFILE_BLOCK, BlockRawBytes(index), sizeof(float), blocks[index]
+				);
+			};
+			if (codec_tasks == nullptr) {
+				for (size_t i = 0; i < BlockCount; ++i)
+					EncodeBlock(i);
+			}
+			else {
+				// one block per task, caller helps(worker of "codec_tasks": non-deadlock).
+				try {
+					codec_tasks->ParallelFor(0, BlockCount, EncodeBlock, 1);
+				}
+				catch (const exception& err) {
+					PushLogger(LogError, MODULE_LABEL_TOOL, "failed encode matrix blocks, tasks: %s", err.what());
+					EncodeStatus = false;
 				}
+			}
+			if (!EncodeStatus) return false;
 
-				auto BinDataTemp = ReadBinaryFile.GetBinaryData();
-				// convert: bin_bytes => float_array.
-				if (BinDataTemp.size() != DimParam[0] * DimParam[1] * DimParam[2] * sizeof(float)) {
-					PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file_group, dim != data_len.");
-					return NULL;
+			// offsets: block table => blocks(contiguous).
+			uint64_t BlockOffset = header.PayloadOffset + BlockCount * sizeof(SpcaMatrixFileBlock);
+			for (size_t i = 0; i < BlockCount; ++i) {
+				table[i].BlockOffset = BlockOffset;
+				table[i].BlockBytes  = (uint32_t)blocks[i].size();
+				BlockOffset += blocks[i].size();
+			}
+			header.PayloadEncoding = SPCA_MATFILE_ENCODING_BLOCKLZ;
+			header.BlockBytes  = (uint32_t)SPCA_MATFILE_BLOCK;
+			header.BlockCount  = (uint32_t)BlockCount;
+			header.StoredBytes = BlockOffset - header.PayloadOffset;
+
+			PushLogger(LogInfo, MODULE_LABEL_TOOL, "encode matrix blocks: %zu, ratio: %.3f", 
+				BlockCount, (double)header.PayloadBytes / (double)max(header.StoredBytes, (uint64_t)1));
+			return true;
+		}
+
+		// blocks[first, first + count): stored range one read => decode => data.
+		static bool MatrixFileDecodeBlocks(
+			FileStreamReader& reader, const SpcaMatrixFileHeader& header, const vector<SpcaMatrixFileBlock>& table,
+			size_t first, size_t count, uint8_t* data, SpcaTasks::ThreadTasks* codec_tasks
+		) {
+			if (count == NULL) return true;
+			uint64_t RangeBegin = table[first].BlockOffset;
+			uint64_t RangeEnd   = table[first + count - 1].BlockOffset + table[first + count - 1].BlockBytes;
+
+			vector<uint8_t> StoredData((size_t)(RangeEnd - RangeBegin));
+			if (!reader.ReadStreamData(RangeBegin, StoredData.data(), StoredData.size())) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, blocks(rb).");
+				return false;
+			}
+			auto BlockRawBytes = [&](size_t index) {
+				return (size_t)min((uint64_t)header.BlockBytes, header.PayloadBytes - (uint64_t)index * header.BlockBytes);
+			};
+			atomic<bool> DecodeStatus = true;
+			auto DecodeBlock = [&](size_t index) {
+				if (!SpcaCodec::BlockDecode(
+					StoredData.data() + (table[index].BlockOffset - RangeBegin), table[index].BlockBytes, table[index].BlockFlags,
+					sizeof(float), data + (index - first) * header.BlockBytes, BlockRawBytes(index)
+				))
+					DecodeStatus = false;
+			};
+			if (codec_tasks == nullptr) {
+				for (size_t i = first; i < first + count && DecodeStatus; ++i)
+					DecodeBlock(i);
+			}
+			else {
+				// one block per task, caller helps(worker of "codec_tasks": non-deadlock).
+				try {
+					codec_tasks->ParallelFor(first, first + count, DecodeBlock, 1);
 				}
-				else {
-					size_t FloatsLen = BinDataTemp.size() / sizeof(float);
-					for (size_t i = 0; i < FloatsLen; ++i)
-						memcpy(&(*matrix_data.GetIMatrixRawData())[i], &BinDataTemp[i * sizeof(float)], sizeof(float));
+				catch (const exception& err) {
+					PushLogger(LogError, MODULE_LABEL_TOOL, "failed decode matrix blocks, tasks: %s", err.what());
+					DecodeStatus = false;
 				}
-				return TimeCode;
 			}
+			if (!DecodeStatus)
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, corrupt block.");
+			return DecodeStatus.load();
+		}
+
+		// payload(offset) => data, raw: one read, blocklz: decode all blocks. + crc32c(flag).
+		static bool MatrixFileReadPayload(
+			FileStreamReader& reader, const SpcaMatrixFileHeader& header, void* data, SpcaTasks::ThreadTasks* codec_tasks
+		) {
+			if (header.PayloadEncoding == SPCA_MATFILE_ENCODING_BLOCKLZ) {
+				vector<SpcaMatrixFileBlock> BlocksTable = {};
+				if (!MatrixFileReadTable(reader, header, BlocksTable) ||
+					!MatrixFileDecodeBlocks(reader, header, BlocksTable, NULL, BlocksTable.size(), (uint8_t*)data, codec_tasks)
+				)
+					return false;
+			}
+			else if (!reader.ReadStreamData(header.PayloadOffset, data, (size_t)header.PayloadBytes)) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, payload(rb).");
+				return false;
+			}
+			if ((header.HeaderFlags & SPCA_MATFILE_CRC32C) && 
+				header.PayloadCRC32C != FileChecksumCRC32C(data, (size_t)header.PayloadBytes)
+			) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, payload crc32c.");
+				return false;
+			}
+			return true;
+		}
+
+		bool SpacFTmatrixFileWrite(
+			const string& filename, SpcaIndexMatrix<float>& matrix_data, uint32_t write_flags, SpcaTasks::ThreadTasks* codec_tasks
+		) {
+			// matrix storage => view, non-copy.
+			return SpacFTmatrixFileWrite(filename, SpcaMatrixView<float>(matrix_data), write_flags, codec_tasks);
+		}
+
+		bool SpacFTmatrixFileWrite(
+			const string& filename, const SpcaMatrixView<float>& matrix_view, uint32_t write_flags, SpcaTasks::ThreadTasks* codec_tasks
+		) {
+			if (matrix_view.GetIMatrixViewData() == nullptr) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed write matrix file, empty view.");
+				return SPCA_STATUS_FAILED;
+			}
+			SpcaMatrixFileHeader HeaderTemp = {};
+			HeaderTemp.MagicCode     = SPCA_MATFILE_MAGIC;
+			HeaderTemp.FormatVersion = SPCA_MATFILE_VERSION;
+			HeaderTemp.DataType      = SPCA_MATFILE_DTYPE_FP32;
+			HeaderTemp.MatrixMode    = matrix_view.GetIMatrixMode();
+
+			uint64_t DimX = matrix_view.GetIMatrixDimParam(0);
+			uint64_t DimY = matrix_view.GetIMatrixDimParam(1);
+			uint64_t DimZ = matrix_view.GetIMatrixDimParam(2);
+			// strides: index_matrix addressing(1d, 2d, 3d).
+			switch (HeaderTemp.MatrixMode) {
+			case(SPCA_TYPE_MATRIX1D): {
+				HeaderTemp.DimParam[0] = DimX;
+				HeaderTemp.DimStrides[0] = 1;
+				break;
+			}
+			case(SPCA_TYPE_MATRIX2D): {
+				HeaderTemp.DimParam[0] = DimX; HeaderTemp.DimParam[1] = DimY;
+				HeaderTemp.DimStrides[0] = DimY; HeaderTemp.DimStrides[1] = 1;
+				break;
+			}
+			case(SPCA_TYPE_MATRIX3D): {
+				HeaderTemp.DimParam[0] = DimX; HeaderTemp.DimParam[1] = DimY; HeaderTemp.DimParam[2] = DimZ;
+				HeaderTemp.DimStrides[0] = DimY * DimZ; HeaderTemp.DimStrides[1] = DimY; HeaderTemp.DimStrides[2] = 1;
+				break;
+			}
+			default:
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed write matrix file, mode: %u", HeaderTemp.MatrixMode);
+				return SPCA_STATUS_FAILED;
+			}
+			HeaderTemp.PayloadOffset = SPCA_MATFILE_ALIGN;
+			HeaderTemp.PayloadBytes  = matrix_view.GetIMatrixSizeBytes();
+			HeaderTemp.StoredBytes   = HeaderTemp.PayloadBytes;
+			HeaderTemp.TimeCode = (uint64_t)chrono::duration_cast<chrono::microseconds>(
+				chrono::steady_clock::now().time_since_epoch()
+			).count();
+
+			if (write_flags & SPCA_MATFILE_CRC32C) {
+				HeaderTemp.HeaderFlags |= SPCA_MATFILE_CRC32C;
+				HeaderTemp.PayloadCRC32C = FileChecksumCRC32C(matrix_view.GetIMatrixViewData(), (size_t)HeaderTemp.PayloadBytes);
+			}
+			vector<SpcaMatrixFileBlock> BlocksTable = {};
+			vector<vector<uint8_t>> BlocksEncoded = {};
+
+			if ((write_flags & SPCA_MATFILE_BLOCKLZ) && !MatrixFileEncodeBlocks(
+				HeaderTemp, (const uint8_t*)matrix_view.GetIMatrixViewData(), BlocksTable, BlocksEncoded, codec_tasks
+			))
+				return SPCA_STATUS_FAILED;
+			HeaderTemp.HeaderCRC32C = FileChecksumCRC32C(&HeaderTemp, offsetof(SpcaMatrixFileHeader, HeaderCRC32C));
+
+			// header block: header + zero padding => payload offset.
+			uint8_t HeaderBlock[SPCA_MATFILE_ALIGN] = {};
+			memcpy(HeaderBlock, &HeaderTemp, sizeof(SpcaMatrixFileHeader));
+
+			FileStreamWriter WriteStreamFile;
+			bool WriteStatus = WriteStreamFile.OpenStreamFile(filename, write_flags & (FILE_STREAM_DIRECT | FILE_STREAM_SYNC)) &&
+				WriteStreamFile.WriteStreamData(HeaderBlock, SPCA_MATFILE_ALIGN);
+
+			if (HeaderTemp.PayloadEncoding == SPCA_MATFILE_ENCODING_BLOCKLZ) {
+				// block table => blocks.
+				WriteStatus = WriteStatus && 
+					WriteStreamFile.WriteStreamData(BlocksTable.data(), BlocksTable.size() * sizeof(SpcaMatrixFileBlock));
+				for (const auto& Block : BlocksEncoded)
+					WriteStatus = WriteStatus && WriteStreamFile.WriteStreamData(Block.data(), Block.size());
+			}
+			else
+				WriteStatus = WriteStatus && 
+					WriteStreamFile.WriteStreamData(matrix_view.GetIMatrixViewData(), (size_t)HeaderTemp.PayloadBytes);
+
+			if (!WriteStatus || !WriteStreamFile.CloseStreamFile()) {
+				// stream binary err: unable write.
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed write matrix file, no-path(wb).");
+				return SPCA_STATUS_FAILED;
+			}
+			return SPCA_STATUS_SUCCESS;
+		}
+
+		bool SpacFTmatrixFileHeader(const string& filename, SpcaMatrixFileHeader& header) {
+			FileStreamReader ReadStreamFile;
+			if (!ReadStreamFile.OpenStreamFile(filename) ||
+				!ReadStreamFile.ReadStreamData(NULL, &header, sizeof(SpcaMatrixFileHeader))
+			) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, no-path(rb).");
+				return false;
+			}
+			return MatrixFileHeaderCheck(header, ReadStreamFile.GetTotalSize());
+		}
+
+		bool SpacFTmatrixFileReadTo(
+			const string& filename, const SpcaMatrixFileHeader& header, void* data, size_t bytes, 
+			SpcaTasks::ThreadTasks* codec_tasks
+		) {
+			if (data == nullptr || bytes < header.PayloadBytes) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, buffer < payload.");
+				return false;
+			}
+			FileStreamReader ReadStreamFile;
+			if (!ReadStreamFile.OpenStreamFile(filename)) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, no-path(rb).");
+				return false;
+			}
+			return MatrixFileReadPayload(ReadStreamFile, header, data, codec_tasks);
 		}
+
+		size_t SpacFTmatrixFileRead(
+			const string& filename, SpcaIndexMatrix<float>& matrix_data, SpcaTasks::ThreadTasks* codec_tasks
+		) {
+			FileStreamReader ReadStreamFile;
+			SpcaMatrixFileHeader HeaderTemp = {};
+
+			if (!ReadStreamFile.OpenStreamFile(filename) ||
+				!ReadStreamFile.ReadStreamData(NULL, &HeaderTemp, sizeof(SpcaMatrixFileHeader))
+			) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, no-path(rb).");
+				return NULL;
+			}
+			if (!MatrixFileHeaderCheck(HeaderTemp, ReadStreamFile.GetTotalSize())) return NULL;
+
+			if (matrix_data.GetIMatrixMode() != HeaderTemp.MatrixMode) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, mode != file mode.");
+				return NULL;
+			}
+			if (matrix_data.GetIMatrixSizeBytes() > NULL)
+				matrix_data.IMatrixFree();
+			if (!matrix_data.IMatrixAlloc(
+				(size_t)HeaderTemp.DimParam[0], (size_t)HeaderTemp.DimParam[1], (size_t)HeaderTemp.DimParam[2]
+			)) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, alloc matrix.");
+				return NULL;
+			}
+			// payload => matrix storage, non-parse.
+			if (!MatrixFileReadPayload(ReadStreamFile, HeaderTemp, matrix_data.GetIMatrixRawData()->data(), codec_tasks)) {
+				matrix_data.IMatrixFree();
+				return NULL;
+			}
+			return (size_t)HeaderTemp.TimeCode;
+		}
+
+		size_t SpacFTmatrixFileView(const string& filename, FileMappingBinary& mapping, SpcaMatrixView<float>& matrix_view) {
+			if (!mapping.MapBinaryFile(filename)) {
+				// mapping binary err: unable read.
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, no-path(rb).");
+				return NULL;
+			}
+			SpcaMatrixFileHeader HeaderTemp = {};
+			if (mapping.GetTotalSize() < sizeof(SpcaMatrixFileHeader)) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, size < header.");
+				mapping.UnmapBinaryFile();
+				return NULL;
+			}
+			memcpy(&HeaderTemp, mapping.GetMappingData(), sizeof(SpcaMatrixFileHeader));
+			// view: payload crc32c not verified(pages load on access).
+			if (!MatrixFileHeaderCheck(HeaderTemp, mapping.GetTotalSize())) {
+				mapping.UnmapBinaryFile();
+				return NULL;
+			}
+			if (HeaderTemp.PayloadEncoding != SPCA_MATFILE_ENCODING_RAW) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed view matrix file, encoding != raw.");
+				mapping.UnmapBinaryFile();
+				return NULL;
+			}
+			// view => file pages(non-copy), payload page aligned.
+			matrix_view = SpcaMatrixView<float>(
+				HeaderTemp.MatrixMode, (const float*)(mapping.GetMappingData() + HeaderTemp.PayloadOffset),
+				(size_t)HeaderTemp.DimParam[0], (size_t)HeaderTemp.DimParam[1], (size_t)HeaderTemp.DimParam[2]
+			);
+			return (size_t)HeaderTemp.TimeCode;
+		}
+	}
+
+	bool SpcaMatrixFileBlocks::OpenBlocksFile(const string& filename) {
+		BlocksTable.clear();
+		if (!BlocksReader.OpenStreamFile(filename) ||
+			!BlocksReader.ReadStreamData(NULL, &BlocksHeader, sizeof(SpcaMatrixFileHeader))
+		) {
+			PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix file, no-path(rb).");
+			return false;
+		}
+		if (!SpcaMatrixFilesys::MatrixFileHeaderCheck(BlocksHeader, BlocksReader.GetTotalSize()))
+			return false;
+
+		if (BlocksHeader.PayloadEncoding == SPCA_MATFILE_ENCODING_RAW) {
+			// raw: fixed blocks => range read.
+			BlocksHeader.BlockBytes = (uint32_t)SPCA_MATFILE_BLOCK;
+			BlocksHeader.BlockCount = (uint32_t)((BlocksHeader.PayloadBytes + SPCA_MATFILE_BLOCK - 1) / SPCA_MATFILE_BLOCK);
+			return true;
+		}
+		return SpcaMatrixFilesys::MatrixFileReadTable(BlocksReader, BlocksHeader, BlocksTable);
+	}
+
+	bool SpcaMatrixFileBlocks::ReadBlocks(
+		size_t first, size_t count, void* data, size_t bytes, SpcaTasks::ThreadTasks* codec_tasks
+	) {
+		size_t RangeBytes = GetBlocksRangeBytes(first, count);
+		if (first + count > BlocksHeader.BlockCount || data == nullptr || bytes < RangeBytes) {
+			PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix blocks, range: %zu + %zu", first, count);
+			return false;
+		}
+		if (BlocksHeader.PayloadEncoding == SPCA_MATFILE_ENCODING_RAW) {
+			if (!BlocksReader.ReadStreamData(BlocksHeader.PayloadOffset + first * BlocksHeader.BlockBytes, data, RangeBytes)) {
+				PushLogger(LogError, MODULE_LABEL_TOOL, "failed read matrix blocks, payload(rb).");
+				return false;
+			}
+			return true;
+		}
+		return SpcaMatrixFilesys::MatrixFileDecodeBlocks(
+			BlocksReader, BlocksHeader, BlocksTable, first, count, (uint8_t*)data, codec_tasks
+		);
+	}
+
+	size_t SpcaMatrixFileBlocks::GetBlocksRangeBytes(size_t first, size_t count) {
+		if (first >= BlocksHeader.BlockCount) return NULL;
+		count = min(count, (size_t)BlocksHeader.BlockCount - first);
+
+		uint64_t RangeEnd = min((uint64_t)(first + count) * BlocksHeader.BlockBytes, BlocksHeader.PayloadBytes);
+		return (size_t)(RangeEnd - (uint64_t)first * BlocksHeader.BlockBytes);
 	}
 }
\ No newline at end of file
@@ -7,10 +7,17 @@
 #define CL_TARGET_OPENCL_VERSION 300
 #include <CL/cl.h>
 #include <fstream>
+#include <memory>
+#include <unordered_map>
 
 #include "spca_system_tool/spca_tool_filesystem.h"
 #include "spca_system_tool/spca_tool_logger.hpp"
 #include "spca_system_tool/spca_tool_matrix.hpp"
+#include "spca_system_tool/spca_tool_sparse.hpp"
+#include "spca_system_tool/spca_tool_codec.h"
+#include "spca_system_tool/spca_tool_tracer.h"
+#include "spca_system_tool/spca_tool_metrics.h"
+#include "spca_thread_pool.hpp"
 
 StaticStrLABEL ModuleTagDevice    = "SPCA_DEVICE";
 StaticStrLABEL ModuleTagOpenCL    = "SPCA_OPENCL";
@@ -35,14 +42,39 @@ cl_int SpcaCLEnqueueNDRangeKernel(
 	const size_t* global_work_offset, const size_t* global_work_size, const size_t* local_work_size,
 	cl_uint num_events_in_wait_list, const cl_event*  event_wait_list, cl_event* event
 );
+// tracer enabled: event(complete) => queued, submit, start, end => device track spans.
+// device clock => host clock: queued = host time(after enqueue). [thread-safe]
+void SpcaTraceEventCL(cl_event event, const char* name, size_t bytes = 0, uint32_t queue_track = 0);
+// event(complete | error) => future(execution status), pool continuations: then, when_all.
+// callback thread(driver) => continuations short, invalid event => future exception.
+SpcaTasks::TaskFuture<cl_int> SpcaEventFutureCL(cl_event event);
+
+// runtime metrics(global registry), first use => register.
+struct SpcaRuntimeMetrics {
+	SpcaMetrics::Counter&   CalcJobs;
+	SpcaMetrics::Counter&   CalcFailed;
+	SpcaMetrics::Histogram& KernelTime;  // ms.
+
+	SpcaMetrics::Counter&   WriteBytes;  // host => device.
+	SpcaMetrics::Counter&   ReadBytes;   // device => host.
+	SpcaMetrics::Histogram& AllocBytes;  // mem_object size.
+
+	SpcaMetrics::Counter& LoaderRecycleHits;
+	SpcaMetrics::Counter& LoaderRecycleMisses;
+	SpcaMetrics::Counter& LoaderReadBytes;
+};
+SpcaRuntimeMetrics& SpcaGetRuntimeMetrics();
 
 // opencl device memory_object & attribute.
 struct SpcaDeviceMemoryObject {
 	int32_t MemoryModeType;
 
 	cl_mem MemoryObject;
-	size_t MatrixWidth, MatrixHeight;
+	// depth: matrix3d(batch stack), 0: matrix2d.
+	size_t MatrixWidth, MatrixHeight, MatrixDepth;
 	size_t MemorySizeBytes;
+	// true: uploaded(file => mapping), dataset load skip.
+	bool MemoryPreloaded;
 };
 
 // opencl calc_program resource.
@@ -117,18 +149,24 @@ protected:
 	cl_program       SpcaCreateProgram(cl_context context, cl_device_id device, bool is_path, std::string str);
 
 	// alloc gpgpu memory, set memory attribute. ( clCreateBuffer + clEnqueueWriteBuffer )
-	bool SpcaCreateMemoryObjects(cl_context context, std::vector<SpcaDeviceMemoryObject>& mem_objects);
-	// "in_data" matrix type = 2d. mem_obj mode = in.
+	// "in_flags": input ext flags, CL_MEM_ALLOC_HOST_PTR: host visible(mapping).
+	bool SpcaCreateMemoryObjects(
+		cl_context context, std::vector<SpcaDeviceMemoryObject>& mem_objects, cl_mem_flags in_flags = NULL
+	);
+	// wait all events(one sync point), mem_times != nullptr: profiling time(ms).
+	void SpcaMemoryEventsWait(std::vector<cl_event>& events, std::vector<double>* mem_times);
+	// "in_data" matrix type = 2d | 3d(stack). mem_obj mode = in.
+	// events != nullptr: non-wait, events => caller(release), "in_data" alive => complete.
 	bool SpcaMemoryDatasetLoad(
 		cl_command_queue command, const std::vector<SpcaDeviceMemoryObject>& mem_objects, 
 		std::vector<SpcaIndexMatrix<float>>& in_data, size_t& bytes, 
-		std::vector<double>* mem_times = nullptr
+		std::vector<double>* mem_times = nullptr, std::vector<cl_event>* events = nullptr
 	);
 	// "out_data" matrix type = 2d. mem_obj mode = out.
 	bool SpcaMemoryDatasetRead(
 		cl_command_queue command, const std::vector<SpcaDeviceMemoryObject>& mem_objects,
 		std::vector<SpcaIndexMatrix<float>>& out_data, size_t& bytes, 
-		std::vector<double>* mem_times = nullptr
+		std::vector<double>* mem_times = nullptr, std::vector<cl_event>* events = nullptr
 	);
 	// set (cl_script)function: in & out parameters.
 	bool SpcaSetKernelFuncParameters(cl_kernel kernel, const std::vector<SpcaDeviceMemoryObject>& mem_objects);
@@ -154,9 +192,18 @@ namespace SpcaMatrixCalc {
 
 		std::vector<SpcaIndexMatrix<float>> InputDataset = {};
 		size_t InputDatasetCount = NULL;
-
-		size_t WorkingGroupSize[2] 
-			= { WORKGROUP_DEFAULT, WORKGROUP_DEFAULT };
+		// input mem_objects ext flags.
+		cl_mem_flags InputMemoryFlags = NULL;
+
+		size_t WorkingGroupSize[3] 
+			= { WORKGROUP_DEFAULT, WORKGROUP_DEFAULT, 1 };
+
+		// global_size => ndrange(2d, 3d) => exe_task.
+		bool SpcaWriteMatrixCalcDims(uint32_t dims, const size_t* global_size);
+		// raw bytes => float32 container => dataset. (sparse index arrays)
+		bool SpcaPushBufferData(const void* data, size_t bytes);
+		// dataset count => (n)th input mem_object, check mode & size.
+		bool SpcaPushMatrixCheck(SpcaIndexMatrix<float>& matrix_data);
 	public:
 		~SpcaMatrix2Calc() {
 			SPCA_SYS_FREE_PROGRAM(ComputingResource);
@@ -165,7 +212,8 @@ namespace SpcaMatrixCalc {
 		// write_buffer => compute => read_buffer.
 		double SystemRunTotalTime = 0.0;
 
-		// cpu <=> calc_device io speed, mib/s, start(size > 128mib). 
+		// cpu <=> calc_device io speed, mib/s, last transfer(profiling).
+		// small transfers: latency bound, curves => "SpcaBenchmarkTransfer".
 		double SystemWriteBandwidth = 0.0;
 		double SystemReadBandwidth  = 0.0;
 
@@ -173,37 +221,358 @@ namespace SpcaMatrixCalc {
 		bool SpcaInitCalcSystem(ScriptModeTYPE mode, std::string cl_script_path, std::string function_name);
 
 		// 豸 matrix2d => [x,y].
-		void SpcaAllocWorkgroup(size_t x, size_t y);
+		void SpcaAllocWorkgroup(size_t x, size_t y, size_t z = 1);
 
 		// get device(s)_list.
 		std::vector<SpcaCalcDevice>* SpcaGetDevicesIndex();
 		// device_info =format=> string.
 		std::string SpcaGetDeviceInfo(SpcaCalcDevice device);
+		// device(index) => context, call before "SpcaInitCalcSystem".
 		void SpcaSetCalcDevice(size_t index);
 
 		//  set matrix2d x,y,mode.
 		void SpcaPushMatrixAttribute(size_t matrix_x, size_t matrix_y, IOModeTYPE mode);
+		// matrix3d stack: "matrix_z" matrix2d(x,y) items, item offset = z * x * y.
+		void SpcaPushMatrixAttribute(size_t matrix_x, size_t matrix_y, size_t matrix_z, IOModeTYPE mode);
+		// input mem_objects: alloc host ptr(pinned), call before "SpcaCreateMemoryOBJ".
+		void SpcaSetInputHostMapped(bool host_mapped);
 		// create(alloc) memory objects.
 		bool SpcaCreateMemoryOBJ();
+		// mem_objects(attributes) total bytes, in | out.
+		size_t SpcaGetMemoryBytes() const;
 
 		bool SpcaPushMatrixData(SpcaIndexMatrix<float>& matrix_data);
+		// move => dataset(non-copy), failed: "matrix_data" unchanged.
+		bool SpcaPushMatrixData(SpcaIndexMatrix<float>&& matrix_data);
+		// matrix file =read(chunks)=> mapped mem_object, chunk(n + 1) read || chunk(n) unmap.
+		// push order = attribute order, upload now(after "SpcaCreateMemoryOBJ").
+		bool SpcaPushMatrixFile(
+			const std::string& filename, size_t chunk_bytes = FILE_STREAM_CHUNK,
+			SpcaTasks::ThreadTasks* codec_tasks = nullptr
+		);
+
+		// ragged batch => mem_objects: packed data(mode), offsets table(in).
+		// kernel: item = get_global_id(2), table[item * 4]: offset, dim.x, dim.y.
+		void SpcaPushBatchAttribute(SpcaMatrixBatch<float>& batch, IOModeTYPE mode);
+		// mode in: packed data + offsets table, mode out: offsets table.
+		bool SpcaPushBatchData(SpcaMatrixBatch<float>& batch, IOModeTYPE mode);
+
+		// sparse csr => mem_objects(in): row_offsets, column_indices, values, params.
+		// params(uint): rows, cols, slice_c(csr: 0), dense_cols.
+		void SpcaPushSparseAttribute(SpcaSparseMatrixCSR<float>& matrix);
+		// sparse sell => mem_objects(in): slice_offsets, column_indices, values, row_permute, params.
+		void SpcaPushSparseAttribute(SpcaSparseMatrixSELL<float>& matrix);
+
+		// push order = attribute order, only non-zeros(+ sell padding) upload.
+		bool SpcaPushSparseData(SpcaSparseMatrixCSR<float>&  matrix, size_t dense_cols = 1);
+		bool SpcaPushSparseData(SpcaSparseMatrixSELL<float>& matrix, size_t dense_cols = 1);
 
 		// dataset(host) =write=> gpu memory => exe_task.
 		bool SpcaWriteMatrixCalc(size_t global_size_x, size_t global_size_y);
+		// batch: one 3d ndrange, "global_size_z" = stack depth | batch count.
+		bool SpcaWriteMatrixCalc(size_t global_size_x, size_t global_size_y, size_t global_size_z);
 		// gpu memory =read=> dataset(host).
 		std::vector<SpcaIndexMatrix<float>> SpcaReadMatrixResult();
+		// async stages(non-blocking, flushed) => events(caller release): wait | co_await | event future.
+		// write: dataset(host) => "dataset", alive => events complete.
+		bool SpcaAsyncWriteDataset(std::vector<SpcaIndexMatrix<float>>& dataset, std::vector<cl_event>& events);
+		// kernel(queue order: after writes), "global_size_z" = 0: 2d ndrange.
+		bool SpcaAsyncMatrixCalc(cl_event& event, size_t global_size_x, size_t global_size_y, size_t global_size_z = 0);
+		// result(host) valid => events complete.
+		bool SpcaAsyncReadResult(std::vector<SpcaIndexMatrix<float>>& result, std::vector<cl_event>& events);
+
+		// gpu memory =read(bands)=> file, band(n + 1) readback || band(n) write.
+		// "out_index": (n)th output matrix, flags: FILE_STREAM_DIRECT | FILE_STREAM_SYNC.
+		bool SpcaReadMatrixResultFile(
+			size_t out_index, const std::string& filename, 
+			size_t band_bytes = FILE_STREAM_CHUNK, uint32_t write_flags = NULL
+		);
+	};
+
+	// sparse matrix kernels, script: "SpcaSparseKernel::ScriptSparseMatrix".
+	// kernel parameters: [sparse mem_objects] + dense in + dense out.
+	namespace SpcaSparseKernel {
+		// "SpcaSpMVcsr":       y = A * x, global: (rows, 1).
+		// "SpcaSpMVcsrVector": y = A * x, global: (lanes, rows), workgroup: (lanes(pow2), n), lanes * n <= 256.
+		// "SpcaSpMVsell":      y = A * x, global: (rows, 1).
+		// "SpcaSpMMcsr":       C = A * B, global: (dense_cols, rows).
+		// "SpcaSpMMsell":      C = A * B, global: (dense_cols, rows).
+		extern const char* const ScriptSparseMatrix;
+
+		// global_size => multiple of work_group size.
+		inline size_t SpcaAlignGlobalSize(size_t size, size_t group) {
+			return group > NULL ? (size + group - 1) / group * group : size;
+		}
+	}
+
+	// matrix file(single): header + payload(offset aligned 4 kib), little-endian.
+#define SPCA_MATFILE_MAGIC   0x54414D53 // "SMAT"
+#define SPCA_MATFILE_VERSION 2 // v2: encoding fields, header crc32c at end.
+#define SPCA_MATFILE_ALIGN   4096
+
+#define SPCA_MATFILE_DTYPE_FP32 1
+// write flags(| FILE_STREAM_DIRECT | FILE_STREAM_SYNC): payload crc32c, block compressed.
+#define SPCA_MATFILE_CRC32C  ((uint32_t)1 << 8)
+#define SPCA_MATFILE_BLOCKLZ ((uint32_t)1 << 9)
+
+// payload encoding: raw floats, blocks(table + shuffle-delta lz).
+#define SPCA_MATFILE_ENCODING_RAW     0
+#define SPCA_MATFILE_ENCODING_BLOCKLZ 1
+// compressed block raw size(bytes), random access unit.
+#define SPCA_MATFILE_BLOCK (size_t)1048576
+
+	struct SpcaMatrixFileHeader {
+		uint32_t MagicCode;
+		uint32_t FormatVersion;
+		uint32_t DataType;
+		uint32_t MatrixMode; // SPCA_TYPE_MATRIX1D, 2D, 3D.
+
+		// dims(x,y,z) & strides(elements), unused: 0.
+		uint64_t DimParam[3];
+		uint64_t DimStrides[3];
+
+		uint64_t PayloadOffset;
+		uint64_t PayloadBytes;
+		uint64_t TimeCode;
+
+		uint32_t HeaderFlags;   // SPCA_MATFILE_CRC32C.
+		uint32_t PayloadCRC32C; // crc32c(raw payload).
+
+		// encoding blocklz: payload offset => block table => blocks.
+		uint32_t PayloadEncoding;
+		uint32_t BlockBytes;
+		uint64_t StoredBytes;   // payload bytes in file(raw: payload bytes).
+		uint32_t BlockCount;
+
+		uint32_t Reserved[2];
+		uint32_t HeaderCRC32C;  // crc32c(header bytes before this field).
+	};
+	static_assert(sizeof(SpcaMatrixFileHeader) == 128, "matrix file header != 128 bytes.");
+
+	// block table item, offset: file offset.
+	struct SpcaMatrixFileBlock {
+		uint64_t BlockOffset;
+		uint32_t BlockBytes;
+		uint32_t BlockFlags; // SPCA_CODEC_LZ | SPCA_CODEC_SHUFFLE, 0: raw.
+	};
+
+	// matrix file blocks random access, blocklz: decode range only. (raw: block = SPCA_MATFILE_BLOCK)
+	class SpcaMatrixFileBlocks {
+	protected:
+		FileStreamReader BlocksReader = {};
+
+		SpcaMatrixFileHeader BlocksHeader = {};
+		std::vector<SpcaMatrixFileBlock> BlocksTable = {};
+	public:
+		// header + block table, true:success, false:failed.
+		bool OpenBlocksFile(const std::string& filename);
+
+		// blocks[first, first + count) => data(raw), "bytes" >= range bytes.
+		// "codec_tasks" != nullptr: parallel decode.
+		bool ReadBlocks(
+			size_t first, size_t count, void* data, size_t bytes, 
+			SpcaTasks::ThreadTasks* codec_tasks = nullptr
+		);
+		// range raw bytes, last block: tail size.
+		size_t GetBlocksRangeBytes(size_t first, size_t count);
+
+		const SpcaMatrixFileHeader& GetBlocksHeader() { return BlocksHeader; }
+		size_t GetBlockCount() { return (size_t)BlocksHeader.BlockCount; }
+		size_t GetBlockBytes() { return (size_t)BlocksHeader.BlockBytes; }
 	};
 
 	namespace SpcaMatrixFilesys {
-		// write matrix file_group: matrix3d.
+		// write matrix file: matrix1d, 2d, 3d, stream write(non-copy).
+		// flags: FILE_STREAM_DIRECT | FILE_STREAM_SYNC | SPCA_MATFILE_CRC32C | SPCA_MATFILE_BLOCKLZ.
+		// "codec_tasks" != nullptr: blocks parallel encode.
+		bool SpacFTmatrixFileWrite(
+			const std::string& filename, SpcaIndexMatrix<float>& matrix_data, uint32_t write_flags = NULL,
+			SpcaTasks::ThreadTasks* codec_tasks = nullptr
+		);
+		bool SpacFTmatrixFileWrite(
+			const std::string& filename, const SpcaMatrixView<float>& matrix_view, uint32_t write_flags = NULL,
+			SpcaTasks::ThreadTasks* codec_tasks = nullptr
+		);
+
+		// read(check) header only, failed: return false.
+		bool SpacFTmatrixFileHeader(const std::string& filename, SpcaMatrixFileHeader& header);
+		// payload => "data"(staging, mapped device memory), raw: one read, size >= header.PayloadBytes.
+		bool SpacFTmatrixFileReadTo(
+			const std::string& filename, const SpcaMatrixFileHeader& header, void* data, size_t bytes,
+			SpcaTasks::ThreadTasks* codec_tasks = nullptr
+		);
+
+		// read matrix file: "matrix_data" mode == file mode. 
+		// success: return file_time_code, failed: return 0.
+		size_t SpacFTmatrixFileRead(
+			const std::string& filename, SpcaIndexMatrix<float>& matrix_data, 
+			SpcaTasks::ThreadTasks* codec_tasks = nullptr
+		);
+		// map matrix file(raw encoding): view => file pages(non-copy), "mapping" lifetime > view.
+		// success: return file_time_code, failed: return 0.
+		size_t SpacFTmatrixFileView(const std::string& filename, FileMappingBinary& mapping, SpcaMatrixView<float>& matrix_view);
+
+		// legacy file_group(.bin + .matcfg).
+		// write matrix file_group: matrix3d, stream write(non-copy).
+		// flags: FILE_STREAM_DIRECT | FILE_STREAM_SYNC.
 		bool SpacFTmatrixFileGroupWrite(
-			std::string group_folder, std::string group_name, SpcaIndexMatrix<float>& matrix_data
+			std::string group_folder, std::string group_name, SpcaIndexMatrix<float>& matrix_data,
+			uint32_t write_flags = NULL
+		);
+		bool SpacFTmatrixFileGroupWrite(
+			std::string group_folder, std::string group_name, const SpcaMatrixView<float>& matrix_view,
+			uint32_t write_flags = NULL
 		);
 		// read matrix file_group: matrix3d, success: return file_time_code, failed: return 0.
 		size_t SpacFTmatrixFileGroupRead(
 			std::string group_folder, std::string group_name, SpcaIndexMatrix<float>& matrix_data
 		);
+		// map matrix file_group: matrix3d, view => file pages(non-copy), "mapping" lifetime > view.
+		// success: return file_time_code, failed: return 0.
+		size_t SpacFTmatrixFileGroupView(
+			std::string group_folder, std::string group_name, FileMappingBinary& mapping, SpcaMatrixView<float>& matrix_view
+		);
 	}
+
+	// prefetch default memory budget(bytes): 1 gib.
+#define SPCA_PREFETCH_BUDGET ((size_t)1073741824)
+
+	// prefetched matrix file, storage recycled(loader).
+	struct SpcaPrefetchMatrix {
+		size_t      FileIndex;
+		std::string FileName;
+
+		SpcaIndexMatrix<float> MatrixData = SpcaIndexMatrix<float>(SPCA_TYPE_MATRIX1D);
+		// success: file_time_code, failed: 0.
+		size_t TimeCode;
+		// budget reserved bytes, reserve loader run.
+		size_t ReserveBytes;
+		size_t ReserveGeneration;
+	};
+
+	// loader sync & recycle state, matrix deleter(weak): loader freed => delete matrix.
+	struct SpcaPrefetchState {
+		std::mutex              LoaderMutex;
+		std::condition_variable LoaderCondition;
+
+		size_t PrefetchCount  = 2;
+		size_t InFlightBytes  = NULL;
+		bool   LoaderStopFlag = false;
+		// start loader => generation + 1.
+		size_t LoaderGeneration = NULL;
+
+		std::vector<std::unique_ptr<SpcaPrefetchMatrix>> RecycleMatrices = {};
+	};
+
+	// matrix files(single file format) async loader: io threads => prefetch next n files.
+	// backpressure: "prefetch_count" files ahead of consumer & memory budget.
+	class SpcaMatrixPrefetchLoader {
+	protected:
+		std::vector<std::string> LoaderFiles   = {};
+		std::vector<std::thread> LoaderWorkers = {};
+		SpcaTasks::ThreadTasks*  LoaderCodecTasks = nullptr;
+		// shared: popped matrices(deleter) may outlive loader.
+		std::shared_ptr<SpcaPrefetchState> LoaderState = std::make_shared<SpcaPrefetchState>();
+
+		size_t MemoryBudget = SPCA_PREFETCH_BUDGET;
+		// claim(load) => reserve(budget, file order) => pop(consumer). guard: state mutex.
+		size_t NextLoadIndex    = NULL;
+		size_t NextReserveIndex = NULL;
+		size_t NextPopIndex     = NULL;
+
+		std::unordered_map<size_t, std::unique_ptr<SpcaPrefetchMatrix>> ReadyMatrices = {};
+
+		void LoaderWorkerExecution();
+		static void RecycleMatrix(SpcaPrefetchState* state, SpcaPrefetchMatrix* matrix);
+	public:
+		~SpcaMatrixPrefetchLoader() { StopLoader(); };
+
+		// "codec_tasks" != nullptr: block compressed files parallel decode.
+		bool StartLoader(
+			const std::vector<std::string>& files, size_t prefetch_count = 2, size_t memory_budget = SPCA_PREFETCH_BUDGET,
+			uint32_t io_threads = 2, SpcaTasks::ThreadTasks* codec_tasks = nullptr
+		);
+		// file order, wait(loading), end | stop: nullptr.
+		// release(shared_ptr) => storage recycled, loader freed: matrix deleted.
+		std::shared_ptr<SpcaPrefetchMatrix> PopMatrix();
+		void StopLoader();
+
+		size_t GetInFlightBytes();
+		size_t GetReadyCount();
+	};
+
+	// matrix pack: header => entries(aligned 64 bytes) => index => trailer.
+	// index: [name_len(u32), name, entry] * count, read once(open).
+#define SPCA_MATPACK_MAGIC   0x4B415053 // "SPAK"
+#define SPCA_MATPACK_VERSION 1
+#define SPCA_MATPACK_ALIGN   64
+
+	struct SpcaMatrixPackEntry {
+		uint64_t DataOffset;
+		uint64_t DataBytes;
+		uint64_t DimParam[3];
+
+		uint32_t MatrixMode;
+		uint32_t DataType;   // SPCA_MATFILE_DTYPE_FP32.
+		uint32_t EntryFlags; // SPCA_MATFILE_CRC32C.
+		uint32_t DataCRC32C;
+	};
+	static_assert(sizeof(SpcaMatrixPackEntry) == 56, "matrix pack entry != 56 bytes.");
+
+	struct SpcaMatrixPackTrailer {
+		uint64_t IndexOffset;
+		uint64_t IndexBytes;
+		uint32_t EntryCount;
+		uint32_t IndexCRC32C;
+		uint32_t FormatVersion;
+		uint32_t MagicCode;
+	};
+
+	// append matrices => one file, close: write index + trailer.
+	class SpcaMatrixPackWriter {
+	protected:
+		FileStreamWriter PackWriter = {};
+		uint32_t PackFlags  = NULL;
+		uint64_t PackOffset = NULL;
+
+		std::vector<std::pair<std::string, SpcaMatrixPackEntry>> PackIndex = {};
+		std::unordered_map<std::string, size_t> PackNames = {};
+	public:
+		~SpcaMatrixPackWriter() { ClosePackFile(); };
+
+		// flags: FILE_STREAM_DIRECT | FILE_STREAM_SYNC | SPCA_MATFILE_CRC32C.
+		bool OpenPackFile(const std::string& filename, uint32_t write_flags = NULL);
+		// name unique, matrix1d, 2d, 3d.
+		bool PushPackMatrix(const std::string& name, SpcaIndexMatrix<float>& matrix_data);
+		bool PushPackMatrix(const std::string& name, const SpcaMatrixView<float>& matrix_view);
+		// index + trailer => close, not closed: pack invalid.
+		bool ClosePackFile();
+
+		size_t GetPackCount() { return PackIndex.size(); }
+	};
+
+	// pack index(memory) => matrix: one read | mapping slice.
+	class SpcaMatrixPackReader {
+	protected:
+		FileStreamReader  PackReader  = {};
+		FileMappingBinary PackMapping = {};
+
+		std::unordered_map<std::string, SpcaMatrixPackEntry> PackIndex = {};
+	public:
+		// "mapping" true: file mapping(view).
+		bool OpenPackFile(const std::string& filename, bool mapping = false);
+		void ClosePackFile();
+
+		// not found: nullptr.
+		const SpcaMatrixPackEntry* FindPackEntry(const std::string& name);
+		// "matrix_data" mode == entry mode, crc32c(flag) check.
+		bool ReadPackMatrix(const std::string& name, SpcaIndexMatrix<float>& matrix_data);
+		// mapping slice(non-copy), lifetime: reader open > view.
+		bool ViewPackMatrix(const std::string& name, SpcaMatrixView<float>& matrix_view);
+
+		std::vector<std::string> GetPackNames();
+		size_t GetPackCount() { return PackIndex.size(); }
+	};
 }
 
 #endif
\ No newline at end of file
@@ -41,17 +41,24 @@ namespace SpcaMatrixCalc {
 		return true;
 	}
 
-	void SpcaMatrix2Calc::SpcaAllocWorkgroup(size_t x, size_t y) {
-		if ((x <= 1) && (y <= 1)) {
+	void SpcaMatrix2Calc::SpcaAllocWorkgroup(size_t x, size_t y, size_t z) {
+		// group items(x * y * z) > 1, z-only groups: valid(batch items).
+		if (((x <= 1) && (y <= 1) && (z <= 1)) || x == NULL || y == NULL) {
 			PushLogger(LogWarning, ModuleTagOpenCL, "set work_group number > 1.");
 			return;
 		}
 		WorkingGroupSize[0] = x;
 		WorkingGroupSize[1] = y;
+		// 3d ndrange: batch items(z) per group.
+		WorkingGroupSize[2] = z > NULL ? z : 1;
 	}
 
 	// set(push) input_mem_objects & output_mem_objects.
 	void SpcaMatrix2Calc::SpcaPushMatrixAttribute(size_t matrix_x, size_t matrix_y, IOModeTYPE mode) {
+		SpcaPushMatrixAttribute(matrix_x, matrix_y, NULL, mode);
+	}
+
+	void SpcaMatrix2Calc::SpcaPushMatrixAttribute(size_t matrix_x, size_t matrix_y, size_t matrix_z, IOModeTYPE mode) {
 		SpcaDeviceMemoryObject MemoryObjAttribTemp = {};
 
 		switch (mode) {
@@ -60,9 +67,10 @@ namespace SpcaMatrixCalc {
 			MemoryObjAttribTemp.MemoryModeType = SPCA_MEMOBJ_MODE_OUT;
 			++ComputingOutMemObjCount; break; }
 		}
-		MemoryObjAttribTemp.MemorySizeBytes = FLOAT32_LENSIZE(matrix_x * matrix_y);
+		MemoryObjAttribTemp.MemorySizeBytes = FLOAT32_LENSIZE(matrix_x * matrix_y * max(matrix_z, (size_t)1));
 		MemoryObjAttribTemp.MatrixWidth     = matrix_x;
 		MemoryObjAttribTemp.MatrixHeight    = matrix_y;
+		MemoryObjAttribTemp.MatrixDepth     = matrix_z;
 		
 		if (MemoryObjAttribTemp.MemorySizeBytes == NULL)
 			PushLogger(LogWarning, ModuleTagOpenCL, "push(attrib) matrix_attribute size = 0.");
@@ -82,41 +90,238 @@ namespace SpcaMatrixCalc {
 
 	void SpcaMatrix2Calc::SpcaSetCalcDevice(size_t index) {
 		if (index < PlatformDevicesArray.size()) {
-			index = CalcDeviceIndexCode;
+			CalcDeviceIndexCode = index;
 			return;
 		}
 		PushLogger(LogWarning, ModuleTagOpenCL, "set platform_device, invalid device.");
 	}
 
+	void SpcaMatrix2Calc::SpcaSetInputHostMapped(bool host_mapped) {
+		InputMemoryFlags = host_mapped ? CL_MEM_ALLOC_HOST_PTR : NULL;
+	}
+
 	bool SpcaMatrix2Calc::SpcaCreateMemoryOBJ() {
 		// create memory_objects + set kernel parameters.
 		bool ReturnStatus =
-			SpcaCreateMemoryObjects(ComputingResource.ContextBind, ComputingResource.MemObjects) &&
+			SpcaCreateMemoryObjects(ComputingResource.ContextBind, ComputingResource.MemObjects, InputMemoryFlags) &&
 			SpcaSetKernelFuncParameters(ComputingResource.KernelFunction, ComputingResource.MemObjects);
 		return ReturnStatus;
 	}
 
-	// write matrix => matrix dataset.
-	bool SpcaMatrix2Calc::SpcaPushMatrixData(SpcaIndexMatrix<float>& matrix_data) {
-		if (InputDatasetCount >= ComputingResource.MemObjects.size()) {
+	size_t SpcaMatrix2Calc::SpcaGetMemoryBytes() const {
+		size_t MemoryBytes = NULL;
+		for (const auto& ObjectItem : ComputingResource.MemObjects)
+			MemoryBytes += ObjectItem.MemorySizeBytes;
+		return MemoryBytes;
+	}
+
+	bool SpcaMatrix2Calc::SpcaPushMatrixCheck(SpcaIndexMatrix<float>& matrix_data) {
+		// dataset count => (n)th input mem_object.
+		const SpcaDeviceMemoryObject* InMemoryObject = nullptr;
+		size_t InObjectCount = NULL;
+		for (const auto& ObjectItem : ComputingResource.MemObjects) {
+			if (ObjectItem.MemoryModeType != SPCA_MEMOBJ_MODE_IN) continue;
+			if (InObjectCount++ == InputDatasetCount) {
+				InMemoryObject = &ObjectItem;
+				break;
+			}
+		}
+		if (InMemoryObject == nullptr) {
 			PushLogger(LogError, ModuleTagOpenCL, "push(dataset) count > mem_objects.");
 			return false;
 		}
+		// attribute depth > 0: matrix3d(stack).
+		SpcaMatrixMode AttribMode = InMemoryObject->MatrixDepth > NULL ? SPCA_TYPE_MATRIX3D : SPCA_TYPE_MATRIX2D;
 		// error mode | size = 0.
-		if (matrix_data.GetIMatrixMode() != SPCA_TYPE_MATRIX2D || 
-			ComputingResource.MemObjects[InputDatasetCount].MemorySizeBytes != matrix_data.GetIMatrixSizeBytes()
+		if (matrix_data.GetIMatrixMode() != AttribMode || 
+			InMemoryObject->MemorySizeBytes != matrix_data.GetIMatrixSizeBytes()
 		) {
-			PushLogger(LogWarning, ModuleTagOpenCL, "push(dataset) mode != 2d | in_size != attrib_size.");
+			PushLogger(LogWarning, ModuleTagOpenCL, "push(dataset) mode != attrib_mode | in_size != attrib_size.");
 			return false;
 		}
+		return true;
+	}
+
+	// write matrix => matrix dataset.
+	bool SpcaMatrix2Calc::SpcaPushMatrixData(SpcaIndexMatrix<float>& matrix_data) {
+		if (!SpcaPushMatrixCheck(matrix_data)) return false;
 		InputDataset.push_back(matrix_data);
 		++InputDatasetCount;
 		return true;
 	}
 
+	bool SpcaMatrix2Calc::SpcaPushMatrixData(SpcaIndexMatrix<float>&& matrix_data) {
+		if (!SpcaPushMatrixCheck(matrix_data)) return false;
+		InputDataset.push_back(move(matrix_data));
+		++InputDatasetCount;
+		return true;
+	}
+
+	bool SpcaMatrix2Calc::SpcaPushMatrixFile(
+		const string& filename, size_t chunk_bytes, SpcaTasks::ThreadTasks* codec_tasks
+	) {
+		SPCA_TRACE_SCOPE("push_matrix_file", "host");
+		// dataset count => (n)th input mem_object.
+		SpcaDeviceMemoryObject* InMemoryObject = nullptr;
+		size_t InObjectCount = NULL;
+		for (auto& ObjectItem : ComputingResource.MemObjects) {
+			if (ObjectItem.MemoryModeType != SPCA_MEMOBJ_MODE_IN) continue;
+			if (InObjectCount++ == InputDatasetCount) {
+				InMemoryObject = &ObjectItem;
+				break;
+			}
+		}
+		if (InMemoryObject == nullptr || InMemoryObject->MemoryObject == nullptr) {
+			PushLogger(LogError, ModuleTagOpenCL, "push(file) count > mem_objects | mem_object == null.");
+			return false;
+		}
+		// mapping overwrites contents => preloaded only after upload complete, error returns: false.
+		InMemoryObject->MemoryPreloaded = false;
+		SpcaMatrixFileBlocks FileBlocks;
+		if (!FileBlocks.OpenBlocksFile(filename)) {
+			PushLogger(LogError, ModuleTagOpenCL, "push(file) failed open: %s", filename.c_str());
+			return false;
+		}
+		const SpcaMatrixFileHeader& FileHeader = FileBlocks.GetBlocksHeader();
+
+		SpcaMatrixMode AttribMode = InMemoryObject->MatrixDepth > NULL ? SPCA_TYPE_MATRIX3D : SPCA_TYPE_MATRIX2D;
+		if (FileHeader.MatrixMode != AttribMode || FileHeader.PayloadBytes != InMemoryObject->MemorySizeBytes) {
+			PushLogger(LogWarning, ModuleTagOpenCL, "push(file) mode != attrib_mode | in_size != attrib_size.");
+			return false;
+		}
+		// chunk => whole blocks(raw | encoded).
+		size_t ChunkBlocks = max(chunk_bytes / FileBlocks.GetBlockBytes(), (size_t)1);
+		size_t ChunkBytes  = ChunkBlocks * FileBlocks.GetBlockBytes();
+		size_t ChunksCount = (FileBlocks.GetBlockCount() + ChunkBlocks - 1) / ChunkBlocks;
+
+		// double mapping: chunk(n) = [n % 2].
+		void*    ChunkMapped[2] = {};
+		cl_event ChunkEvents[2] = {};
+
+		auto EnqueueChunkMap = [&](size_t chunk) {
+			int32_t OCLerrorCode = CL_SUCCESS;
+			// write invalidate: no device => host copy.
+			ChunkMapped[chunk % 2] = clEnqueueMapBuffer(
+				ComputingResource.CmdQueue, InMemoryObject->MemoryObject,
+				CL_FALSE, CL_MAP_WRITE_INVALIDATE_REGION,
+				chunk * ChunkBytes, FileBlocks.GetBlocksRangeBytes(chunk * ChunkBlocks, ChunkBlocks),
+				NULL, nullptr, &ChunkEvents[chunk % 2], &OCLerrorCode
+			);
+			if (OCLerrorCode == CL_SUCCESS)
+				SpcaTraceEventCL(ChunkEvents[chunk % 2], "map_buffer");
+			clFlush(ComputingResource.CmdQueue);
+			return OCLerrorCode;
+		};
+		vector<cl_event> UnmapEvents = {};
+		auto EnqueueChunkUnmap = [&](size_t chunk) {
+			cl_event UnmapEvent = nullptr;
+			int32_t OCLerrorCode = clEnqueueUnmapMemObject(
+				ComputingResource.CmdQueue, InMemoryObject->MemoryObject,
+				ChunkMapped[chunk % 2], NULL, nullptr, &UnmapEvent
+			);
+			if (OCLerrorCode == CL_SUCCESS) {
+				SpcaTraceEventCL(UnmapEvent, "unmap_buffer", FileBlocks.GetBlocksRangeBytes(chunk * ChunkBlocks, ChunkBlocks));
+				UnmapEvents.push_back(UnmapEvent);
+			}
+			clFlush(ComputingResource.CmdQueue);
+			return OCLerrorCode;
+		};
+
+		SpcaContextTimer PushTimer;
+		PushTimer.TimerContextStart();
+
+		uint32_t PayloadCRC32C = NULL;
+		bool ReadStatus = true;
+
+		int32_t OCLerrorCode = ChunksCount > NULL ? EnqueueChunkMap(0) : CL_SUCCESS;
+		for (size_t i = 0; i < ChunksCount && OCLerrorCode == CL_SUCCESS && ReadStatus; ++i) {
+			clWaitForEvents(1, &ChunkEvents[i % 2]);
+			clReleaseEvent(ChunkEvents[i % 2]);
+			// next chunk map => current chunk read.
+			if (i + 1 < ChunksCount)
+				OCLerrorCode = EnqueueChunkMap(i + 1);
+
+			size_t ChunkSizeBytes = FileBlocks.GetBlocksRangeBytes(i * ChunkBlocks, ChunkBlocks);
+			{
+				SPCA_TRACE_SCOPE("read_chunk", "file");
+				ReadStatus = FileBlocks.ReadBlocks(i * ChunkBlocks, ChunkBlocks, ChunkMapped[i % 2], ChunkSizeBytes, codec_tasks);
+			}
+			if (ReadStatus && (FileHeader.HeaderFlags & SPCA_MATFILE_CRC32C))
+				PayloadCRC32C = FileChecksumCRC32C(ChunkMapped[i % 2], ChunkSizeBytes, PayloadCRC32C);
+
+			// unmap(non-blocking) => chunk(n) transfer || chunk(n + 1) read.
+			int32_t UnmapCode = EnqueueChunkUnmap(i);
+			if (OCLerrorCode == CL_SUCCESS) OCLerrorCode = UnmapCode;
+
+			if ((!ReadStatus || OCLerrorCode != CL_SUCCESS) && i + 1 < ChunksCount && ChunkMapped[(i + 1) % 2] != nullptr) {
+				// queued map(next chunk) => release mapping.
+				clWaitForEvents(1, &ChunkEvents[(i + 1) % 2]);
+				clReleaseEvent(ChunkEvents[(i + 1) % 2]);
+				EnqueueChunkUnmap(i + 1);
+			}
+		}
+		vector<double> MemoryOperationTime = {};
+		SpcaMemoryEventsWait(UnmapEvents, &MemoryOperationTime);
+
+		if (OCLerrorCode != CL_SUCCESS) {
+			PushLogger(LogError, ModuleTagOpenCL, "push(file) opencl map chunk, code: %i", OCLerrorCode);
+			return false;
+		}
+		if (!ReadStatus) {
+			PushLogger(LogError, ModuleTagOpenCL, "push(file) failed read chunk: %s", filename.c_str());
+			return false;
+		}
+		if ((FileHeader.HeaderFlags & SPCA_MATFILE_CRC32C) && PayloadCRC32C != FileHeader.PayloadCRC32C) {
+			PushLogger(LogError, ModuleTagOpenCL, "push(file) payload crc32c mismatch: %s", filename.c_str());
+			return false;
+		}
+		SpcaGetRuntimeMetrics().WriteBytes.Add(InMemoryObject->MemorySizeBytes);
+		// uploaded => placeholder(dataset order).
+		InMemoryObject->MemoryPreloaded = true;
+		InputDataset.push_back(SpcaIndexMatrix<float>(AttribMode));
+		++InputDatasetCount;
+
+		double TotalTime = PushTimer.TimerContextEnd();
+		PushLogger(LogTrace, ModuleTagOpenCL, "push(file) chunks: %zu, size: %.4f mib, time: %.3f ms",
+			ChunksCount, (double)InMemoryObject->MemorySizeBytes / 1048576.0, TotalTime);
+		return true;
+	}
+
+	void SpcaMatrix2Calc::SpcaPushBatchAttribute(SpcaMatrixBatch<float>& batch, IOModeTYPE mode) {
+		// packed data: matrix2d(total, 1), offsets table: uint32(4 * count, 1).
+		SpcaPushMatrixAttribute(max(batch.GetBatchPackedData()->size(), (size_t)1), 1, mode);
+		SpcaPushMatrixAttribute(max(batch.GetBatchOffsetsTable()->size(), (size_t)1), 1, WRITE_ONLY_MATRIX);
+
+		PushLogger(LogInfo, ModuleTagOpenCL, "push(attrib) matrix batch, count: %zu, max: %zu x %zu",
+			batch.GetBatchCount(), batch.GetBatchMaxDimParam(0), batch.GetBatchMaxDimParam(1));
+	}
+
+	bool SpcaMatrix2Calc::SpcaPushBatchData(SpcaMatrixBatch<float>& batch, IOModeTYPE mode) {
+		if (mode == WRITE_ONLY_MATRIX && !SpcaPushBufferData(
+			batch.GetBatchPackedData()->data(), batch.GetBatchPackedData()->size() * sizeof(float))
+		) {
+			PushLogger(LogError, ModuleTagOpenCL, "push(dataset) batch data != attribute.");
+			return false;
+		}
+		return SpcaPushBufferData(
+			batch.GetBatchOffsetsTable()->data(), batch.GetBatchOffsetsTable()->size() * sizeof(uint32_t)
+		);
+	}
+
 	// global_size: opencl kernel clac_cycles.
 	// data(host) => gpu memory => calc.
 	bool SpcaMatrix2Calc::SpcaWriteMatrixCalc(size_t global_size_x, size_t global_size_y) {
+		size_t MatrixNumber[2] = { global_size_x, global_size_y };
+		return SpcaWriteMatrixCalcDims(2, MatrixNumber);
+	}
+
+	bool SpcaMatrix2Calc::SpcaWriteMatrixCalc(size_t global_size_x, size_t global_size_y, size_t global_size_z) {
+		size_t MatrixNumber[3] = { global_size_x, global_size_y, global_size_z };
+		return SpcaWriteMatrixCalcDims(3, MatrixNumber);
+	}
+
+	bool SpcaMatrix2Calc::SpcaWriteMatrixCalcDims(uint32_t dims, const size_t* global_size) {
+		SPCA_TRACE_SCOPE("write_matrix_calc", "host");
 		size_t WriteDatasetSizeBytes = NULL;
 
 		// host upload data time.
@@ -131,8 +336,14 @@ namespace SpcaMatrixCalc {
 		)) {
 			// err: mem_object == null || matrix.mode != 2d || matrix.data == null.
 			PushLogger(LogError, ModuleTagOpenCL, "failed write calc_device dataset.");
+			// failed write: preloaded(file) flags => reset, re-push.
+			for (auto& ObjectItem : ComputingResource.MemObjects)
+				ObjectItem.MemoryPreloaded = false;
 			return false;
 		}
+		// preloaded(file) => next push.
+		for (auto& ObjectItem : ComputingResource.MemObjects)
+			ObjectItem.MemoryPreloaded = false;
 		// free cache data.
 		InputDataset.clear();
 		InputDataset.shrink_to_fit();
@@ -141,19 +352,18 @@ namespace SpcaMatrixCalc {
 		double MemTotalTime = 0.0;
 		for (auto Time : MemoryOperationTime)
 			MemTotalTime += Time;
-		// calc write mem speed, size > 128mib.
+		// calc write mem speed(all sizes).
 		double SizeMiB = double(WriteDatasetSizeBytes) / 1048576.0;
-		if (SizeMiB > 128.0) SystemWriteBandwidth = SizeMiB / MemTotalTime * 1000.0;
-
-		size_t MatrixNumber[2] = { global_size_x, global_size_y };
+		if (MemTotalTime > 0.0) SystemWriteBandwidth = SizeMiB / MemTotalTime * 1000.0;
 
 		cl_event RunEvent = nullptr;
-		// [OpenCL API]: Task => Queue, CALC(2D).
+		// [OpenCL API]: Task => Queue, CALC(2D, 3D).
 		int32_t OCLerrorCode = SpcaCLEnqueueNDRangeKernel(
 			ComputingResource.CmdQueue, ComputingResource.KernelFunction,
-			2, NULL, MatrixNumber, WorkingGroupSize, 
+			dims, NULL, global_size, WorkingGroupSize, 
 			NULL, nullptr, &RunEvent
 		);
+		SpcaTraceEventCL(RunEvent, "ndrange_kernel");
 		clWaitForEvents(1, &RunEvent);
 		// opencl events => run calc time.
 		cl_ulong TimeStart = NULL, TimeEnd = NULL;
@@ -164,12 +374,15 @@ namespace SpcaMatrixCalc {
 
 		// opencl failed execution.
 		if (OCLerrorCode != CL_SUCCESS) {
+			SpcaGetRuntimeMetrics().CalcFailed.Add();
 			// write execution error.
 			PushLogger(LogError, ModuleTagOpenCL, "push(add) execution_queue, code: %i", OCLerrorCode);
 			// err => free resources.
 			SPCA_SYS_FREE_PROGRAM(ComputingResource);
 			return false;
 		}
+		SpcaGetRuntimeMetrics().CalcJobs.Add();
+		SpcaGetRuntimeMetrics().KernelTime.Observe(SystemRunTotalTime);
 		// clear count.
 		InputDatasetCount = NULL;
 		return true;
@@ -177,12 +390,16 @@ namespace SpcaMatrixCalc {
 
 	// gpu memory => data(host).
 	vector<SpcaIndexMatrix<float>> SpcaMatrix2Calc::SpcaReadMatrixResult() {
+		SPCA_TRACE_SCOPE("read_matrix_result", "host");
 		size_t WriteDatasetSizeBytes = NULL;
-		// clac result dataset temp.
-		vector<SpcaIndexMatrix<float>> ReturnMatrix(
-			ComputingOutMemObjCount, 
-			SpcaIndexMatrix<float>(SPCA_TYPE_MATRIX2D)
-		);
+		// clac result dataset temp, attribute depth > 0: matrix3d.
+		vector<SpcaIndexMatrix<float>> ReturnMatrix = {};
+		for (const auto& ObjectItem : ComputingResource.MemObjects) {
+			if (ObjectItem.MemoryModeType != SPCA_MEMOBJ_MODE_OUT) continue;
+			ReturnMatrix.push_back(SpcaIndexMatrix<float>(
+				ObjectItem.MatrixDepth > NULL ? SPCA_TYPE_MATRIX3D : SPCA_TYPE_MATRIX2D
+			));
+		}
 
 		// host download data time.
 		vector<double> MemoryOperationTime = {};
@@ -204,11 +421,174 @@ namespace SpcaMatrixCalc {
 		double MemTotalTime = 0.0;
 		for (auto Time : MemoryOperationTime)
 			MemTotalTime += Time;
-		// calc read speed, size > 128mib.
+		// calc read speed(all sizes).
 		double SizeMiB = double(WriteDatasetSizeBytes) / 1048576.0;
-		if (SizeMiB > 128.0) SystemReadBandwidth = SizeMiB / MemTotalTime * 1000.0;
+		if (MemTotalTime > 0.0) SystemReadBandwidth = SizeMiB / MemTotalTime * 1000.0;
 
 		// return calc result matrix.
 		return ReturnMatrix;
 	}
+
+	bool SpcaMatrix2Calc::SpcaAsyncWriteDataset(vector<SpcaIndexMatrix<float>>& dataset, vector<cl_event>& events) {
+		SPCA_TRACE_SCOPE("async_write_dataset", "host");
+		size_t WriteDatasetSizeBytes = NULL;
+		if (!SpcaMemoryDatasetLoad(
+			ComputingResource.CmdQueue,
+			ComputingResource.MemObjects,
+			InputDataset,
+			WriteDatasetSizeBytes,
+			nullptr, &events
+		)) {
+			PushLogger(LogError, ModuleTagOpenCL, "failed write(async) calc_device dataset.");
+			for (auto& ObjectItem : ComputingResource.MemObjects)
+				ObjectItem.MemoryPreloaded = false;
+			return false;
+		}
+		for (auto& ObjectItem : ComputingResource.MemObjects)
+			ObjectItem.MemoryPreloaded = false;
+		// host dataset => caller(non-blocking writes source).
+		dataset = move(InputDataset);
+		InputDataset.clear();
+		// submit: callbacks(events) fire only after flush.
+		clFlush(ComputingResource.CmdQueue);
+		return true;
+	}
+
+	bool SpcaMatrix2Calc::SpcaAsyncMatrixCalc(cl_event& event, size_t global_size_x, size_t global_size_y, size_t global_size_z) {
+		size_t MatrixNumber[3] = { global_size_x, global_size_y, global_size_z };
+		event = nullptr;
+		// [OpenCL API]: Task => Queue, CALC(2D, 3D).
+		int32_t OCLerrorCode = SpcaCLEnqueueNDRangeKernel(
+			ComputingResource.CmdQueue, ComputingResource.KernelFunction,
+			global_size_z == NULL ? 2 : 3, NULL, MatrixNumber, WorkingGroupSize,
+			NULL, nullptr, &event
+		);
+		if (OCLerrorCode != CL_SUCCESS) {
+			SpcaGetRuntimeMetrics().CalcFailed.Add();
+			PushLogger(LogError, ModuleTagOpenCL, "push(add, async) execution_queue, code: %i", OCLerrorCode);
+			SPCA_SYS_FREE_PROGRAM(ComputingResource);
+			return false;
+		}
+		SpcaTraceEventCL(event, "ndrange_kernel");
+		clFlush(ComputingResource.CmdQueue);
+
+		SpcaGetRuntimeMetrics().CalcJobs.Add();
+		InputDatasetCount = NULL;
+		return true;
+	}
+
+	bool SpcaMatrix2Calc::SpcaAsyncReadResult(vector<SpcaIndexMatrix<float>>& result, vector<cl_event>& events) {
+		SPCA_TRACE_SCOPE("async_read_result", "host");
+		size_t ReadDatasetSizeBytes = NULL;
+		result.clear();
+		for (const auto& ObjectItem : ComputingResource.MemObjects) {
+			if (ObjectItem.MemoryModeType != SPCA_MEMOBJ_MODE_OUT) continue;
+			result.push_back(SpcaIndexMatrix<float>(
+				ObjectItem.MatrixDepth > NULL ? SPCA_TYPE_MATRIX3D : SPCA_TYPE_MATRIX2D
+			));
+		}
+		if (!SpcaMemoryDatasetRead(
+			ComputingResource.CmdQueue,
+			ComputingResource.MemObjects,
+			result,
+			ReadDatasetSizeBytes,
+			nullptr, &events
+		)) {
+			PushLogger(LogError, ModuleTagOpenCL, "failed read(async) calc_device dataset.");
+			result.clear();
+			return false;
+		}
+		clFlush(ComputingResource.CmdQueue);
+		return true;
+	}
+
+	bool SpcaMatrix2Calc::SpcaReadMatrixResultFile(
+		size_t out_index, const string& filename, size_t band_bytes, uint32_t write_flags
+	) {
+		SPCA_TRACE_SCOPE("read_matrix_file", "host");
+		// out_index => (n)th output mem_object.
+		const SpcaDeviceMemoryObject* OutMemoryObject = nullptr;
+		size_t OutObjectCount = NULL;
+		for (const auto& ObjectItem : ComputingResource.MemObjects) {
+			if (ObjectItem.MemoryModeType != SPCA_MEMOBJ_MODE_OUT) continue;
+			if (OutObjectCount++ == out_index) {
+				OutMemoryObject = &ObjectItem;
+				break;
+			}
+		}
+		if (OutMemoryObject == nullptr || OutMemoryObject->MemoryObject == nullptr) {
+			PushLogger(LogError, ModuleTagOpenCL, "read(file) invalid out_index: %zu", out_index);
+			return false;
+		}
+		FileStreamWriter WriteStreamFile;
+		if (!WriteStreamFile.OpenStreamFile(filename, write_flags)) {
+			PushLogger(LogError, ModuleTagOpenCL, "read(file) failed open: %s", filename.c_str());
+			return false;
+		}
+		// band size => multiple of stream alignment.
+		band_bytes = max((band_bytes + FILE_STREAM_ALIGN - 1) / FILE_STREAM_ALIGN, (size_t)1) * FILE_STREAM_ALIGN;
+
+		size_t TotalBytes = OutMemoryObject->MemorySizeBytes;
+		size_t BandsCount = (TotalBytes + band_bytes - 1) / band_bytes;
+
+		// double buffering: band(n) host buffer = [n % 2].
+		vector<uint8_t> BandBuffers[2] = {
+			vector<uint8_t>(min(band_bytes, TotalBytes)), vector<uint8_t>(min(band_bytes, TotalBytes))
+		};
+		cl_event BandEvents[2] = {};
+
+		auto BandSizeBytes = [&](size_t band) { return min(band_bytes, TotalBytes - band * band_bytes); };
+		auto EnqueueBandRead = [&](size_t band) {
+			int32_t OCLerrorCode = clEnqueueReadBuffer(
+				ComputingResource.CmdQueue, OutMemoryObject->MemoryObject,
+				CL_FALSE, band * band_bytes, BandSizeBytes(band),
+				BandBuffers[band % 2].data(),
+				NULL, nullptr, &BandEvents[band % 2]
+			);
+			if (OCLerrorCode == CL_SUCCESS)
+				SpcaTraceEventCL(BandEvents[band % 2], "read_band", BandSizeBytes(band));
+			clFlush(ComputingResource.CmdQueue);
+			return OCLerrorCode;
+		};
+
+		SpcaContextTimer ReadTimer;
+		ReadTimer.TimerContextStart();
+
+		int32_t OCLerrorCode = BandsCount > NULL ? EnqueueBandRead(0) : CL_SUCCESS;
+		for (size_t i = 0; i < BandsCount && OCLerrorCode == CL_SUCCESS; ++i) {
+			clWaitForEvents(1, &BandEvents[i % 2]);
+			clReleaseEvent(BandEvents[i % 2]);
+			// next band readback => current band write.
+			if (i + 1 < BandsCount)
+				OCLerrorCode = EnqueueBandRead(i + 1);
+
+			bool WriteStatus = false;
+			{
+				SPCA_TRACE_SCOPE("write_band", "file");
+				WriteStatus = WriteStreamFile.WriteStreamData(BandBuffers[i % 2].data(), BandSizeBytes(i));
+			}
+			if (!WriteStatus) {
+				PushLogger(LogError, ModuleTagOpenCL, "read(file) failed write band: %zu", i);
+				// wait queued band(buffer in use).
+				if (i + 1 < BandsCount && OCLerrorCode == CL_SUCCESS) {
+					clWaitForEvents(1, &BandEvents[(i + 1) % 2]);
+					clReleaseEvent(BandEvents[(i + 1) % 2]);
+				}
+				return false;
+			}
+		}
+		if (OCLerrorCode != CL_SUCCESS) {
+			PushLogger(LogError, ModuleTagOpenCL, "read(file) opencl read band, code: %i", OCLerrorCode);
+			return false;
+		}
+		if (!WriteStreamFile.CloseStreamFile()) {
+			PushLogger(LogError, ModuleTagOpenCL, "read(file) failed close(sync): %s", filename.c_str());
+			return false;
+		}
+		SpcaGetRuntimeMetrics().ReadBytes.Add(TotalBytes);
+		double TotalTime = ReadTimer.TimerContextEnd();
+		PushLogger(LogTrace, ModuleTagOpenCL, "read(file) bands: %zu, size: %.4f mib, time: %.3f ms",
+			BandsCount, (double)TotalBytes / 1048576.0, TotalTime);
+		return true;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,193 @@
+// spca_opencl_loader.
+#include "spca_opencl.h"
+
+using namespace std;
+using namespace PSAG_LOGGER;
+
+#define MODULE_LABEL_LOADER "SPCA_LOADER"
+
+namespace SpcaMatrixCalc {
+	void SpcaMatrixPrefetchLoader::LoaderWorkerExecution() {
+		while (true) {
+			size_t FileIndex = NULL;
+			{
+				unique_lock<mutex> Lock(LoaderState->LoaderMutex);
+				// prefetch window: files[pop, pop + count).
+				LoaderState->LoaderCondition.wait(Lock, [this] {
+					return LoaderState->LoaderStopFlag || NextLoadIndex >= LoaderFiles.size() ||
+						NextLoadIndex < NextPopIndex + LoaderState->PrefetchCount;
+				});
+				if (LoaderState->LoaderStopFlag || NextLoadIndex >= LoaderFiles.size())
+					break;
+				FileIndex = NextLoadIndex++;
+			}
+			// header => payload bytes(reserve).
+			SpcaMatrixFileHeader HeaderTemp = {};
+			bool HeaderStatus = SpcaMatrixFilesys::SpacFTmatrixFileHeader(LoaderFiles[FileIndex], HeaderTemp);
+			size_t ReserveBytes = HeaderStatus ? (size_t)HeaderTemp.PayloadBytes : NULL;
+			size_t ReserveGeneration = NULL;
+
+			unique_ptr<SpcaPrefetchMatrix> MatrixItem = nullptr;
+			{
+				unique_lock<mutex> Lock(LoaderState->LoaderMutex);
+				// reserve in file order, consumer waiting file: over budget allowed.
+				LoaderState->LoaderCondition.wait(Lock, [&] {
+					return LoaderState->LoaderStopFlag || (NextReserveIndex == FileIndex && (
+						LoaderState->InFlightBytes == NULL || LoaderState->InFlightBytes + ReserveBytes <= MemoryBudget ||
+						FileIndex == NextPopIndex
+					));
+				});
+				if (LoaderState->LoaderStopFlag) break;
+				LoaderState->InFlightBytes += ReserveBytes;
+				ReserveGeneration = LoaderState->LoaderGeneration;
+				++NextReserveIndex;
+
+				// recycled matrix(same mode) => reuse storage.
+				for (auto it = LoaderState->RecycleMatrices.begin(); it != LoaderState->RecycleMatrices.end(); ++it) {
+					if (HeaderStatus && (*it)->MatrixData.GetIMatrixMode() == HeaderTemp.MatrixMode) {
+						MatrixItem = move(*it);
+						LoaderState->RecycleMatrices.erase(it);
+						break;
+					}
+				}
+			}
+			LoaderState->LoaderCondition.notify_all();
+
+			(MatrixItem != nullptr ? SpcaGetRuntimeMetrics().LoaderRecycleHits : SpcaGetRuntimeMetrics().LoaderRecycleMisses).Add();
+			if (MatrixItem == nullptr) {
+				MatrixItem = make_unique<SpcaPrefetchMatrix>();
+				MatrixItem->MatrixData = SpcaIndexMatrix<float>(HeaderStatus ? HeaderTemp.MatrixMode : SPCA_TYPE_MATRIX1D);
+			}
+			MatrixItem->FileIndex    = FileIndex;
+			MatrixItem->FileName     = LoaderFiles[FileIndex];
+			MatrixItem->TimeCode     = NULL;
+			MatrixItem->ReserveBytes      = ReserveBytes;
+			MatrixItem->ReserveGeneration = ReserveGeneration;
+
+			// alloc(recycled capacity) => payload read.
+			if (HeaderStatus && MatrixItem->MatrixData.IMatrixAlloc(
+				(size_t)HeaderTemp.DimParam[0], (size_t)HeaderTemp.DimParam[1], (size_t)HeaderTemp.DimParam[2]
+			)) {
+				if (SpcaMatrixFilesys::SpacFTmatrixFileReadTo(
+					LoaderFiles[FileIndex], HeaderTemp, MatrixItem->MatrixData.GetIMatrixRawData()->data(),
+					MatrixItem->MatrixData.GetIMatrixSizeBytes(), LoaderCodecTasks
+				))
+				{
+					MatrixItem->TimeCode = (size_t)HeaderTemp.TimeCode;
+					SpcaGetRuntimeMetrics().LoaderReadBytes.Add(MatrixItem->MatrixData.GetIMatrixSizeBytes());
+				}
+			}
+			if (MatrixItem->TimeCode == NULL)
+				PushLogger(LogWarning, MODULE_LABEL_LOADER, "failed prefetch file: %s", LoaderFiles[FileIndex].c_str());
+			{
+				unique_lock<mutex> Lock(LoaderState->LoaderMutex);
+				ReadyMatrices[FileIndex] = move(MatrixItem);
+			}
+			LoaderState->LoaderCondition.notify_all();
+		}
+	}
+
+	void SpcaMatrixPrefetchLoader::RecycleMatrix(SpcaPrefetchState* state, SpcaPrefetchMatrix* matrix) {
+		{
+			unique_lock<mutex> Lock(state->LoaderMutex);
+			// restarted loader: previous run reserve bytes already reset.
+			if (matrix->ReserveGeneration == state->LoaderGeneration)
+				state->InFlightBytes -= matrix->ReserveBytes;
+			matrix->ReserveBytes = NULL;
+			// recycle limit: prefetch window.
+			if (!state->LoaderStopFlag && state->RecycleMatrices.size() < state->PrefetchCount)
+				state->RecycleMatrices.emplace_back(matrix);
+			else
+				delete matrix;
+		}
+		state->LoaderCondition.notify_all();
+	}
+
+	bool SpcaMatrixPrefetchLoader::StartLoader(
+		const vector<string>& files, size_t prefetch_count, size_t memory_budget, uint32_t io_threads,
+		SpcaTasks::ThreadTasks* codec_tasks
+	) {
+		StopLoader();
+		if (prefetch_count == NULL || io_threads == NULL) {
+			PushLogger(LogError, MODULE_LABEL_LOADER, "failed start loader, prefetch | threads = 0.");
+			return false;
+		}
+		LoaderFiles      = files;
+		LoaderCodecTasks = codec_tasks;
+
+		MemoryBudget  = memory_budget;
+		NextLoadIndex = NextReserveIndex = NextPopIndex = NULL;
+		{
+			// popped matrices(previous run) => recycle concurrently.
+			unique_lock<mutex> Lock(LoaderState->LoaderMutex);
+			LoaderState->PrefetchCount  = prefetch_count;
+			LoaderState->InFlightBytes  = NULL;
+			LoaderState->LoaderStopFlag = false;
+			++LoaderState->LoaderGeneration;
+		}
+
+		try {
+			for (uint32_t i = 0; i < io_threads; ++i)
+				LoaderWorkers.emplace_back([this] { LoaderWorkerExecution(); });
+		}
+		catch (...) {
+			PushLogger(LogError, MODULE_LABEL_LOADER, "failed start loader, create thread.");
+			StopLoader();
+			return false;
+		}
+		PushLogger(LogInfo, MODULE_LABEL_LOADER, "start loader, files: %zu, prefetch: %zu, budget: %.2f mib, threads: %u",
+			files.size(), prefetch_count, (double)memory_budget / 1048576.0, io_threads);
+		return true;
+	}
+
+	shared_ptr<SpcaPrefetchMatrix> SpcaMatrixPrefetchLoader::PopMatrix() {
+		unique_ptr<SpcaPrefetchMatrix> MatrixItem = nullptr;
+		{
+			unique_lock<mutex> Lock(LoaderState->LoaderMutex);
+			if (NextPopIndex >= LoaderFiles.size())
+				return nullptr;
+			LoaderState->LoaderCondition.wait(Lock, [this] { return LoaderState->LoaderStopFlag || ReadyMatrices.count(NextPopIndex); });
+			if (LoaderState->LoaderStopFlag) return nullptr;
+
+			auto it = ReadyMatrices.find(NextPopIndex);
+			MatrixItem = move(it->second);
+			ReadyMatrices.erase(it);
+			++NextPopIndex;
+		}
+		// window moved => wake workers.
+		LoaderState->LoaderCondition.notify_all();
+		// deleter => state(weak), loader freed: delete(non-recycle).
+		weak_ptr<SpcaPrefetchState> StateWeak = LoaderState;
+		return shared_ptr<SpcaPrefetchMatrix>(MatrixItem.release(), [StateWeak](SpcaPrefetchMatrix* matrix) {
+			if (shared_ptr<SpcaPrefetchState> State = StateWeak.lock())
+				RecycleMatrix(State.get(), matrix);
+			else
+				delete matrix;
+		});
+	}
+
+	void SpcaMatrixPrefetchLoader::StopLoader() {
+		{
+			unique_lock<mutex> Lock(LoaderState->LoaderMutex);
+			LoaderState->LoaderStopFlag = true;
+		}
+		LoaderState->LoaderCondition.notify_all();
+		for (thread& Worker : LoaderWorkers)
+			Worker.join();
+		LoaderWorkers.clear();
+
+		unique_lock<mutex> Lock(LoaderState->LoaderMutex);
+		ReadyMatrices.clear();
+		LoaderState->RecycleMatrices.clear();
+	}
+
+	size_t SpcaMatrixPrefetchLoader::GetInFlightBytes() {
+		unique_lock<mutex> Lock(LoaderState->LoaderMutex);
+		return LoaderState->InFlightBytes;
+	}
+
+	size_t SpcaMatrixPrefetchLoader::GetReadyCount() {
+		unique_lock<mutex> Lock(LoaderState->LoaderMutex);
+		return ReadyMatrices.size();
+	}
+}
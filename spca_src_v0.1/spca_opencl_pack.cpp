@@ -0,0 +1,272 @@
+// spca_opencl_pack.
+#include "spca_opencl.h"
+
+using namespace std;
+using namespace PSAG_LOGGER;
+
+#define MODULE_LABEL_PACK "SPCA_PACK"
+
+namespace SpcaMatrixCalc {
+	// entry => data range [header, index), dims bytes == data bytes.
+	static bool PackEntryCheck(const SpcaMatrixPackEntry& entry, uint64_t index_offset) {
+		if (entry.DataType != SPCA_MATFILE_DTYPE_FP32 || entry.DataOffset < SPCA_MATPACK_ALIGN ||
+			entry.DataOffset > index_offset || entry.DataBytes > index_offset - entry.DataOffset
+		)
+			return false;
+		size_t DimsCount = NULL;
+		switch (entry.MatrixMode) {
+		case(SPCA_TYPE_MATRIX1D): { DimsCount = 1; break; }
+		case(SPCA_TYPE_MATRIX2D): { DimsCount = 2; break; }
+		case(SPCA_TYPE_MATRIX3D): { DimsCount = 3; break; }
+		default: return false;
+		}
+		// dims product(bytes) <= data bytes, non-wrap.
+		uint64_t MatrixBytes = sizeof(float);
+		for (size_t i = 0; i < DimsCount; ++i) {
+			if (entry.DimParam[i] != NULL && MatrixBytes > entry.DataBytes / entry.DimParam[i])
+				return false;
+			MatrixBytes *= entry.DimParam[i];
+		}
+		return MatrixBytes == entry.DataBytes;
+	}
+
+	bool SpcaMatrixPackWriter::OpenPackFile(const string& filename, uint32_t write_flags) {
+		ClosePackFile();
+		PackIndex.clear();
+		PackNames.clear();
+		PackFlags = write_flags;
+
+		if (!PackWriter.OpenStreamFile(filename, write_flags & (FILE_STREAM_DIRECT | FILE_STREAM_SYNC))) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed open matrix pack, no-path(wb).");
+			return false;
+		}
+		// pack header: magic, version => first entry(aligned).
+		uint32_t PackHeader[SPCA_MATPACK_ALIGN / sizeof(uint32_t)] = { SPCA_MATPACK_MAGIC, SPCA_MATPACK_VERSION };
+		if (!PackWriter.WriteStreamData(PackHeader, sizeof(PackHeader))) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed open matrix pack, header(wb).");
+			PackWriter.CloseStreamFile();
+			return false;
+		}
+		PackOffset = sizeof(PackHeader);
+		return true;
+	}
+
+	bool SpcaMatrixPackWriter::PushPackMatrix(const string& name, SpcaIndexMatrix<float>& matrix_data) {
+		// matrix storage => view, non-copy.
+		return PushPackMatrix(name, SpcaMatrixView<float>(matrix_data));
+	}
+
+	bool SpcaMatrixPackWriter::PushPackMatrix(const string& name, const SpcaMatrixView<float>& matrix_view) {
+		if (PackOffset == NULL) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed push matrix pack, not open.");
+			return false;
+		}
+		if (PackNames.find(name) != PackNames.end()) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed push matrix pack, name repeat: %s", name.c_str());
+			return false;
+		}
+		SpcaMatrixPackEntry EntryTemp = {};
+		EntryTemp.MatrixMode = matrix_view.GetIMatrixMode();
+		EntryTemp.DataType   = SPCA_MATFILE_DTYPE_FP32;
+		EntryTemp.DataOffset = PackOffset;
+		EntryTemp.DataBytes  = matrix_view.GetIMatrixSizeBytes();
+
+		for (size_t i = 0; i < 3; ++i)
+			EntryTemp.DimParam[i] = matrix_view.GetIMatrixDimParam(i);
+		if (PackFlags & SPCA_MATFILE_CRC32C) {
+			EntryTemp.EntryFlags |= SPCA_MATFILE_CRC32C;
+			EntryTemp.DataCRC32C = FileChecksumCRC32C(matrix_view.GetIMatrixViewData(), (size_t)EntryTemp.DataBytes);
+		}
+		// data + zero padding => next entry aligned.
+		uint8_t PaddingBytes[SPCA_MATPACK_ALIGN] = {};
+		size_t PaddingSize = (size_t)((SPCA_MATPACK_ALIGN - EntryTemp.DataBytes % SPCA_MATPACK_ALIGN) % SPCA_MATPACK_ALIGN);
+
+		if (!PackWriter.WriteStreamData(matrix_view.GetIMatrixViewData(), (size_t)EntryTemp.DataBytes) ||
+			!PackWriter.WriteStreamData(PaddingBytes, PaddingSize)
+		) {
+			// stream position unknown => pack invalid(non-index).
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed push matrix pack, data(wb): %s", name.c_str());
+			PackWriter.CloseStreamFile();
+			PackOffset = NULL;
+			return false;
+		}
+		PackOffset += EntryTemp.DataBytes + PaddingSize;
+
+		PackNames[name] = PackIndex.size();
+		PackIndex.emplace_back(name, EntryTemp);
+		return true;
+	}
+
+	bool SpcaMatrixPackWriter::ClosePackFile() {
+		if (PackOffset == NULL) return false;
+		// index: [name_len, name, entry] * count.
+		vector<uint8_t> IndexBytes = {};
+		for (const auto& Entry : PackIndex) {
+			uint32_t NameLength = (uint32_t)Entry.first.size();
+			size_t WriteOffset = IndexBytes.size();
+
+			IndexBytes.resize(WriteOffset + sizeof(uint32_t) + NameLength + sizeof(SpcaMatrixPackEntry));
+			memcpy(IndexBytes.data() + WriteOffset, &NameLength, sizeof(uint32_t));
+			memcpy(IndexBytes.data() + WriteOffset + sizeof(uint32_t), Entry.first.data(), NameLength);
+			memcpy(IndexBytes.data() + WriteOffset + sizeof(uint32_t) + NameLength, &Entry.second, sizeof(SpcaMatrixPackEntry));
+		}
+		SpcaMatrixPackTrailer TrailerTemp = {};
+		TrailerTemp.IndexOffset   = PackOffset;
+		TrailerTemp.IndexBytes    = IndexBytes.size();
+		TrailerTemp.EntryCount    = (uint32_t)PackIndex.size();
+		TrailerTemp.IndexCRC32C   = FileChecksumCRC32C(IndexBytes.data(), IndexBytes.size());
+		TrailerTemp.FormatVersion = SPCA_MATPACK_VERSION;
+		TrailerTemp.MagicCode     = SPCA_MATPACK_MAGIC;
+
+		bool CloseStatus =
+			PackWriter.WriteStreamData(IndexBytes.data(), IndexBytes.size()) &&
+			PackWriter.WriteStreamData(&TrailerTemp, sizeof(SpcaMatrixPackTrailer));
+		CloseStatus &= PackWriter.CloseStreamFile();
+		PackOffset = NULL;
+
+		if (!CloseStatus) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed close matrix pack, index(wb).");
+			return false;
+		}
+		PushLogger(LogInfo, MODULE_LABEL_PACK, "close matrix pack, entries: %zu, size: %.4f mib",
+			PackIndex.size(), (double)PackWriter.GetTotalSize() / 1048576.0);
+		return true;
+	}
+
+	bool SpcaMatrixPackReader::OpenPackFile(const string& filename, bool mapping) {
+		ClosePackFile();
+		if (!PackReader.OpenStreamFile(filename) || PackReader.GetTotalSize() < SPCA_MATPACK_ALIGN + sizeof(SpcaMatrixPackTrailer)) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed open matrix pack, no-path(rb).");
+			return false;
+		}
+		// header(file begin): magic, version.
+		uint32_t PackHeader[2] = {};
+		if (!PackReader.ReadStreamData(NULL, PackHeader, sizeof(PackHeader)) || PackHeader[0] != SPCA_MATPACK_MAGIC) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed open matrix pack, header magic.");
+			ClosePackFile();
+			return false;
+		}
+		if (PackHeader[1] != SPCA_MATPACK_VERSION) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed open matrix pack, unsupported version: %u", PackHeader[1]);
+			ClosePackFile();
+			return false;
+		}
+		// trailer(file end) => index range [header, trailer).
+		SpcaMatrixPackTrailer TrailerTemp = {};
+		uint64_t TrailerOffset = PackReader.GetTotalSize() - sizeof(SpcaMatrixPackTrailer);
+
+		if (!PackReader.ReadStreamData(TrailerOffset, &TrailerTemp, sizeof(SpcaMatrixPackTrailer)) ||
+			TrailerTemp.MagicCode != SPCA_MATPACK_MAGIC || TrailerTemp.FormatVersion != SPCA_MATPACK_VERSION ||
+			TrailerTemp.IndexOffset < SPCA_MATPACK_ALIGN || TrailerTemp.IndexOffset > TrailerOffset ||
+			TrailerTemp.IndexBytes != TrailerOffset - TrailerTemp.IndexOffset
+		) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed open matrix pack, trailer.");
+			ClosePackFile();
+			return false;
+		}
+		vector<uint8_t> IndexBytes((size_t)TrailerTemp.IndexBytes);
+		if (!PackReader.ReadStreamData(TrailerTemp.IndexOffset, IndexBytes.data(), IndexBytes.size()) ||
+			FileChecksumCRC32C(IndexBytes.data(), IndexBytes.size()) != TrailerTemp.IndexCRC32C
+		) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed open matrix pack, index crc32c.");
+			ClosePackFile();
+			return false;
+		}
+		// index bytes => name map.
+		size_t ReadOffset = NULL;
+		PackIndex.reserve(TrailerTemp.EntryCount);
+
+		for (uint32_t i = 0; i < TrailerTemp.EntryCount; ++i) {
+			uint32_t NameLength = NULL;
+			if (IndexBytes.size() - ReadOffset < sizeof(uint32_t)) break;
+			memcpy(&NameLength, IndexBytes.data() + ReadOffset, sizeof(uint32_t));
+			ReadOffset += sizeof(uint32_t);
+
+			if (IndexBytes.size() - ReadOffset < (size_t)NameLength + sizeof(SpcaMatrixPackEntry)) break;
+			string EntryName((const char*)IndexBytes.data() + ReadOffset, NameLength);
+			ReadOffset += NameLength;
+
+			SpcaMatrixPackEntry EntryTemp = {};
+			memcpy(&EntryTemp, IndexBytes.data() + ReadOffset, sizeof(SpcaMatrixPackEntry));
+			ReadOffset += sizeof(SpcaMatrixPackEntry);
+
+			if (!PackEntryCheck(EntryTemp, TrailerTemp.IndexOffset)) break;
+			PackIndex[EntryName] = EntryTemp;
+		}
+		if (PackIndex.size() != TrailerTemp.EntryCount) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed open matrix pack, index entries.");
+			ClosePackFile();
+			return false;
+		}
+		if (mapping && !PackMapping.MapBinaryFile(filename, false)) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed open matrix pack, mapping.");
+			ClosePackFile();
+			return false;
+		}
+		PushLogger(LogInfo, MODULE_LABEL_PACK, "open matrix pack, entries: %zu", PackIndex.size());
+		return true;
+	}
+
+	void SpcaMatrixPackReader::ClosePackFile() {
+		PackReader.CloseStreamFile();
+		PackMapping.UnmapBinaryFile();
+		PackIndex.clear();
+	}
+
+	const SpcaMatrixPackEntry* SpcaMatrixPackReader::FindPackEntry(const string& name) {
+		auto it = PackIndex.find(name);
+		return it != PackIndex.end() ? &it->second : nullptr;
+	}
+
+	bool SpcaMatrixPackReader::ReadPackMatrix(const string& name, SpcaIndexMatrix<float>& matrix_data) {
+		const SpcaMatrixPackEntry* Entry = FindPackEntry(name);
+		if (Entry == nullptr || Entry->MatrixMode != matrix_data.GetIMatrixMode()) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed read matrix pack, not found | mode: %s", name.c_str());
+			return false;
+		}
+		if (!matrix_data.IMatrixAlloc((size_t)Entry->DimParam[0], (size_t)Entry->DimParam[1], (size_t)Entry->DimParam[2]) ||
+			matrix_data.GetIMatrixSizeBytes() != Entry->DataBytes
+		) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed read matrix pack, alloc matrix: %s", name.c_str());
+			return false;
+		}
+		void* TargetPointer = matrix_data.GetIMatrixRawData()->data();
+		// mapping: slice copy, else one read.
+		if (PackMapping.GetMappingData() != nullptr)
+			memcpy(TargetPointer, PackMapping.GetMappingData() + Entry->DataOffset, (size_t)Entry->DataBytes);
+		else if (!PackReader.ReadStreamData(Entry->DataOffset, TargetPointer, (size_t)Entry->DataBytes)) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed read matrix pack, data(rb): %s", name.c_str());
+			return false;
+		}
+		if ((Entry->EntryFlags & SPCA_MATFILE_CRC32C) &&
+			FileChecksumCRC32C(TargetPointer, (size_t)Entry->DataBytes) != Entry->DataCRC32C
+		) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed read matrix pack, data crc32c: %s", name.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	bool SpcaMatrixPackReader::ViewPackMatrix(const string& name, SpcaMatrixView<float>& matrix_view) {
+		const SpcaMatrixPackEntry* Entry = FindPackEntry(name);
+		if (Entry == nullptr || PackMapping.GetMappingData() == nullptr) {
+			PushLogger(LogError, MODULE_LABEL_PACK, "failed view matrix pack, not found | non-mapping: %s", name.c_str());
+			return false;
+		}
+		// entry offset aligned(64 bytes) => float aligned.
+		matrix_view = SpcaMatrixView<float>(
+			Entry->MatrixMode, (const float*)(PackMapping.GetMappingData() + Entry->DataOffset),
+			(size_t)Entry->DimParam[0], (size_t)Entry->DimParam[1], (size_t)Entry->DimParam[2]
+		);
+		return true;
+	}
+
+	vector<string> SpcaMatrixPackReader::GetPackNames() {
+		vector<string> PackNamesTemp = {};
+		PackNamesTemp.reserve(PackIndex.size());
+
+		for (const auto& Entry : PackIndex)
+			PackNamesTemp.push_back(Entry.first);
+		return PackNamesTemp;
+	}
+}
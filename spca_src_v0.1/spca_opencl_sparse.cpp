@@ -0,0 +1,197 @@
+// spca_opencl_sparse.
+#include "spca_opencl.h"
+
+using namespace std;
+using namespace PSAG_LOGGER;
+
+// sparse matrix kernels v20261019 RCSZ.
+// params(uint): [0]:rows, [1]:cols, [2]:slice_c, [3]:dense_cols.
+constexpr const char* ScriptSparseKernels = R"(
+#define SPCA_SPARSE_LOCAL_MAX 256
+
+__kernel void SpcaSpMVcsr(
+    __global const uint* RowOffsets, __global const uint* ColumnIndices, __global const float* Values,
+    __global const uint* SparseParam, __global const float* VectorX, __global float* VectorY
+) {
+    uint Row = get_global_id(0);
+    if (Row >= SparseParam[0]) return;
+
+    float ResultValue = 0.0f;
+    for (uint k = RowOffsets[Row]; k < RowOffsets[Row + 1]; ++k)
+        ResultValue += Values[k] * VectorX[ColumnIndices[k]];
+    VectorY[Row] = ResultValue;
+}
+
+// row => "lanes" work_items(dim 0), local tree reduction.
+__kernel void SpcaSpMVcsrVector(
+    __global const uint* RowOffsets, __global const uint* ColumnIndices, __global const float* Values,
+    __global const uint* SparseParam, __global const float* VectorX, __global float* VectorY
+) {
+    __local float PartialSum[SPCA_SPARSE_LOCAL_MAX];
+
+    uint Lane  = get_local_id(0);
+    uint Lanes = get_local_size(0);
+    uint Slot  = get_local_id(1) * Lanes + Lane;
+    uint Row   = get_global_id(1);
+
+    float ResultValue = 0.0f;
+    if (Row < SparseParam[0]) {
+        for (uint k = RowOffsets[Row] + Lane; k < RowOffsets[Row + 1]; k += Lanes)
+            ResultValue += Values[k] * VectorX[ColumnIndices[k]];
+    }
+    PartialSum[Slot] = ResultValue;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for (uint Step = Lanes >> 1; Step > 0; Step >>= 1) {
+        if (Lane < Step) PartialSum[Slot] += PartialSum[Slot + Step];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    if (Lane == 0 && Row < SparseParam[0])
+        VectorY[Row] = PartialSum[Slot];
+}
+
+// slice column-major: lane reads are coalesced.
+__kernel void SpcaSpMVsell(
+    __global const uint* SliceOffsets, __global const uint* ColumnIndices, __global const float* Values,
+    __global const uint* RowPermute, __global const uint* SparseParam,
+    __global const float* VectorX, __global float* VectorY
+) {
+    uint Slot = get_global_id(0);
+    if (Slot >= SparseParam[0]) return;
+
+    uint SliceC = SparseParam[2];
+    uint Slice  = Slot / SliceC;
+    uint Lane   = Slot % SliceC;
+
+    uint Begin = SliceOffsets[Slice];
+    uint Width = (SliceOffsets[Slice + 1] - Begin) / SliceC;
+
+    float ResultValue = 0.0f;
+    for (uint k = 0; k < Width; ++k) {
+        uint Index = Begin + k * SliceC + Lane;
+        ResultValue += Values[Index] * VectorX[ColumnIndices[Index]];
+    }
+    VectorY[RowPermute[Slot]] = ResultValue;
+}
+
+__kernel void SpcaSpMMcsr(
+    __global const uint* RowOffsets, __global const uint* ColumnIndices, __global const float* Values,
+    __global const uint* SparseParam, __global const float* MatrixB, __global float* MatrixC
+) {
+    uint Col = get_global_id(0);
+    uint Row = get_global_id(1);
+
+    uint DenseCols = SparseParam[3];
+    if (Row >= SparseParam[0] || Col >= DenseCols) return;
+
+    float ResultValue = 0.0f;
+    for (uint k = RowOffsets[Row]; k < RowOffsets[Row + 1]; ++k)
+        ResultValue += Values[k] * MatrixB[(size_t)ColumnIndices[k] * DenseCols + Col];
+    MatrixC[(size_t)Row * DenseCols + Col] = ResultValue;
+}
+
+__kernel void SpcaSpMMsell(
+    __global const uint* SliceOffsets, __global const uint* ColumnIndices, __global const float* Values,
+    __global const uint* RowPermute, __global const uint* SparseParam,
+    __global const float* MatrixB, __global float* MatrixC
+) {
+    uint Col  = get_global_id(0);
+    uint Slot = get_global_id(1);
+
+    uint DenseCols = SparseParam[3];
+    if (Slot >= SparseParam[0] || Col >= DenseCols) return;
+
+    uint SliceC = SparseParam[2];
+    uint Slice  = Slot / SliceC;
+    uint Lane   = Slot % SliceC;
+
+    uint Begin = SliceOffsets[Slice];
+    uint Width = (SliceOffsets[Slice + 1] - Begin) / SliceC;
+
+    float ResultValue = 0.0f;
+    for (uint k = 0; k < Width; ++k) {
+        uint Index = Begin + k * SliceC + Lane;
+        ResultValue += Values[Index] * MatrixB[(size_t)ColumnIndices[Index] * DenseCols + Col];
+    }
+    MatrixC[(size_t)RowPermute[Slot] * DenseCols + Col] = ResultValue;
+}
+)";
+
+#define SPARSE_PARAMS_LEN 4
+namespace SpcaMatrixCalc {
+	namespace SpcaSparseKernel {
+		const char* const ScriptSparseMatrix = ScriptSparseKernels;
+	}
+
+	bool SpcaMatrix2Calc::SpcaPushBufferData(const void* data, size_t bytes) {
+		// empty array => 1 element(zero), mem_object size > 0. one copy => move(dataset).
+		size_t FloatsLen = max((bytes + sizeof(float) - 1) / sizeof(float), (size_t)1);
+
+		SpcaIndexMatrix<float> BufferMatrix(SPCA_TYPE_MATRIX2D);
+		BufferMatrix.IMatrixAlloc(FloatsLen, 1);
+		if (bytes > NULL)
+			memcpy(BufferMatrix.GetIMatrixRawData()->data(), data, bytes);
+		return SpcaPushMatrixData(move(BufferMatrix));
+	}
+
+	void SpcaMatrix2Calc::SpcaPushSparseAttribute(SpcaSparseMatrixCSR<float>& matrix) {
+		// index(uint) & value(float) elements: 4 bytes.
+		SpcaPushMatrixAttribute(max(matrix.GetSMatrixRowOffsets()->size(), (size_t)1), 1, WRITE_ONLY_MATRIX);
+		SpcaPushMatrixAttribute(max(matrix.GetSMatrixColumnIndices()->size(), (size_t)1), 1, WRITE_ONLY_MATRIX);
+		SpcaPushMatrixAttribute(max(matrix.GetSMatrixValues()->size(), (size_t)1), 1, WRITE_ONLY_MATRIX);
+		SpcaPushMatrixAttribute(SPARSE_PARAMS_LEN, 1, WRITE_ONLY_MATRIX);
+
+		PushLogger(LogInfo, ModuleTagOpenCL, "push(attrib) sparse csr, nnz: %zu, size: %.4f mib",
+			matrix.GetSMatrixNonZeros(), (double)matrix.GetSMatrixSizeBytes() / 1048576.0);
+		static_assert(sizeof(SpcaSparseIndex) == sizeof(float), "sparse index size != 4 bytes.");
+	}
+
+	void SpcaMatrix2Calc::SpcaPushSparseAttribute(SpcaSparseMatrixSELL<float>& matrix) {
+		SpcaPushMatrixAttribute(max(matrix.GetSMatrixSliceOffsets()->size(), (size_t)1), 1, WRITE_ONLY_MATRIX);
+		SpcaPushMatrixAttribute(max(matrix.GetSMatrixColumnIndices()->size(), (size_t)1), 1, WRITE_ONLY_MATRIX);
+		SpcaPushMatrixAttribute(max(matrix.GetSMatrixValues()->size(), (size_t)1), 1, WRITE_ONLY_MATRIX);
+		SpcaPushMatrixAttribute(max(matrix.GetSMatrixRowPermute()->size(), (size_t)1), 1, WRITE_ONLY_MATRIX);
+		SpcaPushMatrixAttribute(SPARSE_PARAMS_LEN, 1, WRITE_ONLY_MATRIX);
+
+		PushLogger(LogInfo, ModuleTagOpenCL, "push(attrib) sparse sell, nnz: %zu, c: %zu, padding: %.3f",
+			matrix.GetSMatrixNonZeros(), matrix.GetSMatrixSliceHeight(), matrix.GetSMatrixPaddingRatio());
+	}
+
+	bool SpcaMatrix2Calc::SpcaPushSparseData(SpcaSparseMatrixCSR<float>& matrix, size_t dense_cols) {
+		SpcaSparseIndex SparseParams[SPARSE_PARAMS_LEN] = {
+			(SpcaSparseIndex)matrix.GetSMatrixDimParam(0), (SpcaSparseIndex)matrix.GetSMatrixDimParam(1),
+			NULL, (SpcaSparseIndex)dense_cols
+		};
+		bool ReturnStatus =
+			SpcaPushBufferData(matrix.GetSMatrixRowOffsets()->data(),
+				matrix.GetSMatrixRowOffsets()->size() * sizeof(SpcaSparseIndex)) &&
+			SpcaPushBufferData(matrix.GetSMatrixColumnIndices()->data(),
+				matrix.GetSMatrixColumnIndices()->size() * sizeof(SpcaSparseIndex)) &&
+			SpcaPushBufferData(matrix.GetSMatrixValues()->data(),
+				matrix.GetSMatrixValues()->size() * sizeof(float)) &&
+			SpcaPushBufferData(SparseParams, sizeof(SparseParams));
+		if (!ReturnStatus)
+			PushLogger(LogError, ModuleTagOpenCL, "push(dataset) sparse csr != attribute.");
+		return ReturnStatus;
+	}
+
+	bool SpcaMatrix2Calc::SpcaPushSparseData(SpcaSparseMatrixSELL<float>& matrix, size_t dense_cols) {
+		SpcaSparseIndex SparseParams[SPARSE_PARAMS_LEN] = {
+			(SpcaSparseIndex)matrix.GetSMatrixDimParam(0), (SpcaSparseIndex)matrix.GetSMatrixDimParam(1),
+			(SpcaSparseIndex)matrix.GetSMatrixSliceHeight(), (SpcaSparseIndex)dense_cols
+		};
+		bool ReturnStatus =
+			SpcaPushBufferData(matrix.GetSMatrixSliceOffsets()->data(),
+				matrix.GetSMatrixSliceOffsets()->size() * sizeof(SpcaSparseIndex)) &&
+			SpcaPushBufferData(matrix.GetSMatrixColumnIndices()->data(),
+				matrix.GetSMatrixColumnIndices()->size() * sizeof(SpcaSparseIndex)) &&
+			SpcaPushBufferData(matrix.GetSMatrixValues()->data(),
+				matrix.GetSMatrixValues()->size() * sizeof(float)) &&
+			SpcaPushBufferData(matrix.GetSMatrixRowPermute()->data(),
+				matrix.GetSMatrixRowPermute()->size() * sizeof(SpcaSparseIndex)) &&
+			SpcaPushBufferData(SparseParams, sizeof(SparseParams));
+		if (!ReturnStatus)
+			PushLogger(LogError, ModuleTagOpenCL, "push(dataset) sparse sell != attribute.");
+		return ReturnStatus;
+	}
+}
@@ -0,0 +1,221 @@
+// spca_tool_codec.
+#include "spca_tool_codec.h"
+
+#include <cstring>
+
+using namespace std;
+
+// lz: min match 4 bytes, offset 16 bits, hash table 2^14.
+#define LZ_MIN_MATCH  4
+#define LZ_MAX_OFFSET 65535
+#define LZ_HASH_LOG   14
+// tail: last bytes => literals.
+#define LZ_END_LITERALS 8
+
+namespace SpcaCodec {
+    void ShuffleDeltaEncode(const uint8_t* src, uint8_t* dst, size_t bytes, size_t type_size) {
+        size_t WordsCount = type_size > 0 && type_size <= sizeof(uint64_t) ? bytes / type_size : NULL;
+        uint64_t PrevWord = NULL;
+
+        for (size_t i = 0; i < WordsCount; ++i) {
+            uint64_t Word = NULL;
+            memcpy(&Word, src + i * type_size, type_size);
+            // integer delta(wrap), smooth data => small high bytes.
+            uint64_t Delta = Word - PrevWord;
+            PrevWord = Word;
+
+            for (size_t b = 0; b < type_size; ++b)
+                dst[b * WordsCount + i] = uint8_t(Delta >> (b * 8));
+        }
+        size_t PlanesBytes = WordsCount * type_size;
+        memcpy(dst + PlanesBytes, src + PlanesBytes, bytes - PlanesBytes);
+    }
+
+    void ShuffleDeltaDecode(const uint8_t* src, uint8_t* dst, size_t bytes, size_t type_size) {
+        size_t WordsCount = type_size > 0 && type_size <= sizeof(uint64_t) ? bytes / type_size : NULL;
+        uint64_t PrevWord = NULL;
+
+        for (size_t i = 0; i < WordsCount; ++i) {
+            uint64_t Delta = NULL;
+            for (size_t b = 0; b < type_size; ++b)
+                Delta |= uint64_t(src[b * WordsCount + i]) << (b * 8);
+
+            PrevWord += Delta;
+            memcpy(dst + i * type_size, &PrevWord, type_size);
+        }
+        size_t PlanesBytes = WordsCount * type_size;
+        memcpy(dst + PlanesBytes, src + PlanesBytes, bytes - PlanesBytes);
+    }
+
+    // sequence length: nibble(15) + 255 bytes chain.
+    static uint8_t* LZWriteLength(uint8_t* op, size_t length) {
+        for (; length >= 255; length -= 255)
+            *op++ = 255;
+        *op++ = (uint8_t)length;
+        return op;
+    }
+
+    static inline uint32_t LZRead32(const uint8_t* pointer) {
+        uint32_t Value = NULL;
+        memcpy(&Value, pointer, sizeof(uint32_t));
+        return Value;
+    }
+
+    size_t LZCompress(const uint8_t* src, size_t bytes, uint8_t* dst, size_t capacity) {
+        vector<uint32_t> HashTable(size_t(1) << LZ_HASH_LOG, NULL);
+
+        const uint8_t* Anchor = src;
+        const uint8_t* Ip     = src;
+        const uint8_t* IpEnd  = src + bytes;
+        const uint8_t* IpLimit = bytes > LZ_END_LITERALS + LZ_MIN_MATCH ? IpEnd - LZ_END_LITERALS : src;
+
+        uint8_t* Op    = dst;
+        uint8_t* OpEnd = dst + capacity;
+
+        // literals + match => sequence, false: capacity.
+        auto WriteSequence = [&](size_t literals, size_t offset, size_t match) {
+            if (size_t(OpEnd - Op) < 1 + literals + literals / 255 + 1 + 2 + match / 255 + 1)
+                return false;
+            uint8_t* Token = Op++;
+            *Token = uint8_t((literals < 15 ? literals : 15) << 4);
+            if (literals >= 15) Op = LZWriteLength(Op, literals - 15);
+
+            memcpy(Op, Anchor, literals);
+            Op += literals;
+            // last sequence: literals only.
+            if (match == NULL) return true;
+
+            *Op++ = uint8_t(offset);
+            *Op++ = uint8_t(offset >> 8);
+
+            size_t MatchCode = match - LZ_MIN_MATCH;
+            *Token |= uint8_t(MatchCode < 15 ? MatchCode : 15);
+            if (MatchCode >= 15) Op = LZWriteLength(Op, MatchCode - 15);
+            return true;
+        };
+
+        while (Ip < IpLimit) {
+            uint32_t Sequence = LZRead32(Ip);
+            uint32_t HashCode = (Sequence * 2654435761u) >> (32 - LZ_HASH_LOG);
+
+            const uint8_t* Candidate = src + HashTable[HashCode];
+            HashTable[HashCode] = uint32_t(Ip - src);
+
+            if (Candidate >= Ip || size_t(Ip - Candidate) > LZ_MAX_OFFSET || LZRead32(Candidate) != Sequence) {
+                // non-match: skip faster over incompressible runs.
+                Ip += 1 + ((Ip - Anchor) >> 6);
+                continue;
+            }
+            // extend backward & forward.
+            while (Ip > Anchor && Candidate > src && Ip[-1] == Candidate[-1]) {
+                --Ip; --Candidate;
+            }
+            size_t MatchLength = LZ_MIN_MATCH;
+            while (Ip + MatchLength < IpLimit && Ip[MatchLength] == Candidate[MatchLength])
+                ++MatchLength;
+
+            if (!WriteSequence(size_t(Ip - Anchor), size_t(Ip - Candidate), MatchLength))
+                return NULL;
+            Ip += MatchLength;
+            Anchor = Ip;
+        }
+        if (!WriteSequence(size_t(IpEnd - Anchor), NULL, NULL))
+            return NULL;
+        return size_t(Op - dst);
+    }
+
+    bool LZDecompress(const uint8_t* src, size_t src_bytes, uint8_t* dst, size_t bytes) {
+        const uint8_t* Ip    = src;
+        const uint8_t* IpEnd = src + src_bytes;
+
+        uint8_t* Op    = dst;
+        uint8_t* OpEnd = dst + bytes;
+
+        // length chain => value, false: truncated.
+        auto ReadLength = [&](size_t& length) {
+            uint8_t Value = 255;
+            while (Value == 255) {
+                if (Ip >= IpEnd) return false;
+                Value = *Ip++;
+                length += Value;
+            }
+            return true;
+        };
+
+        while (Ip < IpEnd) {
+            uint8_t Token = *Ip++;
+
+            size_t Literals = Token >> 4;
+            if (Literals == 15 && !ReadLength(Literals)) return false;
+            if (size_t(IpEnd - Ip) < Literals || size_t(OpEnd - Op) < Literals) return false;
+
+            memcpy(Op, Ip, Literals);
+            Ip += Literals;
+            Op += Literals;
+            // last sequence.
+            if (Ip == IpEnd) break;
+
+            if (IpEnd - Ip < 2) return false;
+            size_t Offset = size_t(Ip[0]) | size_t(Ip[1]) << 8;
+            Ip += 2;
+
+            size_t MatchLength = Token & 15;
+            if (MatchLength == 15 && !ReadLength(MatchLength)) return false;
+            MatchLength += LZ_MIN_MATCH;
+
+            if (Offset == NULL || Offset > size_t(Op - dst) || size_t(OpEnd - Op) < MatchLength) return false;
+            const uint8_t* Match = Op - Offset;
+            // overlap(offset < length) => byte copy(repeat pattern).
+            if (Offset >= MatchLength) {
+                memcpy(Op, Match, MatchLength);
+                Op += MatchLength;
+            }
+            else {
+                for (size_t i = 0; i < MatchLength; ++i)
+                    *Op++ = *Match++;
+            }
+        }
+        return Op == OpEnd;
+    }
+
+    uint32_t BlockEncode(const uint8_t* src, size_t bytes, size_t type_size, vector<uint8_t>& out) {
+        if (bytes == NULL) {
+            out.clear();
+            return SPCA_CODEC_RAW;
+        }
+        vector<uint8_t> ShuffleTemp(bytes);
+        ShuffleDeltaEncode(src, ShuffleTemp.data(), bytes, type_size);
+
+        // encoded >= raw => stored.
+        out.resize(bytes);
+        size_t EncodedBytes = LZCompress(ShuffleTemp.data(), bytes, out.data(), bytes);
+        if (EncodedBytes == NULL) {
+            memcpy(out.data(), src, bytes);
+            return SPCA_CODEC_RAW;
+        }
+        out.resize(EncodedBytes);
+        return SPCA_CODEC_LZ | SPCA_CODEC_SHUFFLE;
+    }
+
+    bool BlockDecode(const uint8_t* src, size_t src_bytes, uint32_t flags, size_t type_size, uint8_t* dst, size_t bytes) {
+        if (bytes == NULL) return src_bytes == NULL;
+        if (flags == SPCA_CODEC_RAW) {
+            if (src_bytes != bytes) return false;
+            memcpy(dst, src, bytes);
+            return true;
+        }
+        if (!(flags & SPCA_CODEC_SHUFFLE))
+            return (flags & SPCA_CODEC_LZ) && LZDecompress(src, src_bytes, dst, bytes);
+
+        vector<uint8_t> ShuffleTemp(bytes);
+        if (flags & SPCA_CODEC_LZ) {
+            if (!LZDecompress(src, src_bytes, ShuffleTemp.data(), bytes)) return false;
+        }
+        else {
+            if (src_bytes != bytes) return false;
+            memcpy(ShuffleTemp.data(), src, bytes);
+        }
+        ShuffleDeltaDecode(ShuffleTemp.data(), dst, bytes, type_size);
+        return true;
+    }
+}
@@ -0,0 +1,31 @@
+// spca_tool_codec, (block codec: shuffle-delta + lz), v0.1, RCSZ 2026.10.19
+// block independent: random access(per block), parallel encode / decode.
+
+#ifndef _SPCA_TOOL_CODEC_H
+#define _SPCA_TOOL_CODEC_H
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// block encoding flags.
+#define SPCA_CODEC_RAW     (uint32_t)0      // stored, non-encode.
+#define SPCA_CODEC_LZ      ((uint32_t)1 << 0) // lz sequences.
+#define SPCA_CODEC_SHUFFLE ((uint32_t)1 << 1) // delta(words) + byte shuffle(planes).
+
+namespace SpcaCodec {
+    // words(type_size) delta => byte planes, tail(bytes % type_size) copy.
+    void ShuffleDeltaEncode(const uint8_t* src, uint8_t* dst, size_t bytes, size_t type_size);
+    void ShuffleDeltaDecode(const uint8_t* src, uint8_t* dst, size_t bytes, size_t type_size);
+
+    // lz(byte oriented, 64 kib window), return: compressed bytes, 0: size >= "capacity".
+    size_t LZCompress(const uint8_t* src, size_t bytes, uint8_t* dst, size_t capacity);
+    // return false: corrupt stream | size != "bytes".
+    bool LZDecompress(const uint8_t* src, size_t src_bytes, uint8_t* dst, size_t bytes);
+
+    // block => encoded(out), return flags. no gain => SPCA_CODEC_RAW(copy).
+    uint32_t BlockEncode(const uint8_t* src, size_t bytes, size_t type_size, std::vector<uint8_t>& out);
+    // encoded(flags) => block, "bytes": raw block size.
+    bool BlockDecode(const uint8_t* src, size_t src_bytes, uint32_t flags, size_t type_size, uint8_t* dst, size_t bytes);
+}
+
+#endif
@@ -2,6 +2,27 @@
 #include <chrono>
 #include "spca_tool_filesystem.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <cerrno>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
 using namespace std;
 
 bool FileLoaderBinary::ReadBinaryFile(const std::string& filename) {
@@ -34,6 +55,306 @@ bool FileLoaderBinary::WriterBinaryFile(const string& filename, const vector<uin
     return false;
 }
 
+bool FileMappingBinary::MapBinaryFile(const string& filename, bool sequential) {
+    UnmapBinaryFile();
+#if defined(_WIN32)
+    DWORD AccessHint = sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+    HANDLE FileHandle = CreateFileA(
+        filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, AccessHint, nullptr
+    );
+    if (FileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER FileSize = {};
+    if (!GetFileSizeEx(FileHandle, &FileSize) || FileSize.QuadPart == NULL) {
+        CloseHandle(FileHandle);
+        return false;
+    }
+    HANDLE MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, NULL, NULL, nullptr);
+    if (MappingHandle == nullptr) {
+        CloseHandle(FileHandle);
+        return false;
+    }
+    void* ViewPointer = MapViewOfFile(MappingHandle, FILE_MAP_READ, NULL, NULL, NULL);
+    if (ViewPointer == nullptr) {
+        CloseHandle(MappingHandle);
+        CloseHandle(FileHandle);
+        return false;
+    }
+    MappingFileHandle   = FileHandle;
+    MappingObjectHandle = MappingHandle;
+    MappingDataSize     = (size_t)FileSize.QuadPart;
+#else
+    int FileDescriptor = open(filename.c_str(), O_RDONLY);
+    if (FileDescriptor < 0) return false;
+
+    struct stat FileStatus = {};
+    if (fstat(FileDescriptor, &FileStatus) != 0 || FileStatus.st_size == NULL) {
+        close(FileDescriptor);
+        return false;
+    }
+    void* ViewPointer = mmap(nullptr, (size_t)FileStatus.st_size, PROT_READ, MAP_PRIVATE, FileDescriptor, NULL);
+    if (ViewPointer == MAP_FAILED) {
+        close(FileDescriptor);
+        return false;
+    }
+    // read ahead hints: sequential scan + prefetch pages.
+    if (sequential) {
+        madvise(ViewPointer, (size_t)FileStatus.st_size, MADV_SEQUENTIAL);
+        madvise(ViewPointer, (size_t)FileStatus.st_size, MADV_WILLNEED);
+    }
+
+    MappingFileDescriptor = FileDescriptor;
+    MappingDataSize       = (size_t)FileStatus.st_size;
+#endif
+    MappingDataPointer = (const uint8_t*)ViewPointer;
+    return true;
+}
+
+void FileMappingBinary::UnmapBinaryFile() {
+    if (MappingDataPointer == nullptr) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(MappingDataPointer);
+    CloseHandle((HANDLE)MappingObjectHandle);
+    CloseHandle((HANDLE)MappingFileHandle);
+    MappingObjectHandle = nullptr;
+    MappingFileHandle   = nullptr;
+#else
+    munmap((void*)MappingDataPointer, MappingDataSize);
+    close(MappingFileDescriptor);
+    MappingFileDescriptor = -1;
+#endif
+    MappingDataPointer = nullptr;
+    MappingDataSize    = NULL;
+}
+
+bool FileStreamWriter::WriteDescriptor(const uint8_t* data, size_t bytes) {
+    while (bytes > NULL) {
+#if defined(_WIN32)
+        int WriteBytes = _write(StreamFileDescriptor, data, (unsigned int)bytes);
+#else
+        ssize_t WriteBytes = write(StreamFileDescriptor, data, bytes);
+        if (WriteBytes < 0 && errno == EINTR) continue;
+#endif
+        if (WriteBytes <= 0) return false;
+        // partial write => continue.
+        data  += WriteBytes;
+        bytes -= (size_t)WriteBytes;
+        StreamTotalBytes += (size_t)WriteBytes;
+    }
+    return true;
+}
+
+bool FileStreamWriter::OpenStreamFile(const string& filename, uint32_t flags, size_t chunk_bytes) {
+    CloseStreamFile();
+    StreamFlags = flags;
+    StreamTotalBytes = NULL;
+    // chunk size => multiple of alignment.
+    StreamChunkSize = max((chunk_bytes + FILE_STREAM_ALIGN - 1) / FILE_STREAM_ALIGN, (size_t)1) * FILE_STREAM_ALIGN;
+#if defined(_WIN32)
+    // windows: direct io not supported(crt descriptor), buffered write.
+    StreamFlags &= ~FILE_STREAM_DIRECT;
+    StreamFileDescriptor = _open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    int OpenFlags = O_WRONLY | O_CREAT | O_TRUNC;
+#if defined(O_DIRECT)
+    if (StreamFlags & FILE_STREAM_DIRECT)
+        StreamFileDescriptor = open(filename.c_str(), OpenFlags | O_DIRECT, 0644);
+#endif
+    // direct io unsupported(file system) => buffered write.
+    if (StreamFileDescriptor < 0) {
+        StreamFlags &= ~FILE_STREAM_DIRECT;
+        StreamFileDescriptor = open(filename.c_str(), OpenFlags, 0644);
+    }
+#endif
+    if (StreamFileDescriptor < 0) return false;
+
+    if (StreamFlags & FILE_STREAM_DIRECT) {
+#if !defined(_WIN32)
+        void* StagingPointer = nullptr;
+        if (posix_memalign(&StagingPointer, FILE_STREAM_ALIGN, StreamChunkSize) != 0) {
+            CloseStreamFile();
+            return false;
+        }
+        AlignedStaging = (uint8_t*)StagingPointer;
+#endif
+        AlignedStagingFill = NULL;
+    }
+    return true;
+}
+
+bool FileStreamWriter::WriteStreamData(const void* data, size_t bytes) {
+    if (StreamFileDescriptor < 0) return false;
+    const uint8_t* SourcePointer = (const uint8_t*)data;
+
+    while (bytes > NULL) {
+        if (!(StreamFlags & FILE_STREAM_DIRECT)) {
+            // buffered: chunk write from source, non-copy.
+            size_t ChunkBytes = min(bytes, StreamChunkSize);
+            if (!WriteDescriptor(SourcePointer, ChunkBytes)) return false;
+
+            SourcePointer += ChunkBytes;
+            bytes -= ChunkBytes;
+            continue;
+        }
+        // direct: aligned source & empty staging => write from source.
+        if (AlignedStagingFill == NULL && bytes >= StreamChunkSize &&
+            (uintptr_t)SourcePointer % FILE_STREAM_ALIGN == NULL
+        ) {
+            if (!WriteDescriptor(SourcePointer, StreamChunkSize)) return false;
+
+            SourcePointer += StreamChunkSize;
+            bytes -= StreamChunkSize;
+            continue;
+        }
+        size_t CopyBytes = min(bytes, StreamChunkSize - AlignedStagingFill);
+        memcpy(AlignedStaging + AlignedStagingFill, SourcePointer, CopyBytes);
+
+        AlignedStagingFill += CopyBytes;
+        SourcePointer += CopyBytes;
+        bytes -= CopyBytes;
+
+        if (AlignedStagingFill == StreamChunkSize) {
+            if (!WriteDescriptor(AlignedStaging, StreamChunkSize)) return false;
+            AlignedStagingFill = NULL;
+        }
+    }
+    return true;
+}
+
+bool FileStreamWriter::CloseStreamFile() {
+    if (StreamFileDescriptor < 0) return false;
+    bool ReturnStatus = true;
+#if defined(_WIN32)
+    if (StreamFlags & FILE_STREAM_SYNC)
+        ReturnStatus = _commit(StreamFileDescriptor) == 0;
+    _close(StreamFileDescriptor);
+#else
+    if (AlignedStagingFill > NULL) {
+        // tail(unaligned size) => buffered write.
+#if defined(O_DIRECT)
+        fcntl(StreamFileDescriptor, F_SETFL, fcntl(StreamFileDescriptor, F_GETFL) & ~O_DIRECT);
+#endif
+        ReturnStatus = WriteDescriptor(AlignedStaging, AlignedStagingFill);
+        AlignedStagingFill = NULL;
+    }
+    if (StreamFlags & FILE_STREAM_SYNC) {
+#if defined(__linux__)
+        ReturnStatus &= fdatasync(StreamFileDescriptor) == 0;
+#else
+        ReturnStatus &= fsync(StreamFileDescriptor) == 0;
+#endif
+    }
+    close(StreamFileDescriptor);
+    free(AlignedStaging);
+    AlignedStaging = nullptr;
+#endif
+    StreamFileDescriptor = -1;
+    return ReturnStatus;
+}
+
+bool FileStreamReader::OpenStreamFile(const string& filename) {
+    CloseStreamFile();
+#if defined(_WIN32)
+    StreamFileDescriptor = _open(filename.c_str(), _O_RDONLY | _O_BINARY);
+    if (StreamFileDescriptor < 0) return false;
+    StreamFileSize = (size_t)_lseeki64(StreamFileDescriptor, NULL, SEEK_END);
+#else
+    StreamFileDescriptor = open(filename.c_str(), O_RDONLY);
+    if (StreamFileDescriptor < 0) return false;
+
+    struct stat FileStatus = {};
+    if (fstat(StreamFileDescriptor, &FileStatus) != 0) {
+        CloseStreamFile();
+        return false;
+    }
+    StreamFileSize = (size_t)FileStatus.st_size;
+#endif
+    return true;
+}
+
+bool FileStreamReader::ReadStreamData(uint64_t offset, void* data, size_t bytes) {
+    if (StreamFileDescriptor < 0) return false;
+    uint8_t* TargetPointer = (uint8_t*)data;
+#if defined(_WIN32)
+    // windows(crt): seek + read, not thread-safe(shared position).
+    if (_lseeki64(StreamFileDescriptor, (__int64)offset, SEEK_SET) < 0) return false;
+#endif
+    while (bytes > NULL) {
+        // single read limit: 1 gib.
+        size_t ReadBlock = min(bytes, (size_t)1073741824);
+#if defined(_WIN32)
+        int ReadBytes = _read(StreamFileDescriptor, TargetPointer, (unsigned int)ReadBlock);
+#else
+        ssize_t ReadBytes = pread(StreamFileDescriptor, TargetPointer, ReadBlock, (off_t)offset);
+        if (ReadBytes < 0 && errno == EINTR) continue;
+#endif
+        if (ReadBytes <= 0) return false;
+        // partial read => continue.
+        TargetPointer += ReadBytes;
+        offset += (uint64_t)ReadBytes;
+        bytes  -= (size_t)ReadBytes;
+    }
+    return true;
+}
+
+void FileStreamReader::CloseStreamFile() {
+    if (StreamFileDescriptor < 0) return;
+#if defined(_WIN32)
+    _close(StreamFileDescriptor);
+#else
+    close(StreamFileDescriptor);
+#endif
+    StreamFileDescriptor = -1;
+    StreamFileSize = NULL;
+}
+
+// crc32c reflected polynomial.
+#define CRC32C_POLYNOMIAL 0x82F63B78u
+
+uint32_t FileChecksumCRC32C(const void* data, size_t bytes, uint32_t crc) {
+    const uint8_t* SourcePointer = (const uint8_t*)data;
+    crc = ~crc;
+#if defined(__SSE4_2__)
+#if defined(__x86_64__) || defined(_M_X64)
+    // 8 bytes / instruction.
+    while (bytes >= sizeof(uint64_t)) {
+        uint64_t Block = NULL;
+        memcpy(&Block, SourcePointer, sizeof(uint64_t));
+        crc = (uint32_t)_mm_crc32_u64(crc, Block);
+
+        SourcePointer += sizeof(uint64_t);
+        bytes -= sizeof(uint64_t);
+    }
+#else
+    // x86(32 bit): _mm_crc32_u64 unavailable, 4 bytes / instruction.
+    while (bytes >= sizeof(uint32_t)) {
+        uint32_t Block = NULL;
+        memcpy(&Block, SourcePointer, sizeof(uint32_t));
+        crc = _mm_crc32_u32(crc, Block);
+
+        SourcePointer += sizeof(uint32_t);
+        bytes -= sizeof(uint32_t);
+    }
+#endif
+    while (bytes-- > NULL)
+        crc = _mm_crc32_u8(crc, *SourcePointer++);
+#else
+    static const auto CRCTable = []() {
+        array<uint32_t, 256> TableTemp = {};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t Value = i;
+            for (int k = 0; k < 8; ++k)
+                Value = (Value >> 1) ^ (CRC32C_POLYNOMIAL & (0u - (Value & 1u)));
+            TableTemp[i] = Value;
+        }
+        return TableTemp;
+    }();
+    while (bytes-- > NULL)
+        crc = CRCTable[(crc ^ *SourcePointer++) & 0xFF] ^ (crc >> 8);
+#endif
+    return ~crc;
+}
+
 bool FileLoaderString::ReadStringFile(const std::string& filename) {
     ifstream FileRead(filename);
 
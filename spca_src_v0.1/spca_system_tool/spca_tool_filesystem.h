@@ -23,10 +23,97 @@ public:
         std::ios_base::openmode     mode = std::ios_base::out 
     );
 
-    std::vector<uint8_t> GetBinaryData() { return ReadBinaryDataTemp; };
-    size_t               GetTotalSize()  { return ReadBinaryDataSize; };
+    const std::vector<uint8_t>& GetBinaryData() { return ReadBinaryDataTemp; };
+    size_t                      GetTotalSize()  { return ReadBinaryDataSize; };
 };
 
+// read_only file mapping(mmap), non-copy: data pointer => file pages.
+class FileMappingBinary {
+protected:
+    const uint8_t* MappingDataPointer = nullptr;
+    size_t         MappingDataSize    = {};
+#if defined(_WIN32)
+    void* MappingFileHandle   = nullptr;
+    void* MappingObjectHandle = nullptr;
+#else
+    int MappingFileDescriptor = -1;
+#endif
+public:
+    FileMappingBinary() {};
+    ~FileMappingBinary() { UnmapBinaryFile(); };
+
+    FileMappingBinary(const FileMappingBinary&) = delete;
+    FileMappingBinary& operator=(const FileMappingBinary&) = delete;
+
+    // true:success, false:failed. sequential: hint sequential + willneed(prefetch).
+    bool MapBinaryFile(const std::string& filename, bool sequential = true);
+    void UnmapBinaryFile();
+
+    const uint8_t* GetMappingData() const { return MappingDataPointer; };
+    size_t         GetTotalSize()   const { return MappingDataSize; };
+};
+
+// stream writer flags.
+#define FILE_STREAM_DIRECT ((uint32_t)1 << 1) // bypass page cache. (linux: O_DIRECT)
+#define FILE_STREAM_SYNC   ((uint32_t)1 << 2) // close: flush data to device. (fdatasync)
+
+// direct io alignment & default chunk size(bytes).
+#define FILE_STREAM_ALIGN 4096
+#define FILE_STREAM_CHUNK ((size_t)8388608)
+
+// streaming binary writer, non-cache: write from source(large chunks).
+class FileStreamWriter {
+protected:
+    int      StreamFileDescriptor = -1;
+    uint32_t StreamFlags = {};
+    size_t   StreamChunkSize  = FILE_STREAM_CHUNK;
+    size_t   StreamTotalBytes = {};
+
+    // direct io: aligned staging(chunk size).
+    uint8_t* AlignedStaging     = nullptr;
+    size_t   AlignedStagingFill = {};
+
+    bool WriteDescriptor(const uint8_t* data, size_t bytes);
+public:
+    FileStreamWriter() {};
+    ~FileStreamWriter() { CloseStreamFile(); };
+
+    FileStreamWriter(const FileStreamWriter&) = delete;
+    FileStreamWriter& operator=(const FileStreamWriter&) = delete;
+
+    // true:success, false:failed. flags: FILE_STREAM_DIRECT | FILE_STREAM_SYNC.
+    bool OpenStreamFile(const std::string& filename, uint32_t flags = 0, size_t chunk_bytes = FILE_STREAM_CHUNK);
+    bool WriteStreamData(const void* data, size_t bytes);
+    // flush tail(direct io) => sync => close.
+    bool CloseStreamFile();
+
+    size_t GetTotalSize() { return StreamTotalBytes; };
+};
+
+// positional binary reader, non-cache: read(offset) => caller memory(aligned, mapped).
+class FileStreamReader {
+protected:
+    int    StreamFileDescriptor = -1;
+    size_t StreamFileSize = {};
+public:
+    FileStreamReader() {};
+    ~FileStreamReader() { CloseStreamFile(); };
+
+    FileStreamReader(const FileStreamReader&) = delete;
+    FileStreamReader& operator=(const FileStreamReader&) = delete;
+
+    // true:success, false:failed.
+    bool OpenStreamFile(const std::string& filename);
+    // read [offset, offset + bytes) => data, false: short read(eof).
+    bool ReadStreamData(uint64_t offset, void* data, size_t bytes);
+    void CloseStreamFile();
+
+    size_t GetTotalSize() { return StreamFileSize; };
+};
+
+// crc32c(castagnoli), sse4.2 crc32 instruction | table. "crc": continue value.
+uint32_t FileChecksumCRC32C(const void* data, size_t bytes, uint32_t crc = 0);
+
 class FileLoaderString {
 protected:
     std::string ReadStringDataTemp = {};
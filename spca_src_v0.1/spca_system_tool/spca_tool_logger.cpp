@@ -1,32 +1,167 @@
 // spca_tool_logger.
 #include <fstream>
 #include <thread>
-#include <queue>
+#include <atomic>
+#include <algorithm>
+#include <memory>
 #include <condition_variable>
 #include <filesystem>
 
 #include "spca_tool_logger.hpp"
+#include "spca_tool_topology.h"
 
 using namespace std;
 namespace PRLC = PSAG_LOGGER::ReadLogCache;
 
-vector<PRLC::LogCache> LogMessageCache = {};
-size_t LogWarringLines = NULL, LogErrorLines = NULL;
+// log cache: fixed ring(lines), full => overwrite oldest.
+#define LOGGER_CACHE_CAPACITY 16384
+
+vector<shared_ptr<const PRLC::LogCache>> LogMessageCache = {};
+size_t LogCacheCapacity = LOGGER_CACHE_CAPACITY;
+// total pushed lines, slot = position % capacity.
+size_t LogCachePosition = NULL;
+
+atomic<size_t> LogTotalLines = {}, LogWarringLines = {}, LogErrorLines = {};
 
 mutex LogMutex = {};
-queue<PRLC::LogCache> LogWriteQueue = {};
 
-#include <iomanip>
+// logger ring: bounded mpsc, capacity: pow2.
+#define LOGGER_RING_CAPACITY 8192
+#define LOGGER_BATCH_LINES   256
+
+// ring record, "CacheRecord": formatted line(shared with cache),
+// "DeferSite" != nullptr: "LogString" = encoded args(backend format).
+struct LogRingRecord {
+	string   LogString;
+	LOGLABEL LogLabel;
+
+	shared_ptr<const PRLC::LogCache> CacheRecord;
+
+	const PSAG_LOGGER::LoggerDeferSite* DeferSite;
+	// system_clock ticks.
+	int64_t TimeCode;
+};
+
+class LogRingBuffer {
+protected:
+	struct LogRingSlot {
+		// sequence: pos => writable, pos + 1 => readable.
+		atomic<size_t> Sequence;
+		LogRingRecord  Record;
+	};
+	unique_ptr<LogRingSlot[]> RingSlots = nullptr;
+
+	alignas(64) atomic<size_t> EnqueuePosition = {};
+	alignas(64) size_t         DequeuePosition = {};
+public:
+	LogRingBuffer() : RingSlots(new LogRingSlot[LOGGER_RING_CAPACITY]) {
+		for (size_t i = 0; i < LOGGER_RING_CAPACITY; ++i)
+			RingSlots[i].Sequence.store(i, memory_order_relaxed);
+	}
+	// producers(any thread), claimed slot => "write_record", false: ring full.
+	template <typename FnWrite>
+	bool TryPush(FnWrite&& write_record) {
+		size_t Position = EnqueuePosition.load(memory_order_relaxed);
+		while (true) {
+			LogRingSlot& Slot = RingSlots[Position & (LOGGER_RING_CAPACITY - 1)];
+			intptr_t Diff = (intptr_t)Slot.Sequence.load(memory_order_acquire) - (intptr_t)Position;
+
+			if (Diff == 0) {
+				// claim slot => write => publish.
+				if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, memory_order_relaxed)) {
+					write_record(Slot.Record);
+					Slot.Sequence.store(Position + 1, memory_order_release);
+					return true;
+				}
+			}
+			else if (Diff < 0)
+				return false;
+			else
+				Position = EnqueuePosition.load(memory_order_relaxed);
+		}
+	}
+	// consumer(logger thread) only, string swap: capacity reuse.
+	bool TryPop(LogRingRecord& record) {
+		LogRingSlot& Slot = RingSlots[DequeuePosition & (LOGGER_RING_CAPACITY - 1)];
+		if (Slot.Sequence.load(memory_order_acquire) != DequeuePosition + 1)
+			return false;
+		record.LogString.swap(Slot.Record.LogString);
+		record.CacheRecord = move(Slot.Record.CacheRecord);
+		record.LogLabel  = Slot.Record.LogLabel;
+		record.DeferSite = Slot.Record.DeferSite;
+		record.TimeCode  = Slot.Record.TimeCode;
+		// release slot => next lap.
+		Slot.Sequence.store(DequeuePosition + LOGGER_RING_CAPACITY, memory_order_release);
+		++DequeuePosition;
+		return true;
+	}
+	bool RingEmpty() {
+		LogRingSlot& Slot = RingSlots[DequeuePosition & (LOGGER_RING_CAPACITY - 1)];
+		return Slot.Sequence.load(memory_order_acquire) != DequeuePosition + 1;
+	}
+	// claimed slots(incl. unpublished) all popped, consumer only.
+	bool RingDrained() {
+		return EnqueuePosition.load(memory_order_acquire) == DequeuePosition;
+	}
+};
+
+// static init order: first use => construct.
+LogRingBuffer& LogWriteRing() {
+	static LogRingBuffer RingBuffer = {};
+	return RingBuffer;
+}
+// consumer park: producer notify(waiting only).
+mutex              LogWakeMutex     = {};
+condition_variable LogWakeCondition = {};
+atomic<bool>       LogConsumerWaiting = false;
+atomic<bool>       LogConsumerRunning = false;
+// ring full & consumer stopped => dropped.
+atomic<size_t> LogDroppedLines = {};
+
+atomic<int32_t>  LogFlushPolicyCode = (int32_t)PSAG_LOGGER::LogFlushBatch;
+atomic<uint32_t> LogFlushIntervalMs = 100;
+
+// => logger process(print), ring full: consumer running => wait, stopped => drop.
+template <typename FnWrite>
+void LogRingPush(FnWrite&& write_record) {
+	while (!LogWriteRing().TryPush(write_record)) {
+		if (!LogConsumerRunning.load(memory_order_acquire)) {
+			LogDroppedLines.fetch_add(1, memory_order_relaxed);
+			return;
+		}
+		LogWakeCondition.notify_one();
+		this_thread::yield();
+	}
+	// push visible => waiting flag(dekker), lost wakeup free.
+	atomic_thread_fence(memory_order_seq_cst);
+	if (LogConsumerWaiting.load(memory_order_relaxed)) {
+		lock_guard<mutex> WakeLock(LogWakeMutex);
+		LogWakeCondition.notify_one();
+	}
+}
+
+#include <ctime>
 // time [xxxx.xx.xx.xx:xx:xx:xx ms].
 string __get_timestamp(const chrono::system_clock::time_point& time_point) {
-	auto Time = std::chrono::system_clock::to_time_t(time_point);
-	auto TimeMs = std::chrono::duration_cast<chrono::milliseconds>(time_point.time_since_epoch()) % 1000;
-	// format time stamp.
-	stringstream SStream;
-	SStream << put_time(localtime(&Time), "%Y.%m.%d %H:%M:%S") << ".";
-	SStream << setfill('0') << setw(3) << TimeMs.count() << " ms";
-	// windows / linux time stamp.
-	return SStream.str();
+	time_t Time = chrono::system_clock::to_time_t(time_point);
+	auto TimeMs = chrono::duration_cast<chrono::milliseconds>(time_point.time_since_epoch()) % 1000;
+	// same second => cached date text(thread local).
+	thread_local time_t TimeCached = -1;
+	thread_local char   TimeText[32] = {};
+	if (Time != TimeCached) {
+		tm TimeLocal = {};
+		// windows / linux thread safe localtime.
+#if defined(_WIN32)
+		localtime_s(&TimeLocal, &Time);
+#else
+		localtime_r(&Time, &TimeLocal);
+#endif
+		strftime(TimeText, sizeof(TimeText), "%Y.%m.%d %H:%M:%S", &TimeLocal);
+		TimeCached = Time;
+	}
+	char StampText[48] = {};
+	snprintf(StampText, sizeof(StampText), "%s.%03d ms", TimeText, (int32_t)TimeMs.count());
+	return StampText;
 }
 
 string FMT_TIME_STAMP(const chrono::system_clock::time_point& time_point) {
@@ -55,14 +190,13 @@ string FMT_NUMBER_FILLZERO(uint32_t number, int32_t digits) {
 namespace PSAG_LOGGER {
 #include <io.h>
 #include <fcntl.h>
-	bool LOG_PRINT_SWITCH = true;
-
-	void PushLogProcess(const LOGLABEL& label, const std::string& module_name, const std::string& logstr_text) {
-		unique_lock<mutex> LogThreadLock(LogMutex);
-
-		if (label & LogWarning) { LogWarringLines++; };
-		if (label & LogError) { LogErrorLines++; };
+	atomic<bool> LOG_PRINT_SWITCH = true;
 
+	// [time]:[level]:[module]: text.
+	string FormatLogLine(
+		LOGLABEL label, const std::string& module_name, const std::string& logstr_text,
+		const chrono::system_clock::time_point& time_point
+	) {
 		const char* LogLEVEL = "[NULL]";
 		switch (label) {
 		case(LogError):   { LogLEVEL = "[ERROR]";   break; }
@@ -72,12 +206,169 @@ namespace PSAG_LOGGER {
 		case(LogPerfmac): { LogLEVEL = "[PERF]";    break; }
 		}
 		string FmtModuleName = "[" + module_name + "]: ";
-		string FmtModuleLog = "[" + __get_timestamp(chrono::system_clock::now()) + "]"
-			+ ":" + LogLEVEL + ":" + FmtModuleName + logstr_text;
+		return "[" + __get_timestamp(time_point) + "]" + ":" + LogLEVEL + ":" + FmtModuleName + logstr_text;
+	}
 
-		// => read logger chache & logger process(print).
-		LogMessageCache.push_back(PRLC::LogCache(FmtModuleLog, module_name, label));
-		LogWriteQueue.push(PRLC::LogCache(FmtModuleLog, module_name, label));
+	// => read logger chache(ring), counters: atomic.
+	// records => cache(one lock), evicted records => "cache_records"(free after unlock).
+	void PushLogCache(vector<shared_ptr<const PRLC::LogCache>>& cache_records) {
+		for (const auto& CacheRecord : cache_records) {
+			LogTotalLines.fetch_add(1, memory_order_relaxed);
+			if (CacheRecord->LogLabel & LogWarning) LogWarringLines.fetch_add(1, memory_order_relaxed);
+			if (CacheRecord->LogLabel & LogError)   LogErrorLines.fetch_add(1, memory_order_relaxed);
+		}
+		lock_guard<mutex> LogThreadLock(LogMutex);
+		if (LogMessageCache.size() != LogCacheCapacity)
+			LogMessageCache.resize(LogCacheCapacity);
+
+		for (auto& CacheRecord : cache_records) {
+			LogMessageCache[LogCachePosition % LogCacheCapacity].swap(CacheRecord);
+			++LogCachePosition;
+		}
+	}
+
+	void PushLogCache(const shared_ptr<const PRLC::LogCache>& cache_record) {
+		LogTotalLines.fetch_add(1, memory_order_relaxed);
+		if (cache_record->LogLabel & LogWarning) LogWarringLines.fetch_add(1, memory_order_relaxed);
+		if (cache_record->LogLabel & LogError)   LogErrorLines.fetch_add(1, memory_order_relaxed);
+
+		// evicted record: free after unlock.
+		shared_ptr<const PRLC::LogCache> EvictedRecord = nullptr;
+		lock_guard<mutex> LogThreadLock(LogMutex);
+		if (LogMessageCache.size() != LogCacheCapacity)
+			LogMessageCache.resize(LogCacheCapacity);
+
+		EvictedRecord = move(LogMessageCache[LogCachePosition % LogCacheCapacity]);
+		LogMessageCache[LogCachePosition % LogCacheCapacity] = cache_record;
+		++LogCachePosition;
+	}
+
+	void PushLogProcess(const LOGLABEL& label, const std::string& module_name, const std::string& logstr_text) {
+		auto CacheRecord = make_shared<const PRLC::LogCache>(
+			FormatLogLine(label, module_name, logstr_text, chrono::system_clock::now()), module_name, label
+		);
+		PushLogCache(CacheRecord);
+
+		LogRingPush([&](LogRingRecord& record) {
+			record.CacheRecord = move(CacheRecord);
+			record.LogLabel    = label;
+			record.DeferSite   = nullptr;
+		});
+	}
+
+	namespace LoggerDefer {
+		string& DeferRecordBuffer() {
+			thread_local string RecordBuffer = {};
+			return RecordBuffer;
+		}
+
+		template <typename T>
+		static bool DecodeDeferValue(const string& record, size_t& offset, T& value) {
+			if (offset + sizeof(T) > record.size()) return false;
+			memcpy(&value, record.data() + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+
+		// "log_text" conversions => printf(per arg), length modifier => stored type.
+		string FormatDeferRecord(const char* log_text, const string& record) {
+			string ResultText = {};
+			size_t RecordOffset = NULL;
+
+			auto AppendFormat = [&](const string& spec, auto value) {
+				int32_t Length = snprintf(nullptr, 0, spec.c_str(), value);
+				if (Length <= 0) return;
+				size_t SizeTemp = ResultText.size();
+				ResultText.resize(SizeTemp + (size_t)Length + 1);
+				snprintf(&ResultText[SizeTemp], (size_t)Length + 1, spec.c_str(), value);
+				ResultText.resize(SizeTemp + (size_t)Length);
+			};
+			for (const char* Char = log_text; *Char != '\0';) {
+				if (*Char != '%') { ResultText.push_back(*Char++); continue; }
+				if (Char[1] == '%') { ResultText.push_back('%'); Char += 2; continue; }
+
+				// spec: % flags width .precision (length) conversion.
+				const char* SpecBegin = Char++;
+				while (*Char != '\0' && strchr("-+ #0123456789.", *Char)) ++Char;
+				string SpecTemp(SpecBegin, Char);
+				while (*Char != '\0' && strchr("hljztL", *Char)) ++Char;
+
+				char Conversion = *Char;
+				if (Conversion == '\0') break;
+				++Char;
+
+				uint8_t ArgType = NULL;
+				if (!DecodeDeferValue(record, RecordOffset, ArgType)) {
+					ResultText.append("<?>");
+					continue;
+				}
+				bool ConvFloat = strchr("fFeEgGaA", Conversion) != nullptr;
+				bool ConvInt   = strchr("diouxXc", Conversion) != nullptr;
+
+				switch (ArgType) {
+				case(DeferArgSigned): case(DeferArgUnsigned): case(DeferArgPointer): {
+					uint64_t ValueTemp = NULL;
+					if (!DecodeDeferValue(record, RecordOffset, ValueTemp)) return ResultText;
+
+					if (ConvFloat)
+						AppendFormat(SpecTemp + Conversion, ArgType == DeferArgSigned ? (double)(int64_t)ValueTemp : (double)ValueTemp);
+					else if (Conversion == 'c')
+						AppendFormat(SpecTemp + 'c', (int32_t)ValueTemp);
+					else if (Conversion == 'p')
+						AppendFormat(SpecTemp + 'p', (void*)(uintptr_t)ValueTemp);
+					else if (Conversion == 'd' || Conversion == 'i')
+						AppendFormat(SpecTemp + "ll" + Conversion, (long long)ValueTemp);
+					else if (ConvInt)
+						AppendFormat(SpecTemp + "ll" + Conversion, (unsigned long long)ValueTemp);
+					else
+						ResultText.append("<?>");
+					break;
+				}
+				case(DeferArgFloat): {
+					double ValueTemp = 0.0;
+					if (!DecodeDeferValue(record, RecordOffset, ValueTemp)) return ResultText;
+
+					if (ConvFloat)
+						AppendFormat(SpecTemp + Conversion, ValueTemp);
+					else if (ConvInt)
+						AppendFormat(SpecTemp + "lld", (long long)ValueTemp);
+					else
+						ResultText.append("<?>");
+					break;
+				}
+				case(DeferArgString): {
+					uint32_t LengthTemp = NULL;
+					if (!DecodeDeferValue(record, RecordOffset, LengthTemp) || RecordOffset + LengthTemp > record.size())
+						return ResultText;
+					string StringTemp = record.substr(RecordOffset, LengthTemp);
+					RecordOffset += LengthTemp;
+
+					if (Conversion == 's')
+						AppendFormat(SpecTemp + 's', StringTemp.c_str());
+					else
+						ResultText.append("<?>");
+					break;
+				}
+				default: return ResultText;
+				}
+			}
+			return ResultText;
+		}
+
+		void PushDeferRecord(const LoggerDeferSite* site, string& record) {
+			auto TimePoint = chrono::system_clock::now();
+			// consumer stopped => format(caller thread).
+			if (!LogConsumerRunning.load(memory_order_acquire)) {
+				PushLogProcess(site->LogLabel, site->ModuleLabel, FormatDeferRecord(site->LogText, record));
+				return;
+			}
+			LogRingPush([&](LogRingRecord& ring_record) {
+				ring_record.LogString.assign(record);
+				ring_record.LogLabel  = site->LogLabel;
+				ring_record.DeferSite = site;
+				ring_record.TimeCode  = (int64_t)TimePoint.time_since_epoch().count();
+			});
+		}
 	}
 
 #define LOGGER_BUFFER_LEN 2048
@@ -95,34 +386,60 @@ namespace PSAG_LOGGER {
 	}
 
 	void SET_PRINTLOG_STATE(bool status_flag) {
-		lock_guard<mutex> LogThreadLock(LogMutex);
-		LOG_PRINT_SWITCH = status_flag;
+		LOG_PRINT_SWITCH.store(status_flag, memory_order_relaxed);
 	};
 
+	void SET_LOGFLUSH_POLICY(LOGFLUSH policy, uint32_t interval_ms) {
+		LogFlushPolicyCode.store((int32_t)policy, memory_order_relaxed);
+		LogFlushIntervalMs.store(interval_ms > NULL ? interval_ms : 1, memory_order_relaxed);
+	}
+
+	void SET_LOGCACHE_CAPACITY(size_t lines) {
+		lines = max(lines, (size_t)1);
+		// old ring: free after unlock.
+		vector<shared_ptr<const PRLC::LogCache>> CacheTemp = {};
+
+		lock_guard<mutex> LogThreadLock(LogMutex);
+		size_t KeepLines = min({ lines, LogCachePosition, LogCacheCapacity });
+		// newest lines => new ring(keep order).
+		CacheTemp.reserve(lines);
+		for (size_t i = LogCachePosition - KeepLines; i < LogCachePosition; ++i)
+			CacheTemp.push_back(move(LogMessageCache[i % LogCacheCapacity]));
+		CacheTemp.resize(lines);
+
+		LogMessageCache.swap(CacheTemp);
+		LogCachePosition = KeepLines;
+		LogCacheCapacity = lines;
+	}
+
 	Vector3T<size_t> LogLinesStatistics() {
 		Vector3T<size_t> ReturnValue = {};
-		{
-			lock_guard<mutex> LogThreadLock(LogMutex);
-			// log lines counting.
-			ReturnValue.vector_x = LogMessageCache.size(); // total   lines.
-			ReturnValue.vector_y = LogWarringLines;        // warning lines.
-			ReturnValue.vector_z = LogErrorLines;          // error   lines.
-		}
+		// log lines counting.
+		ReturnValue.vector_x = LogTotalLines.load(memory_order_relaxed);   // total   lines.
+		ReturnValue.vector_y = LogWarringLines.load(memory_order_relaxed); // warning lines.
+		ReturnValue.vector_z = LogErrorLines.load(memory_order_relaxed);   // error   lines.
 		return ReturnValue;
 	}
 
 	namespace ReadLogCache {
+		vector<shared_ptr<const LogCache>> ExtractLogSnapshot(size_t lines) {
+			vector<shared_ptr<const LogCache>> ReturnSnapshot = {};
+
+			lock_guard<mutex> LogThreadLock(LogMutex);
+			size_t CacheLines = min(LogCachePosition, LogCacheCapacity);
+			lines = min(lines, CacheLines);
+
+			ReturnSnapshot.reserve(lines);
+			for (size_t i = LogCachePosition - lines; i < LogCachePosition; ++i)
+				ReturnSnapshot.push_back(LogMessageCache[i % LogCacheCapacity]);
+			return ReturnSnapshot;
+		}
+
 		vector<LogCache> ExtractLogSegment(const uint32_t& lines) {
 			vector<LogCache> ReturnLogCache = {};
-			{
-				size_t RetLinesCount =
-					((int64_t)LogMessageCache.size() - lines - 1) >= 0 ?
-					((int64_t)LogMessageCache.size() - lines - 1) : 0;
-
-				lock_guard<mutex> LogThreadLock(LogMutex);
-				for (size_t i = RetLinesCount; i < LogMessageCache.size(); ++i)
-					ReturnLogCache.push_back(LogMessageCache[i]);
-			}
+			// back - lines(+ 1).
+			for (const auto& CacheRecord : ExtractLogSnapshot((size_t)lines + 1))
+				ReturnLogCache.push_back(*CacheRecord);
 			return ReturnLogCache;
 		}
 	}
@@ -138,8 +455,10 @@ namespace PSAG_LOGGER {
 #define LOGFILE_EXTENSION ".log"
 namespace PSAG_LOGGER_PROCESS {
 
-	thread* LogProcessThread = {};
-	bool    LogProcessFlag = true;
+	thread*      LogProcessThread = {};
+	atomic<bool> LogProcessFlag   = true;
+	// logger thread cpus(empty: os scheduler).
+	vector<uint32_t> LogThreadAffinity = {};
 
 	void process_printwrite_file_eventloop(const char* folder) {
 		// create name: folder + name(time) + extensions.
@@ -151,25 +470,93 @@ namespace PSAG_LOGGER_PROCESS {
 
 		fstream WriteLogFile(FileNameTemp, ios::out | ios::app);
 		PSAG_LOGGER::PushLogger(LogInfo, PSAG_LOGGER_LABEL, "create file: %s", FileNameTemp.c_str());
+		// consumer running => producers wait(ring full).
+		LogConsumerRunning.store(true, memory_order_release);
+
+		string FileBatch = {}, PrintBatch = {};
+		LogRingRecord LogRecord = {};
+		// deferred records(batch) => cache, one lock.
+		vector<shared_ptr<const PRLC::LogCache>> CacheBatch = {};
+		CacheBatch.reserve(LOGGER_BATCH_LINES);
 
-		while (LogProcessFlag) {
-			unique_lock<mutex> LogThreadLock(LogMutex);
-			// read log cache queue.
-			while (!LogWriteQueue.empty()) {
-				const PRLC::LogCache& LogMsgTemp = LogWriteQueue.front();
+		auto LastFlushTime = chrono::steady_clock::now();
+		bool FlushPending  = false;
 
-				WriteLogFile << LogMsgTemp.LogString << endl;
+		while (true) {
+			size_t BatchLines = NULL;
+			bool   BatchError = false;
+			// ring => batch(lines), one write.
+			while (BatchLines < LOGGER_BATCH_LINES && LogWriteRing().TryPop(LogRecord)) {
+				LOGLABEL LogLabel = LogRecord.LogLabel;
+				if (LogRecord.DeferSite != nullptr) {
+					// deferred record => format(backend) => cache.
+					const PSAG_LOGGER::LoggerDeferSite* Site = LogRecord.DeferSite;
+					LogRecord.CacheRecord = make_shared<const PRLC::LogCache>(
+						PSAG_LOGGER::FormatLogLine(
+							LogLabel, Site->ModuleLabel,
+							PSAG_LOGGER::LoggerDefer::FormatDeferRecord(Site->LogText, LogRecord.LogString),
+							chrono::system_clock::time_point(chrono::system_clock::duration(LogRecord.TimeCode))
+						), Site->ModuleLabel, LogLabel
+					);
+					CacheBatch.push_back(LogRecord.CacheRecord);
+				}
+				const string& LogString = LogRecord.CacheRecord->LogString;
+				FileBatch.append(LogString).push_back('\n');
 				// print color_log entry.
 #if PSAG_DEBUG_MODE
-				auto FindLevelColor = HashLogLevel.find(LogMsgTemp.LogLabel);
-				if (FindLevelColor != HashLogLevel.end() && PSAG_LOGGER::LOG_PRINT_SWITCH)
-					cout << FindLevelColor->second << LogMsgTemp.LogString << " \033[0m" << endl;
+				auto FindLevelColor = HashLogLevel.find(LogLabel);
+				if (FindLevelColor != HashLogLevel.end() && PSAG_LOGGER::LOG_PRINT_SWITCH.load(memory_order_relaxed))
+					PrintBatch.append(FindLevelColor->second).append(LogString).append(" \033[0m\n");
 #endif
-				// delete log_message item.
-				LogWriteQueue.pop();
+				BatchError |= (LogLabel & LogError) != NULL;
+				++BatchLines;
+			}
+			if (!CacheBatch.empty()) {
+				PSAG_LOGGER::PushLogCache(CacheBatch);
+				CacheBatch.clear();
+			}
+			if (BatchLines > NULL) {
+				WriteLogFile.write(FileBatch.data(), FileBatch.size());
+				if (!PrintBatch.empty()) {
+					cout.write(PrintBatch.data(), PrintBatch.size());
+					cout.flush();
+				}
+				FileBatch.clear();
+				PrintBatch.clear();
+				FlushPending = true;
+			}
+			// flush policy: batch | error | interval.
+			auto TimeNow = chrono::steady_clock::now();
+			int32_t FlushPolicy = LogFlushPolicyCode.load(memory_order_relaxed);
+			chrono::milliseconds FlushInterval(LogFlushIntervalMs.load(memory_order_relaxed));
+
+			if (FlushPending && (FlushPolicy == PSAG_LOGGER::LogFlushBatch ||
+				(FlushPolicy == PSAG_LOGGER::LogFlushError && BatchError) || TimeNow - LastFlushTime >= FlushInterval)
+			) {
+				WriteLogFile.flush();
+				LastFlushTime = TimeNow;
+				FlushPending  = false;
 			}
-			LogThreadLock.unlock();
+			// batch full => ring non-empty.
+			if (BatchLines == LOGGER_BATCH_LINES) continue;
+			// stop: claimed == popped(producer publishing => wait) => exit.
+			if (!LogProcessFlag.load(memory_order_acquire)) {
+				if (LogWriteRing().RingDrained()) break;
+				this_thread::yield();
+				continue;
+			}
+			// park: producer notify | interval(flush) timeout.
+			unique_lock<mutex> WakeLock(LogWakeMutex);
+			LogConsumerWaiting.store(true, memory_order_relaxed);
+			atomic_thread_fence(memory_order_seq_cst);
+			LogWakeCondition.wait_for(WakeLock, FlushInterval, [] {
+				return !LogWriteRing().RingEmpty() || !LogProcessFlag.load(memory_order_acquire);
+			});
+			LogConsumerWaiting.store(false, memory_order_relaxed);
 		}
+		size_t DroppedLines = LogDroppedLines.exchange(NULL);
+		if (DroppedLines > NULL)
+			WriteLogFile << "[" << PSAG_LOGGER_LABEL << "]: ring full(stopped), dropped lines: " << DroppedLines << "\n";
 		WriteLogFile.close();
 	}
 
@@ -186,21 +573,42 @@ namespace PSAG_LOGGER_PROCESS {
 		}
 		// init logger_thread.
 		try {
+			LogProcessFlag.store(true, memory_order_release);
 			LogProcessThread = new thread(process_printwrite_file_eventloop, folder);
+			if (!LogThreadAffinity.empty())
+				SpcaTopology::SetThreadAffinity(LogProcessThread->native_handle(), LogThreadAffinity);
 			PSAG_LOGGER::PushLogger(LogInfo, PSAG_LOGGER_LABEL, "start thread success.");
 		}
 		catch (const exception& err) {
+			LogConsumerRunning.store(false, memory_order_release);
 			PSAG_LOGGER::PushLogger(LogError, PSAG_LOGGER_LABEL, "start thread error: %s", err.what());
 			return false;
 		}
 		return true;
 	}
 
+	bool SetLogProcessingAffinity(const vector<uint32_t>& cpus) {
+		LogThreadAffinity = cpus;
+		// not started => apply at start.
+		if (LogProcessThread == nullptr)
+			return true;
+		return SpcaTopology::SetThreadAffinity(LogProcessThread->native_handle(), cpus);
+	}
+
 	bool FreeLogProcessing() {
-		LogProcessFlag = false;
+		if (LogProcessThread == nullptr) return false;
+		{
+			// set_flag => wake consumer(drain ring).
+			lock_guard<mutex> WakeLock(LogWakeMutex);
+			LogProcessFlag.store(false, memory_order_release);
+		}
+		LogWakeCondition.notify_one();
 		try {
 			// set_flag  => join_thread.
 			LogProcessThread->join();
+			delete LogProcessThread;
+			LogProcessThread = nullptr;
+			LogConsumerRunning.store(false, memory_order_release);
 			PSAG_LOGGER::PushLogger(LogInfo, PSAG_LOGGER_LABEL, "free thread success.");
 		}
 		catch (const exception& err) {
@@ -8,9 +8,14 @@
 #include <sstream>
 #include <chrono>
 #include <cstdarg>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #ifndef IS_POMELO_STAR_GAME2D
 #include <string>
+#include <vector>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -41,6 +46,19 @@ struct Vector3T {
 #endif
 StaticStrLABEL PSAG_LOGGER_LABEL = "PSAG_LOGGER";
 
+// compile time label filter, default: all labels. (release: LogError | LogWarning)
+#ifndef PSAG_LOGGER_LEVEL_MASK
+#define PSAG_LOGGER_LEVEL_MASK (LogError | LogWarning | LogInfo | LogTrace | LogPerfmac)
+#endif
+// deferred(binary) logger: "label" constant, "log_text" literal.
+// args: integral | float | pointer | c_string, label & mask = 0 => no code.
+#define PSAG_LOGGER_DEFER(label, module_label, log_text, ...) do { \
+	if constexpr (PSAG_DEBUG_MODE && ((label) & (PSAG_LOGGER_LEVEL_MASK)) != 0) { \
+		static const PSAG_LOGGER::LoggerDeferSite LoggerDeferSiteTemp = { label, module_label, log_text }; \
+		PSAG_LOGGER::PushLoggerDefer(&LoggerDeferSiteTemp, ##__VA_ARGS__); \
+	} \
+} while (false)
+
 // format number => string, %d(fill_zero).
 std::string FMT_NUMBER_FILLZERO(uint32_t number, int32_t digits);
 // format time_point: "[xxxx.xx.xx.xx:xx:xx:xx ms]".
@@ -52,8 +70,76 @@ namespace PSAG_LOGGER {
 	// @param label, module_label, text, params. [20231205]
 	void PushLogger(const LOGLABEL& label, const char* module_label, const char* log_text, ...);
 
+	// deferred logger call site(static): label, module, format.
+	struct LoggerDeferSite {
+		LOGLABEL    LogLabel;
+		const char* ModuleLabel;
+		const char* LogText;
+	};
+	namespace LoggerDefer {
+		enum DeferArgTYPE :uint8_t {
+			DeferArgSigned   = 1,
+			DeferArgUnsigned = 2,
+			DeferArgFloat    = 3,
+			DeferArgPointer  = 4,
+			DeferArgString   = 5
+		};
+		// thread local record buffer(reuse).
+		std::string& DeferRecordBuffer();
+		// record => ring(backend format), consumer stopped: format now.
+		void PushDeferRecord(const LoggerDeferSite* site, std::string& record);
+
+		// record: [type][value], string: [type][u32 length][bytes].
+		template <typename T>
+		void EncodeDeferArg(std::string& record, T value) {
+			if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+				const char* StringTemp = value != nullptr ? value : "(null)";
+				uint32_t LengthTemp = (uint32_t)strlen(StringTemp);
+				record.push_back((char)DeferArgString);
+				record.append((const char*)&LengthTemp, sizeof(uint32_t)).append(StringTemp, LengthTemp);
+			}
+			else if constexpr (std::is_enum_v<T>)
+				EncodeDeferArg(record, (std::underlying_type_t<T>)value);
+			else if constexpr (std::is_floating_point_v<T>) {
+				double ValueTemp = (double)value;
+				record.push_back((char)DeferArgFloat);
+				record.append((const char*)&ValueTemp, sizeof(double));
+			}
+			else if constexpr (std::is_integral_v<T> || std::is_pointer_v<T>) {
+				uint64_t ValueTemp = NULL;
+				if constexpr (std::is_pointer_v<T>) ValueTemp = (uint64_t)(uintptr_t)value;
+				else ValueTemp = (uint64_t)(int64_t)value;
+
+				record.push_back((char)(std::is_pointer_v<T> ? DeferArgPointer :
+					std::is_signed_v<T> ? DeferArgSigned : DeferArgUnsigned));
+				record.append((const char*)&ValueTemp, sizeof(uint64_t));
+			}
+			else
+				static_assert(sizeof(T) == 0, "logger defer: unsupported argument type.");
+		}
+	}
+	// raw args => thread local record => ring, format: logger thread.
+	template <typename... ARGS>
+	void PushLoggerDefer(const LoggerDeferSite* site, const ARGS&... args) {
+		std::string& RecordTemp = LoggerDefer::DeferRecordBuffer();
+		RecordTemp.clear();
+		(LoggerDefer::EncodeDeferArg<std::decay_t<const ARGS&>>(RecordTemp, args), ...);
+		LoggerDefer::PushDeferRecord(site, RecordTemp);
+	}
+
 	// false: not printing on the console.
 	void SET_PRINTLOG_STATE(bool status_flag);
+	// log cache ring capacity(lines), default: 16384, keep newest lines.
+	void SET_LOGCACHE_CAPACITY(size_t lines);
+
+	// logger file flush policy.
+	enum LOGFLUSH {
+		LogFlushBatch    = 1 << 1, // flush per batch(write).
+		LogFlushInterval = 1 << 2, // flush per interval(ms).
+		LogFlushError    = 1 << 3  // batch(error) => flush, other: interval.
+	};
+	// default: LogFlushBatch, interval: 100ms(consumer wake).
+	void SET_LOGFLUSH_POLICY(LOGFLUSH policy, uint32_t interval_ms = 100);
 
 	// @return Vector3T<size_t> (x : lines, y : warring, z : error)
 	Vector3T<size_t> LogLinesStatistics();
@@ -72,6 +158,8 @@ namespace PSAG_LOGGER {
 		// @param  uint32_t, back - lines.
 		// @return string
 		std::vector<LogCache> ExtractLogSegment(const uint32_t& lines);
+		// newest "lines"(<= capacity) records, shared(non-copy strings), old => new.
+		std::vector<std::shared_ptr<const LogCache>> ExtractLogSnapshot(size_t lines);
 	}
 	// get src time[nanoseconds].
 	size_t GetTimeCountNow();
@@ -81,6 +169,8 @@ namespace PSAG_LOGGER_PROCESS {
 	// async thread process. write folder & print.
 	bool StartLogProcessing(const char* folder);
 	bool FreeLogProcessing();
+	// logger thread => cpus(empty: all cpus), before start: applied at start.
+	bool SetLogProcessingAffinity(const std::vector<uint32_t>& cpus);
 }
 
 // framework global generate_key.
@@ -231,6 +231,147 @@ public:
 	}
 };
 
+// index_matrix view 1d,2d,3d, non-owning(read only).
+// data lifetime: owner(file mapping, matrix) > view.
+template<typename SpcaDataType>
+class SpcaMatrixView {
+protected:
+	const SpcaDataType* ViewDataPointer = nullptr;
+
+	SpcaMatrixMode IndexMatrixMode = SPCA_TYPE_MATRIX1D;
+	// data_dim(size_t): x,y,z.
+	size_t IndexMatrixDim[3] = {};
+public:
+	SpcaMatrixView() {}
+	SpcaMatrixView(SpcaMatrixMode matmode, const SpcaDataType* data, size_t dimx, size_t dimy = NULL, size_t dimz = NULL) :
+		ViewDataPointer(data), IndexMatrixMode(matmode), IndexMatrixDim{ dimx, dimy, dimz }
+	{}
+	// view => index_matrix storage.
+	SpcaMatrixView(SpcaIndexMatrix<SpcaDataType>& matrix) :
+		ViewDataPointer(matrix.GetIMatrixRawData()->data()), IndexMatrixMode(matrix.GetIMatrixMode()),
+		IndexMatrixDim{ matrix.GetIMatrixDimParam(0), matrix.GetIMatrixDimParam(1), matrix.GetIMatrixDimParam(2) }
+	{}
+
+	const SpcaDataType* IMatrixAddressing1D(size_t map_i) const {
+		return &ViewDataPointer[map_i];
+	}
+	const SpcaDataType* IMatrixAddressing2D(size_t map_i, size_t map_j) const {
+		return &ViewDataPointer[map_i * IndexMatrixDim[1] + map_j];
+	}
+	const SpcaDataType* IMatrixAddressing3D(size_t map_i, size_t map_j, size_t map_k) const {
+		return &ViewDataPointer[map_i * IndexMatrixDim[1] * IndexMatrixDim[2] + map_j * IndexMatrixDim[1] + map_k];
+	}
+
+	// view => index_matrix(same mode), one bulk copy.
+	int IMatrixCopyTo(SpcaIndexMatrix<SpcaDataType>& matrix) const {
+		if (ViewDataPointer == nullptr || matrix.GetIMatrixMode() != IndexMatrixMode) return SPCA_MATRIX_FAILED;
+		if (matrix.GetIMatrixSizeBytes() > NULL) matrix.IMatrixFree();
+
+		if (!matrix.IMatrixAlloc(IndexMatrixDim[0], IndexMatrixDim[1], IndexMatrixDim[2]))
+			return SPCA_MATRIX_FAILED;
+		std::memcpy(matrix.GetIMatrixRawData()->data(), ViewDataPointer, matrix.GetIMatrixSizeBytes());
+		return SPCA_MATRIX_SUCCESS;
+	}
+
+	// matrix 0:x, 1:y, 2:z.
+	size_t GetIMatrixDimParam(size_t dimindex) const {
+		if (dimindex > 2) dimindex = 2;
+		return IndexMatrixDim[dimindex];
+	}
+	SpcaMatrixMode GetIMatrixMode() const { return IndexMatrixMode; }
+	// matrix element count(mode dims).
+	size_t GetIMatrixLength() const {
+		if (IndexMatrixMode == SPCA_TYPE_MATRIX1D) return IndexMatrixDim[0];
+		if (IndexMatrixMode == SPCA_TYPE_MATRIX2D) return IndexMatrixDim[0] * IndexMatrixDim[1];
+		return IndexMatrixDim[0] * IndexMatrixDim[1] * IndexMatrixDim[2];
+	}
+	size_t GetIMatrixSizeBytes() const { 
+		return ViewDataPointer != nullptr ? GetIMatrixLength() * sizeof(SpcaDataType) : NULL;
+	}
+	// warning: src_data pointer(non-owning).
+	const SpcaDataType* GetIMatrixViewData() const { return ViewDataPointer; }
+};
+
+// matrix2d batch(ragged), packed buffer + offsets table.
+// table item(uint32 x4): offset(elements), dim.x, dim.y, 0.
+template<typename SpcaDataType>
+class SpcaMatrixBatch {
+protected:
+	std::vector<SpcaDataType> PackedDataArray = {};
+	std::vector<uint32_t>     OffsetsTable    = {};
+	// batch max dim: x,y. (ndrange global size)
+	size_t BatchMaxDim[2] = {};
+
+	void BatchPushTable(size_t dimx, size_t dimy) {
+		OffsetsTable.push_back((uint32_t)PackedDataArray.size());
+		OffsetsTable.push_back((uint32_t)dimx);
+		OffsetsTable.push_back((uint32_t)dimy);
+		OffsetsTable.push_back(NULL);
+
+		BatchMaxDim[0] = dimx > BatchMaxDim[0] ? dimx : BatchMaxDim[0];
+		BatchMaxDim[1] = dimy > BatchMaxDim[1] ? dimy : BatchMaxDim[1];
+	}
+public:
+	// push matrix2d data => packed buffer.
+	int BatchPushMatrix(SpcaIndexMatrix<SpcaDataType>& matrix) {
+		if (matrix.GetIMatrixMode() != SPCA_TYPE_MATRIX2D) return SPCA_MATRIX_FAILED;
+		if (PackedDataArray.size() + matrix.GetIMatrixRawData()->size() > SPCA_SYS_MATRIX_MAXSIZE)
+			return SPCA_MATRIX_FAILED;
+
+		BatchPushTable(matrix.GetIMatrixDimParam(0), matrix.GetIMatrixDimParam(1));
+		PackedDataArray.insert(PackedDataArray.end(),
+			matrix.GetIMatrixRawData()->begin(), matrix.GetIMatrixRawData()->end());
+		return SPCA_MATRIX_SUCCESS;
+	}
+	// push matrix2d shape(non data), output batch.
+	int BatchPushShape(size_t dimx, size_t dimy) {
+		if (PackedDataArray.size() + dimx * dimy > SPCA_SYS_MATRIX_MAXSIZE) return SPCA_MATRIX_FAILED;
+
+		BatchPushTable(dimx, dimy);
+		PackedDataArray.resize(PackedDataArray.size() + dimx * dimy);
+		return SPCA_MATRIX_SUCCESS;
+	}
+
+	// packed(result) matrix2d(total,1) => matrix2d items.
+	int BatchUnpack(SpcaIndexMatrix<SpcaDataType>& packed, std::vector<SpcaIndexMatrix<SpcaDataType>>& items) {
+		if (packed.GetIMatrixRawData()->size() < PackedDataArray.size()) return SPCA_MATRIX_FAILED;
+		items.clear();
+
+		for (size_t i = 0; i < OffsetsTable.size(); i += 4) {
+			SpcaIndexMatrix<SpcaDataType> ItemMatrix(SPCA_TYPE_MATRIX2D);
+			ItemMatrix.IMatrixAlloc(OffsetsTable[i + 1], OffsetsTable[i + 2]);
+
+			auto Begin = packed.GetIMatrixRawData()->begin() + OffsetsTable[i];
+			std::copy(Begin, Begin + ItemMatrix.GetIMatrixRawData()->size(), ItemMatrix.GetIMatrixRawData()->begin());
+			items.push_back(std::move(ItemMatrix));
+		}
+		return SPCA_MATRIX_SUCCESS;
+	}
+
+	size_t BatchClear() {
+		size_t DataSizeBytes = GetBatchSizeBytes();
+		PackedDataArray.clear(); PackedDataArray.shrink_to_fit();
+		OffsetsTable.clear();    OffsetsTable.shrink_to_fit();
+
+		BatchMaxDim[0] = NULL;
+		BatchMaxDim[1] = NULL;
+		return DataSizeBytes;
+	}
+
+	size_t GetBatchCount() { return OffsetsTable.size() / 4; }
+	// batch 0:x, 1:y.
+	size_t GetBatchMaxDimParam(size_t dimindex) {
+		if (dimindex > 1) dimindex = 1;
+		return BatchMaxDim[dimindex];
+	}
+	size_t GetBatchSizeBytes() {
+		return PackedDataArray.size() * sizeof(SpcaDataType) + OffsetsTable.size() * sizeof(uint32_t);
+	}
+	// warning: src_data pointer.
+	std::vector<SpcaDataType>* GetBatchPackedData()   { return &PackedDataArray; }
+	std::vector<uint32_t>*     GetBatchOffsetsTable() { return &OffsetsTable; }
+};
+
 // ݵ(ӡ), WARN: ӡ;.
 namespace MatrixDebug {
 	// debug print matrix 1d dataset.
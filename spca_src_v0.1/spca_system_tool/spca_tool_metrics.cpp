@@ -0,0 +1,365 @@
+// spca_tool_metrics.
+#include "spca_tool_metrics.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "spca_tool_logger.hpp"
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#define METRICS_SOCKET_CLOSE(s) closesocket((SOCKET)(s))
+#else
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#define METRICS_SOCKET_CLOSE(s) close((int)(s))
+#endif
+
+using namespace std;
+
+// scrape request header limit.
+#define METRICS_REQUEST_LIMIT 4096
+
+namespace SpcaMetrics {
+    atomic<size_t> MetricShardCounter = {};
+
+    size_t MetricShardIndex() {
+        thread_local size_t ShardIndex = MetricShardCounter.fetch_add(1, memory_order_relaxed) & (SPCA_METRICS_SHARDS - 1);
+        return ShardIndex;
+    }
+
+    uint64_t Counter::GetValue() const {
+        uint64_t ValueTemp = NULL;
+        for (const auto& Shard : CounterShards)
+            ValueTemp += Shard.Value.load(memory_order_relaxed);
+        return ValueTemp;
+    }
+
+    Histogram::Histogram(const vector<double>& bounds) : BucketBounds(bounds) {
+        sort(BucketBounds.begin(), BucketBounds.end());
+        for (auto& Shard : HistogramShards) {
+            // bounds + inf.
+            Shard.BucketCounts.reset(new atomic<uint64_t>[BucketBounds.size() + 1]);
+            for (size_t i = 0; i <= BucketBounds.size(); ++i)
+                Shard.BucketCounts[i].store(NULL, memory_order_relaxed);
+        }
+    }
+
+    void Histogram::Observe(double value) {
+        HistogramShard& Shard = HistogramShards[MetricShardIndex()];
+        size_t Bucket = size_t(lower_bound(BucketBounds.begin(), BucketBounds.end(), value) - BucketBounds.begin());
+
+        Shard.BucketCounts[Bucket].fetch_add(1, memory_order_relaxed);
+        Shard.SampleCount.fetch_add(1, memory_order_relaxed);
+        // shard(low contention) => cas add.
+        double SumTemp = Shard.SampleSum.load(memory_order_relaxed);
+        while (!Shard.SampleSum.compare_exchange_weak(SumTemp, SumTemp + value, memory_order_relaxed)) {}
+    }
+
+    void Histogram::GetValue(vector<uint64_t>& buckets, uint64_t& count, double& sum) const {
+        buckets.assign(BucketBounds.size() + 1, NULL);
+        count = NULL;
+        sum = 0.0;
+        for (const auto& Shard : HistogramShards) {
+            for (size_t i = 0; i <= BucketBounds.size(); ++i)
+                buckets[i] += Shard.BucketCounts[i].load(memory_order_relaxed);
+            count += Shard.SampleCount.load(memory_order_relaxed);
+            sum   += Shard.SampleSum.load(memory_order_relaxed);
+        }
+        // cumulative(le).
+        for (size_t i = 1; i < buckets.size(); ++i)
+            buckets[i] += buckets[i - 1];
+    }
+
+    vector<double> ExponentialBounds(double start, double factor, size_t count) {
+        vector<double> BoundsTemp = {};
+        for (size_t i = 0; i < count; ++i, start *= factor)
+            BoundsTemp.push_back(start);
+        return BoundsTemp;
+    }
+
+    MetricsRegistry::MetricEntry* MetricsRegistry::FindOrCreate(const string& name, const string& help, MetricTYPE type) {
+        auto it = MetricEntries.find(name);
+        if (it != MetricEntries.end())
+            return it->second.MetricType == type ? &it->second : nullptr;
+
+        MetricEntry& Entry = MetricEntries[name];
+        Entry.MetricHelp = help;
+        Entry.MetricType = type;
+        MetricNames.push_back(name);
+        return &Entry;
+    }
+
+    Counter& MetricsRegistry::GetCounter(const string& name, const string& help) {
+        lock_guard<mutex> Lock(RegistryMutex);
+        MetricEntry* Entry = FindOrCreate(name, help, MetricCounter);
+        // type conflict => detached object(not exported).
+        if (Entry == nullptr) {
+            static Counter DetachedCounter = {};
+            return DetachedCounter;
+        }
+        if (Entry->CounterObject == nullptr) Entry->CounterObject = make_unique<Counter>();
+        return *Entry->CounterObject;
+    }
+
+    Gauge& MetricsRegistry::GetGauge(const string& name, const string& help) {
+        lock_guard<mutex> Lock(RegistryMutex);
+        MetricEntry* Entry = FindOrCreate(name, help, MetricGauge);
+        if (Entry == nullptr) {
+            static Gauge DetachedGauge = {};
+            return DetachedGauge;
+        }
+        if (Entry->GaugeObject == nullptr) Entry->GaugeObject = make_unique<Gauge>();
+        return *Entry->GaugeObject;
+    }
+
+    Histogram& MetricsRegistry::GetHistogram(const string& name, const string& help, const vector<double>& bounds) {
+        lock_guard<mutex> Lock(RegistryMutex);
+        MetricEntry* Entry = FindOrCreate(name, help, MetricHistogram);
+        if (Entry == nullptr) {
+            static Histogram DetachedHistogram(vector<double>{});
+            return DetachedHistogram;
+        }
+        if (Entry->HistogramObject == nullptr) Entry->HistogramObject = make_unique<Histogram>(bounds);
+        return *Entry->HistogramObject;
+    }
+
+    void MetricsRegistry::SetSampler(const string& name, const string& help, MetricTYPE type, function<double()> sampler) {
+        lock_guard<mutex> Lock(RegistryMutex);
+        if (type == MetricHistogram) return;
+        MetricEntry* Entry = FindOrCreate(name, help, type);
+        if (Entry != nullptr) Entry->SamplerFunction = move(sampler);
+    }
+
+    void MetricsRegistry::RemoveSampler(const string& name) {
+        lock_guard<mutex> Lock(RegistryMutex);
+        auto it = MetricEntries.find(name);
+        if (it == MetricEntries.end()) return;
+        it->second.SamplerFunction = nullptr;
+        // sampler only => erase entry, objects => referenced(call sites).
+        if (it->second.CounterObject == nullptr && it->second.GaugeObject == nullptr && it->second.HistogramObject == nullptr) {
+            MetricEntries.erase(it);
+            MetricNames.erase(find(MetricNames.begin(), MetricNames.end(), name));
+        }
+    }
+
+    vector<MetricSample> MetricsRegistry::GetSnapshot() {
+        vector<MetricSample> ReturnSamples = {};
+        // samplers: under lock(owner remove => wait scrape).
+        lock_guard<mutex> Lock(RegistryMutex);
+        for (const string& Name : MetricNames) {
+            const MetricEntry& Entry = MetricEntries[Name];
+
+            MetricSample SampleTemp = {};
+            SampleTemp.MetricName = Name;
+            SampleTemp.MetricHelp = Entry.MetricHelp;
+            SampleTemp.MetricType = Entry.MetricType;
+
+            if (Entry.SamplerFunction)
+                SampleTemp.MetricValue = Entry.SamplerFunction();
+            else if (Entry.CounterObject != nullptr)
+                SampleTemp.MetricValue = (double)Entry.CounterObject->GetValue();
+            else if (Entry.GaugeObject != nullptr)
+                SampleTemp.MetricValue = (double)Entry.GaugeObject->GetValue();
+            else if (Entry.HistogramObject != nullptr) {
+                SampleTemp.BucketBounds = Entry.HistogramObject->GetBounds();
+                Entry.HistogramObject->GetValue(SampleTemp.BucketCounts, SampleTemp.SampleCount, SampleTemp.SampleSum);
+            }
+            ReturnSamples.push_back(move(SampleTemp));
+        }
+        return ReturnSamples;
+    }
+
+    // "family{labels}" => family, labels.
+    static void MetricSplitName(const string& name, string& family, string& labels) {
+        size_t Brace = name.find('{');
+        family = name.substr(0, Brace);
+        labels = Brace == string::npos ? string() : name.substr(Brace + 1, name.size() - Brace - 2);
+    }
+
+    static void MetricAppendNumber(string& out, double value) {
+        char NumberTemp[48] = {};
+        if (value == (double)(int64_t)value && fabs(value) < 9.0e15)
+            snprintf(NumberTemp, sizeof(NumberTemp), "%lld", (long long)value);
+        else
+            snprintf(NumberTemp, sizeof(NumberTemp), "%.17g", value);
+        out.append(NumberTemp);
+    }
+
+    string MetricsRegistry::ExportPrometheusText() {
+        vector<MetricSample> Samples = GetSnapshot();
+        string ExportText = {};
+        // family => samples contiguous(first registration order).
+        vector<string> Families = {};
+        unordered_map<string, vector<const MetricSample*>> FamilySamples = {};
+        for (const auto& Sample : Samples) {
+            string Family = {}, Labels = {};
+            MetricSplitName(Sample.MetricName, Family, Labels);
+            if (!FamilySamples.count(Family)) Families.push_back(Family);
+            FamilySamples[Family].push_back(&Sample);
+        }
+        for (const string& Family : Families) {
+            const MetricSample* First = FamilySamples[Family].front();
+            if (!First->MetricHelp.empty())
+                ExportText.append("# HELP ").append(Family).append(" ").append(First->MetricHelp).append("\n");
+            ExportText.append("# TYPE ").append(Family).append(
+                First->MetricType == MetricCounter ? " counter\n" : First->MetricType == MetricGauge ? " gauge\n" : " histogram\n"
+            );
+            for (const MetricSample* Sample : FamilySamples[Family]) {
+                string FamilyTemp = {}, Labels = {};
+                MetricSplitName(Sample->MetricName, FamilyTemp, Labels);
+
+                if (Sample->MetricType != MetricHistogram) {
+                    ExportText.append(Sample->MetricName).append(" ");
+                    MetricAppendNumber(ExportText, Sample->MetricValue);
+                    ExportText.append("\n");
+                    continue;
+                }
+                string LabelsPrefix = Labels.empty() ? string() : Labels + ",";
+                for (size_t i = 0; i < Sample->BucketCounts.size(); ++i) {
+                    ExportText.append(Family).append("_bucket{").append(LabelsPrefix).append("le=\"");
+                    if (i < Sample->BucketBounds.size())
+                        MetricAppendNumber(ExportText, Sample->BucketBounds[i]);
+                    else
+                        ExportText.append("+Inf");
+                    ExportText.append("\"} ");
+                    MetricAppendNumber(ExportText, (double)Sample->BucketCounts[i]);
+                    ExportText.append("\n");
+                }
+                string LabelsBlock = Labels.empty() ? string() : "{" + Labels + "}";
+                ExportText.append(Family).append("_sum").append(LabelsBlock).append(" ");
+                MetricAppendNumber(ExportText, Sample->SampleSum);
+                ExportText.append("\n").append(Family).append("_count").append(LabelsBlock).append(" ");
+                MetricAppendNumber(ExportText, (double)Sample->SampleCount);
+                ExportText.append("\n");
+            }
+        }
+        return ExportText;
+    }
+
+    MetricsRegistry& GlobalMetrics() {
+        static MetricsRegistry Registry = {};
+        static once_flag LoggerSamplersFlag = {};
+        // logger lines(statistics) => samplers.
+        call_once(LoggerSamplersFlag, [] {
+            Registry.SetSampler("spca_log_lines_total", "logger lines.", MetricCounter,
+                [] { return (double)PSAG_LOGGER::LogLinesStatistics().vector_x; });
+            Registry.SetSampler("spca_log_warning_lines_total", "logger warning lines.", MetricCounter,
+                [] { return (double)PSAG_LOGGER::LogLinesStatistics().vector_y; });
+            Registry.SetSampler("spca_log_error_lines_total", "logger error lines.", MetricCounter,
+                [] { return (double)PSAG_LOGGER::LogLinesStatistics().vector_z; });
+        });
+        return Registry;
+    }
+
+    bool MetricsServer::StartServer(uint16_t port, MetricsRegistry* registry, const char* address) {
+        StopServer();
+        ServerRegistry = registry != nullptr ? registry : &GlobalMetrics();
+#if defined(_WIN32)
+        static bool WinsockInit = false;
+        if (!WinsockInit) {
+            WSADATA WsaData = {};
+            if (WSAStartup(MAKEWORD(2, 2), &WsaData) != 0) return false;
+            WinsockInit = true;
+        }
+#endif
+        intptr_t SocketTemp = (intptr_t)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (SocketTemp < 0) return false;
+
+        int32_t ReuseFlag = 1;
+        setsockopt(SocketTemp, SOL_SOCKET, SO_REUSEADDR, (const char*)&ReuseFlag, sizeof(int32_t));
+
+        sockaddr_in Address = {};
+        Address.sin_family = AF_INET;
+        Address.sin_port   = htons(port);
+        if (inet_pton(AF_INET, address, &Address.sin_addr) != 1 ||
+            ::bind(SocketTemp, (const sockaddr*)&Address, sizeof(Address)) != 0 ||
+            listen(SocketTemp, 8) != 0
+        ) {
+            METRICS_SOCKET_CLOSE(SocketTemp);
+            return false;
+        }
+        ServerSocket = SocketTemp;
+        ServerRunning = true;
+        try {
+            ServerThread = thread([this] { ServerExecution(); });
+        }
+        catch (...) {
+            ServerRunning = false;
+            METRICS_SOCKET_CLOSE(ServerSocket);
+            ServerSocket = -1;
+            return false;
+        }
+        return true;
+    }
+
+    void MetricsServer::ServerExecution() {
+        while (ServerRunning.load(memory_order_acquire)) {
+            // accept wait: 200ms => check stop.
+            fd_set ReadSet;
+            FD_ZERO(&ReadSet);
+            FD_SET(ServerSocket, &ReadSet);
+            timeval Timeout = { 0, 200000 };
+            if (select((int)ServerSocket + 1, &ReadSet, nullptr, nullptr, &Timeout) <= 0)
+                continue;
+
+            intptr_t ClientSocket = (intptr_t)accept(ServerSocket, nullptr, nullptr);
+            if (ClientSocket < 0) continue;
+
+            // request line(header): "GET /metrics ...".
+            string RequestText = {};
+            char ReceiveTemp[1024] = {};
+            while (RequestText.find("\r\n\r\n") == string::npos && RequestText.size() < METRICS_REQUEST_LIMIT) {
+                fd_set ClientSet;
+                FD_ZERO(&ClientSet);
+                FD_SET(ClientSocket, &ClientSet);
+                timeval ClientTimeout = { 1, 0 };
+                if (select((int)ClientSocket + 1, &ClientSet, nullptr, nullptr, &ClientTimeout) <= 0) break;
+
+                int32_t Length = (int32_t)recv(ClientSocket, ReceiveTemp, sizeof(ReceiveTemp), 0);
+                if (Length <= 0) break;
+                RequestText.append(ReceiveTemp, (size_t)Length);
+            }
+            bool RequestMetrics = RequestText.rfind("GET /metrics", 0) == 0 || RequestText.rfind("GET / ", 0) == 0;
+
+            string BodyText = RequestMetrics ? ServerRegistry->ExportPrometheusText() : string("not found\n");
+            string ResponseText = RequestMetrics ?
+                "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n" :
+                "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\n";
+            ResponseText.append("Content-Length: " + to_string(BodyText.size()) + "\r\nConnection: close\r\n\r\n");
+            ResponseText.append(BodyText);
+
+            for (size_t Offset = 0; Offset < ResponseText.size();) {
+                int32_t Length = (int32_t)send(ClientSocket, ResponseText.data() + Offset, (int)(ResponseText.size() - Offset), 0);
+                if (Length <= 0) break;
+                Offset += (size_t)Length;
+            }
+            METRICS_SOCKET_CLOSE(ClientSocket);
+        }
+    }
+
+    void MetricsServer::StopServer() {
+        ServerRunning.store(false, memory_order_release);
+        if (ServerThread.joinable())
+            ServerThread.join();
+        if (ServerSocket >= 0) {
+            METRICS_SOCKET_CLOSE(ServerSocket);
+            ServerSocket = -1;
+        }
+    }
+
+    uint16_t MetricsServer::GetServerPort() {
+        if (ServerSocket < 0) return NULL;
+        sockaddr_in Address = {};
+        socklen_t AddressLength = sizeof(Address);
+        if (getsockname(ServerSocket, (sockaddr*)&Address, &AddressLength) != 0)
+            return NULL;
+        return ntohs(Address.sin_port);
+    }
+}
@@ -0,0 +1,144 @@
+// spca_tool_metrics, (registry: counters, gauges, histograms), v0.1, RCSZ 2026.10.19
+// export: prometheus text(0.0.4), local http(loopback) | snapshot.
+
+#ifndef _SPCA_TOOL_METRICS_H
+#define _SPCA_TOOL_METRICS_H
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// per thread shards(counter, histogram), pow2.
+#define SPCA_METRICS_SHARDS 16
+
+namespace SpcaMetrics {
+    enum MetricTYPE {
+        MetricCounter   = 1 << 1,
+        MetricGauge     = 1 << 2,
+        MetricHistogram = 1 << 3
+    };
+
+    // this thread => shard index.
+    size_t MetricShardIndex();
+
+    // monotonic, hot path: relaxed add(thread shard).
+    class Counter {
+    protected:
+        struct alignas(64) CounterShard {
+            std::atomic<uint64_t> Value = {};
+        };
+        CounterShard CounterShards[SPCA_METRICS_SHARDS] = {};
+    public:
+        void Add(uint64_t value = 1) {
+            CounterShards[MetricShardIndex()].Value.fetch_add(value, std::memory_order_relaxed);
+        }
+        uint64_t GetValue() const;
+    };
+
+    class Gauge {
+    protected:
+        std::atomic<int64_t> GaugeValue = {};
+    public:
+        void Set(int64_t value) { GaugeValue.store(value, std::memory_order_relaxed); }
+        void Add(int64_t value) { GaugeValue.fetch_add(value, std::memory_order_relaxed); }
+        int64_t GetValue() const { return GaugeValue.load(std::memory_order_relaxed); }
+    };
+
+    // buckets: upper bounds(ascending) + inf, observe: thread shard.
+    class Histogram {
+    protected:
+        struct alignas(64) HistogramShard {
+            std::unique_ptr<std::atomic<uint64_t>[]> BucketCounts = nullptr;
+            std::atomic<uint64_t> SampleCount = {};
+            std::atomic<double>   SampleSum   = {};
+        };
+        std::vector<double> BucketBounds = {};
+        HistogramShard HistogramShards[SPCA_METRICS_SHARDS] = {};
+    public:
+        Histogram(const std::vector<double>& bounds);
+
+        void Observe(double value);
+        // buckets(cumulative, + inf), count, sum.
+        void GetValue(std::vector<uint64_t>& buckets, uint64_t& count, double& sum) const;
+        const std::vector<double>& GetBounds() const { return BucketBounds; }
+    };
+    // bounds: start * factor^i, i < count.
+    std::vector<double> ExponentialBounds(double start, double factor, size_t count);
+
+    struct MetricSample {
+        std::string MetricName; // name{labels}.
+        std::string MetricHelp;
+        MetricTYPE  MetricType;
+
+        double MetricValue;
+        // histogram: bounds, cumulative counts(+ inf), count, sum.
+        std::vector<double>   BucketBounds;
+        std::vector<uint64_t> BucketCounts;
+        uint64_t SampleCount;
+        double   SampleSum;
+    };
+
+    // metric name: "family" | "family{label=\"value\"}", same family => same type.
+    class MetricsRegistry {
+    protected:
+        struct MetricEntry {
+            std::string MetricHelp;
+            MetricTYPE  MetricType;
+
+            std::unique_ptr<Counter>   CounterObject;
+            std::unique_ptr<Gauge>     GaugeObject;
+            std::unique_ptr<Histogram> HistogramObject;
+            // sampler: value at scrape.
+            std::function<double()> SamplerFunction;
+        };
+        std::mutex RegistryMutex = {};
+        // name => entry, order: registration.
+        std::vector<std::string> MetricNames = {};
+        std::unordered_map<std::string, MetricEntry> MetricEntries = {};
+
+        MetricEntry* FindOrCreate(const std::string& name, const std::string& help, MetricTYPE type);
+    public:
+        // stable reference(registry lifetime), cache at call site.
+        Counter& GetCounter(const std::string& name, const std::string& help = {});
+        Gauge&   GetGauge(const std::string& name, const std::string& help = {});
+        Histogram& GetHistogram(
+            const std::string& name, const std::string& help = {},
+            const std::vector<double>& bounds = ExponentialBounds(0.01, 4.0, 12)
+        );
+        // counter | gauge value => "sampler"(scrape thread).
+        void SetSampler(const std::string& name, const std::string& help, MetricTYPE type, std::function<double()> sampler);
+        // sampler => removed(owner free), counter | gauge | histogram objects: kept(references stable).
+        void RemoveSampler(const std::string& name);
+
+        std::vector<MetricSample> GetSnapshot();
+        std::string ExportPrometheusText();
+    };
+    // process registry.
+    MetricsRegistry& GlobalMetrics();
+
+    // http(loopback) => "GET /metrics": prometheus text.
+    class MetricsServer {
+    protected:
+        MetricsRegistry* ServerRegistry = nullptr;
+        std::thread ServerThread = {};
+
+        std::atomic<bool> ServerRunning = false;
+        intptr_t ServerSocket = -1;
+
+        void ServerExecution();
+    public:
+        ~MetricsServer() { StopServer(); }
+        // port = 0 => system assigned(GetServerPort), true:success, false:failed.
+        bool StartServer(uint16_t port, MetricsRegistry* registry = nullptr, const char* address = "127.0.0.1");
+        void StopServer();
+        uint16_t GetServerPort();
+    };
+}
+
+#endif
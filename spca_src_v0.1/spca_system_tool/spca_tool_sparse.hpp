@@ -0,0 +1,269 @@
+// spca_tool_sparse, (sparse_matrix csr, sell-c-sigma), v0.1, RCSZ 2026.10.19
+// dense companion: spca_tool_matrix (SpcaIndexMatrix 2d).
+
+#ifndef _SPCA_TOOL_SPARSE_H
+#define _SPCA_TOOL_SPARSE_H
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+#include "spca_tool_matrix.hpp"
+
+// sparse index type, device: uint(32bit).
+using SpcaSparseIndex = uint32_t;
+
+// sparse_matrix 2d, format: csr(compressed sparse row).
+// rows = dim.x, cols = dim.y, (i,j) => IMatrixAddressing2D(i,j).
+template<typename SpcaDataType>
+class SpcaSparseMatrixCSR {
+protected:
+	// row_offsets: rows + 1, column_indices & values: nnz.
+	std::vector<SpcaSparseIndex> RowOffsets    = {};
+	std::vector<SpcaSparseIndex> ColumnIndices = {};
+	std::vector<SpcaDataType>    ValuesArray   = {};
+
+	size_t SparseMatrixDim[2] = {};
+public:
+	// dense matrix2d => csr, |value| <= threshold => zero.
+	int SMatrixFromDense(SpcaIndexMatrix<SpcaDataType>& matrix, SpcaDataType threshold = SpcaDataType(0)) {
+		if (matrix.GetIMatrixMode() != SPCA_TYPE_MATRIX2D) return SPCA_MATRIX_FAILED;
+		SMatrixFree();
+
+		SparseMatrixDim[0] = matrix.GetIMatrixDimParam(0);
+		SparseMatrixDim[1] = matrix.GetIMatrixDimParam(1);
+
+		RowOffsets.resize(SparseMatrixDim[0] + 1, NULL);
+		for (size_t i = 0; i < SparseMatrixDim[0]; ++i) {
+			for (size_t j = 0; j < SparseMatrixDim[1]; ++j) {
+				SpcaDataType Value = *matrix.IMatrixAddressing2D(i, j);
+				if (std::abs(Value) <= threshold) continue;
+
+				ColumnIndices.push_back((SpcaSparseIndex)j);
+				ValuesArray.push_back(Value);
+			}
+			RowOffsets[i + 1] = (SpcaSparseIndex)ValuesArray.size();
+		}
+		return SPCA_MATRIX_SUCCESS;
+	}
+
+	// coo(triplets) => csr, duplicate entries are summed.
+	// non dense staging: rows * cols never allocated.
+	int SMatrixFromTriplets(
+		size_t rows, size_t cols, const std::vector<SpcaSparseIndex>& row_index,
+		const std::vector<SpcaSparseIndex>& col_index, const std::vector<SpcaDataType>& values
+	) {
+		if (row_index.size() != col_index.size() || row_index.size() != values.size())
+			return SPCA_MATRIX_FAILED;
+		SMatrixFree();
+
+		SparseMatrixDim[0] = rows;
+		SparseMatrixDim[1] = cols;
+		// count entries per row => prefix sum.
+		RowOffsets.resize(rows + 1, NULL);
+		for (size_t i = 0; i < row_index.size(); ++i) {
+			if (row_index[i] >= rows || col_index[i] >= cols) {
+				SMatrixFree();
+				return SPCA_MATRIX_FAILED;
+			}
+			++RowOffsets[row_index[i] + 1];
+		}
+		std::partial_sum(RowOffsets.begin(), RowOffsets.end(), RowOffsets.begin());
+
+		ColumnIndices.resize(values.size());
+		ValuesArray.resize(values.size());
+
+		std::vector<SpcaSparseIndex> RowFillTemp(RowOffsets.begin(), RowOffsets.end() - 1);
+		for (size_t i = 0; i < values.size(); ++i) {
+			SpcaSparseIndex Position = RowFillTemp[row_index[i]]++;
+			ColumnIndices[Position] = col_index[i];
+			ValuesArray[Position]   = values[i];
+		}
+		// sort row columns & merge duplicates.
+		std::vector<SpcaSparseIndex> ColumnsTemp = {};
+		std::vector<SpcaDataType>    ValuesTemp  = {};
+		std::vector<SpcaSparseIndex> OrderTemp   = {};
+
+		SpcaSparseIndex WriteOffset = NULL;
+		for (size_t i = 0; i < rows; ++i) {
+			SpcaSparseIndex Begin = RowOffsets[i], End = RowOffsets[i + 1];
+
+			OrderTemp.resize(End - Begin);
+			std::iota(OrderTemp.begin(), OrderTemp.end(), Begin);
+			std::sort(OrderTemp.begin(), OrderTemp.end(), [&](SpcaSparseIndex a, SpcaSparseIndex b) {
+				return ColumnIndices[a] < ColumnIndices[b];
+			});
+			ColumnsTemp.clear();
+			ValuesTemp.clear();
+			for (SpcaSparseIndex Index : OrderTemp) {
+				if (!ColumnsTemp.empty() && ColumnsTemp.back() == ColumnIndices[Index]) {
+					ValuesTemp.back() += ValuesArray[Index];
+					continue;
+				}
+				ColumnsTemp.push_back(ColumnIndices[Index]);
+				ValuesTemp.push_back(ValuesArray[Index]);
+			}
+			// compact write(write_offset <= begin).
+			std::copy(ColumnsTemp.begin(), ColumnsTemp.end(), ColumnIndices.begin() + WriteOffset);
+			std::copy(ValuesTemp.begin(),  ValuesTemp.end(),  ValuesArray.begin()   + WriteOffset);
+
+			RowOffsets[i] = WriteOffset;
+			WriteOffset += (SpcaSparseIndex)ColumnsTemp.size();
+		}
+		RowOffsets[rows] = WriteOffset;
+		ColumnIndices.resize(WriteOffset);
+		ValuesArray.resize(WriteOffset);
+		return SPCA_MATRIX_SUCCESS;
+	}
+
+	// csr => dense matrix2d(alloc: rows * cols).
+	int SMatrixToDense(SpcaIndexMatrix<SpcaDataType>& matrix) {
+		if (matrix.GetIMatrixMode() != SPCA_TYPE_MATRIX2D) return SPCA_MATRIX_FAILED;
+		if (matrix.GetIMatrixSizeBytes() > NULL) matrix.IMatrixFree();
+
+		if (!matrix.IMatrixAlloc(SparseMatrixDim[0], SparseMatrixDim[1]))
+			return SPCA_MATRIX_FAILED;
+		for (size_t i = 0; i < SparseMatrixDim[0]; ++i)
+			for (SpcaSparseIndex k = RowOffsets[i]; k < RowOffsets[i + 1]; ++k)
+				*matrix.IMatrixAddressing2D(i, ColumnIndices[k]) = ValuesArray[k];
+		return SPCA_MATRIX_SUCCESS;
+	}
+
+	size_t SMatrixFree() {
+		size_t DataSizeBytes = GetSMatrixSizeBytes();
+
+		RowOffsets.clear();    RowOffsets.shrink_to_fit();
+		ColumnIndices.clear(); ColumnIndices.shrink_to_fit();
+		ValuesArray.clear();   ValuesArray.shrink_to_fit();
+
+		SparseMatrixDim[0] = NULL;
+		SparseMatrixDim[1] = NULL;
+		return DataSizeBytes;
+	}
+
+	// matrix 0:rows, 1:cols.
+	size_t GetSMatrixDimParam(size_t dimindex) {
+		if (dimindex > 1) dimindex = 1;
+		return SparseMatrixDim[dimindex];
+	}
+	size_t GetSMatrixNonZeros() { return ValuesArray.size(); }
+	// csr arrays total size(bytes).
+	size_t GetSMatrixSizeBytes() {
+		return (RowOffsets.size() + ColumnIndices.size()) * sizeof(SpcaSparseIndex) +
+			ValuesArray.size() * sizeof(SpcaDataType);
+	}
+	// warning: src_data pointer.
+	std::vector<SpcaSparseIndex>* GetSMatrixRowOffsets()    { return &RowOffsets; }
+	std::vector<SpcaSparseIndex>* GetSMatrixColumnIndices() { return &ColumnIndices; }
+	std::vector<SpcaDataType>*    GetSMatrixValues()        { return &ValuesArray; }
+};
+
+// sparse_matrix 2d, format: sell-c-sigma(sliced ellpack).
+// rows sorted(by nnz) in windows of "sigma", packed in slices of "c" rows,
+// slice data column-major => coalesced device access. ell: c = rows, sigma = 1.
+template<typename SpcaDataType>
+class SpcaSparseMatrixSELL {
+protected:
+	// slice_offsets: slices + 1, element offset of slice.
+	std::vector<SpcaSparseIndex> SliceOffsets  = {};
+	std::vector<SpcaSparseIndex> ColumnIndices = {};
+	std::vector<SpcaDataType>    ValuesArray   = {};
+	// sorted row slot => original row.
+	std::vector<SpcaSparseIndex> RowPermute = {};
+
+	size_t SparseMatrixDim[2] = {};
+	size_t SparseNonZeros = NULL;
+
+	size_t SliceHeight = 32, SortWindow = 1;
+public:
+	int SMatrixFromCSR(SpcaSparseMatrixCSR<SpcaDataType>& csr, size_t slice_c = 32, size_t sigma = 1) {
+		if (slice_c == NULL || sigma == NULL) return SPCA_MATRIX_FAILED;
+		SMatrixFree();
+
+		SliceHeight = slice_c;
+		SortWindow  = sigma;
+
+		SparseMatrixDim[0] = csr.GetSMatrixDimParam(0);
+		SparseMatrixDim[1] = csr.GetSMatrixDimParam(1);
+		SparseNonZeros     = csr.GetSMatrixNonZeros();
+
+		const std::vector<SpcaSparseIndex>& SrcOffsets = *csr.GetSMatrixRowOffsets();
+		auto RowLength = [&](SpcaSparseIndex row) { return SrcOffsets[row + 1] - SrcOffsets[row]; };
+
+		size_t SlicesCount = (SparseMatrixDim[0] + SliceHeight - 1) / SliceHeight;
+		// row slots padded to slice height.
+		RowPermute.resize(SlicesCount * SliceHeight, NULL);
+		std::iota(RowPermute.begin(), RowPermute.begin() + SparseMatrixDim[0], NULL);
+
+		// sort(desc nnz) rows in sigma window.
+		for (size_t i = 0; i < SparseMatrixDim[0]; i += SortWindow) {
+			size_t WindowEnd = std::min(i + SortWindow, SparseMatrixDim[0]);
+			std::stable_sort(RowPermute.begin() + i, RowPermute.begin() + WindowEnd,
+				[&](SpcaSparseIndex a, SpcaSparseIndex b) { return RowLength(a) > RowLength(b); }
+			);
+		}
+		SliceOffsets.resize(SlicesCount + 1, NULL);
+		for (size_t s = 0; s < SlicesCount; ++s) {
+			size_t SliceWidth = NULL;
+			for (size_t r = s * SliceHeight; r < std::min((s + 1) * SliceHeight, SparseMatrixDim[0]); ++r)
+				SliceWidth = std::max(SliceWidth, (size_t)RowLength(RowPermute[r]));
+			SliceOffsets[s + 1] = SliceOffsets[s] + SpcaSparseIndex(SliceWidth * SliceHeight);
+		}
+		// padding: col = 0, value = 0.
+		ColumnIndices.resize(SliceOffsets.back(), NULL);
+		ValuesArray.resize(SliceOffsets.back(), SpcaDataType(0));
+
+		const std::vector<SpcaSparseIndex>& SrcColumns = *csr.GetSMatrixColumnIndices();
+		const std::vector<SpcaDataType>&    SrcValues  = *csr.GetSMatrixValues();
+
+		for (size_t r = 0; r < SparseMatrixDim[0]; ++r) {
+			size_t Slice = r / SliceHeight, Lane = r % SliceHeight;
+			SpcaSparseIndex SrcRow = RowPermute[r];
+			for (SpcaSparseIndex k = 0; k < RowLength(SrcRow); ++k) {
+				// slice column-major: offset + k * c + lane.
+				size_t Index = SliceOffsets[Slice] + k * SliceHeight + Lane;
+				ColumnIndices[Index] = SrcColumns[SrcOffsets[SrcRow] + k];
+				ValuesArray[Index]   = SrcValues[SrcOffsets[SrcRow] + k];
+			}
+		}
+		return SPCA_MATRIX_SUCCESS;
+	}
+
+	size_t SMatrixFree() {
+		size_t DataSizeBytes = GetSMatrixSizeBytes();
+
+		SliceOffsets.clear();  SliceOffsets.shrink_to_fit();
+		ColumnIndices.clear(); ColumnIndices.shrink_to_fit();
+		ValuesArray.clear();   ValuesArray.shrink_to_fit();
+		RowPermute.clear();    RowPermute.shrink_to_fit();
+
+		SparseMatrixDim[0] = NULL;
+		SparseMatrixDim[1] = NULL;
+		SparseNonZeros = NULL;
+		return DataSizeBytes;
+	}
+
+	// matrix 0:rows, 1:cols.
+	size_t GetSMatrixDimParam(size_t dimindex) {
+		if (dimindex > 1) dimindex = 1;
+		return SparseMatrixDim[dimindex];
+	}
+	size_t GetSMatrixNonZeros()   { return SparseNonZeros; }
+	size_t GetSMatrixSliceHeight() { return SliceHeight; }
+	// padded(stored) elements / nnz, 1.0: non padding.
+	double GetSMatrixPaddingRatio() {
+		return SparseNonZeros > NULL ? double(ValuesArray.size()) / double(SparseNonZeros) : 1.0;
+	}
+	size_t GetSMatrixSizeBytes() {
+		return (SliceOffsets.size() + ColumnIndices.size() + RowPermute.size()) * sizeof(SpcaSparseIndex) +
+			ValuesArray.size() * sizeof(SpcaDataType);
+	}
+	// warning: src_data pointer.
+	std::vector<SpcaSparseIndex>* GetSMatrixSliceOffsets()  { return &SliceOffsets; }
+	std::vector<SpcaSparseIndex>* GetSMatrixColumnIndices() { return &ColumnIndices; }
+	std::vector<SpcaDataType>*    GetSMatrixValues()        { return &ValuesArray; }
+	std::vector<SpcaSparseIndex>* GetSMatrixRowPermute()    { return &RowPermute; }
+};
+
+#endif
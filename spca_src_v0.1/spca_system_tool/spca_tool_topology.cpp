@@ -0,0 +1,254 @@
+// spca_tool_topology.
+#include "spca_tool_topology.h"
+
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+
+#include "spca_tool_logger.hpp"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+// numaif.h(libnuma) non-dependent.
+#define TOPOLOGY_MPOL_DEFAULT   0
+#define TOPOLOGY_MPOL_PREFERRED 1
+#define TOPOLOGY_MPOL_MF_MOVE   (1 << 1)
+// node mask: 1024 nodes.
+#define TOPOLOGY_MASK_LONGS 16
+#else
+#include <cstdlib>
+#endif
+
+using namespace std;
+
+#define MODULE_LABEL_TOPOLOGY "SPCA_TOPOLOGY"
+
+namespace SpcaTopology {
+#if defined(__linux__)
+    // cpulist: "0-3,8-11" => cpus.
+    static void ParseCpuList(const string& text, vector<uint32_t>& cpus) {
+        size_t Position = NULL;
+        while (Position < text.size()) {
+            size_t Comma = text.find(',', Position);
+            string Item = text.substr(Position, Comma == string::npos ? string::npos : Comma - Position);
+            Position = Comma == string::npos ? text.size() : Comma + 1;
+
+            size_t Dash = Item.find('-');
+            try {
+                uint32_t First = (uint32_t)stoul(Item.substr(0, Dash));
+                uint32_t Last  = Dash == string::npos ? First : (uint32_t)stoul(Item.substr(Dash + 1));
+                for (uint32_t i = First; i <= Last; ++i)
+                    cpus.push_back(i);
+            }
+            catch (...) {}
+        }
+    }
+#endif
+
+    // process affinity(taskset, cpuset) => keep allowed cpus, query failed: unchanged.
+    static void FilterProcessCpus(vector<uint32_t>& cpus) {
+#if defined(_WIN32)
+        DWORD_PTR ProcessMask = NULL, SystemMask = NULL;
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &ProcessMask, &SystemMask) || ProcessMask == NULL)
+            return;
+        cpus.erase(remove_if(cpus.begin(), cpus.end(), [&](uint32_t cpu) {
+            return cpu >= sizeof(DWORD_PTR) * 8 || !(ProcessMask & ((DWORD_PTR)1 << cpu));
+        }), cpus.end());
+#elif defined(__linux__)
+        cpu_set_t ProcessSet;
+        CPU_ZERO(&ProcessSet);
+        if (sched_getaffinity(0, sizeof(cpu_set_t), &ProcessSet) != 0)
+            return;
+        cpus.erase(remove_if(cpus.begin(), cpus.end(), [&](uint32_t cpu) {
+            return cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &ProcessSet);
+        }), cpus.end());
+#endif
+    }
+
+    static CpuTopology CreateCpuTopology() {
+        CpuTopology TopologyTemp = {};
+        TopologyTemp.LogicalCPUs = max(thread::hardware_concurrency(), 1u);
+#if defined(_WIN32)
+        ULONG HighestNode = NULL;
+        if (GetNumaHighestNodeNumber(&HighestNode)) {
+            for (ULONG i = 0; i <= HighestNode; ++i) {
+                GROUP_AFFINITY Affinity = {};
+                // processor group 0(affinity mask 64 cpus).
+                if (!GetNumaNodeProcessorMaskEx((USHORT)i, &Affinity) || Affinity.Group != 0 || Affinity.Mask == NULL)
+                    continue;
+                NumaNodeInfo NodeTemp = { (uint32_t)i, {} };
+                for (uint32_t Cpu = 0; Cpu < sizeof(KAFFINITY) * 8; ++Cpu)
+                    if (Affinity.Mask & ((KAFFINITY)1 << Cpu))
+                        NodeTemp.NodeCPUs.push_back(Cpu);
+                // no allowed cpus(process affinity) => skip.
+                FilterProcessCpus(NodeTemp.NodeCPUs);
+                if (!NodeTemp.NodeCPUs.empty())
+                    TopologyTemp.TopologyNodes.push_back(NodeTemp);
+            }
+        }
+#elif defined(__linux__)
+        error_code ErrorCode = {};
+        for (const auto& Entry : filesystem::directory_iterator("/sys/devices/system/node", ErrorCode)) {
+            string FileName = Entry.path().filename().string();
+            if (FileName.rfind("node", 0) != 0 || FileName.size() <= 4 ||
+                !all_of(FileName.begin() + 4, FileName.end(), ::isdigit)
+            )
+                continue;
+            ifstream CpuListFile(Entry.path() / "cpulist");
+            string CpuList = {};
+            getline(CpuListFile, CpuList);
+
+            NumaNodeInfo NodeTemp = { (uint32_t)stoul(FileName.substr(4)), {} };
+            ParseCpuList(CpuList, NodeTemp.NodeCPUs);
+            FilterProcessCpus(NodeTemp.NodeCPUs);
+            // memory only | no allowed cpus(process affinity) => skip.
+            if (!NodeTemp.NodeCPUs.empty())
+                TopologyTemp.TopologyNodes.push_back(NodeTemp);
+        }
+        sort(TopologyTemp.TopologyNodes.begin(), TopologyTemp.TopologyNodes.end(),
+            [](const NumaNodeInfo& a, const NumaNodeInfo& b) { return a.NodeIndex < b.NodeIndex; });
+#endif
+        // non-numa | unsupported => 1 node.
+        if (TopologyTemp.TopologyNodes.empty()) {
+            NumaNodeInfo NodeTemp = { NULL, {} };
+            for (uint32_t i = 0; i < TopologyTemp.LogicalCPUs; ++i)
+                NodeTemp.NodeCPUs.push_back(i);
+            vector<uint32_t> AllowedCPUs = NodeTemp.NodeCPUs;
+            FilterProcessCpus(AllowedCPUs);
+            // allowed cpus(ids) >= logical count => keep all.
+            if (!AllowedCPUs.empty())
+                NodeTemp.NodeCPUs.swap(AllowedCPUs);
+            TopologyTemp.TopologyNodes.push_back(NodeTemp);
+        }
+        PSAG_LOGGER::PushLogger(LogInfo, MODULE_LABEL_TOPOLOGY, "cpu topology, nodes: %u, logical cpus: %u",
+            (uint32_t)TopologyTemp.TopologyNodes.size(), TopologyTemp.LogicalCPUs);
+        return TopologyTemp;
+    }
+
+    const CpuTopology& GetCpuTopology() {
+        static CpuTopology Topology = CreateCpuTopology();
+        return Topology;
+    }
+
+    uint32_t CpuNodePosition(uint32_t cpu) {
+        const CpuTopology& Topology = GetCpuTopology();
+        for (size_t i = 0; i < Topology.TopologyNodes.size(); ++i) {
+            const vector<uint32_t>& CPUs = Topology.TopologyNodes[i].NodeCPUs;
+            if (binary_search(CPUs.begin(), CPUs.end(), cpu))
+                return (uint32_t)i;
+        }
+        return NULL;
+    }
+
+    bool SetThreadAffinity(ThreadHandle handle, const vector<uint32_t>& cpus) {
+        vector<uint32_t> CpusTemp = cpus;
+        if (CpusTemp.empty()) {
+            for (const NumaNodeInfo& Node : GetCpuTopology().TopologyNodes)
+                CpusTemp.insert(CpusTemp.end(), Node.NodeCPUs.begin(), Node.NodeCPUs.end());
+        }
+#if defined(_WIN32)
+        DWORD_PTR AffinityMask = NULL;
+        for (uint32_t Cpu : CpusTemp)
+            if (Cpu < sizeof(DWORD_PTR) * 8)
+                AffinityMask |= (DWORD_PTR)1 << Cpu;
+        if (AffinityMask == NULL || SetThreadAffinityMask((HANDLE)handle, AffinityMask) == NULL) {
+            PSAG_LOGGER::PushLogger(LogWarning, MODULE_LABEL_TOPOLOGY, "failed set thread affinity.");
+            return false;
+        }
+        return true;
+#elif defined(__linux__)
+        cpu_set_t CpuSet;
+        CPU_ZERO(&CpuSet);
+        for (uint32_t Cpu : CpusTemp)
+            if (Cpu < CPU_SETSIZE)
+                CPU_SET(Cpu, &CpuSet);
+        int ErrorCode = pthread_setaffinity_np(handle, sizeof(cpu_set_t), &CpuSet);
+        if (ErrorCode != 0) {
+            PSAG_LOGGER::PushLogger(LogWarning, MODULE_LABEL_TOPOLOGY, "failed set thread affinity, code: %i", ErrorCode);
+            return false;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool SetCurrentThreadAffinity(const vector<uint32_t>& cpus) {
+#if defined(_WIN32)
+        return SetThreadAffinity((ThreadHandle)GetCurrentThread(), cpus);
+#elif defined(__linux__)
+        return SetThreadAffinity(pthread_self(), cpus);
+#else
+        return false;
+#endif
+    }
+
+#if defined(__linux__)
+    static bool NodeMemoryPolicy(void* data, size_t bytes, uint32_t node, int mode, unsigned flags) {
+        const CpuTopology& Topology = GetCpuTopology();
+        uint32_t NodeIndex = Topology.TopologyNodes[node % Topology.TopologyNodes.size()].NodeIndex;
+        if (NodeIndex >= TOPOLOGY_MASK_LONGS * sizeof(unsigned long) * 8)
+            return false;
+
+        unsigned long NodeMask[TOPOLOGY_MASK_LONGS] = {};
+        NodeMask[NodeIndex / (sizeof(unsigned long) * 8)] |= 1ul << (NodeIndex % (sizeof(unsigned long) * 8));
+        // maxnode: bits + 1(kernel).
+        return syscall(SYS_mbind, data, bytes, mode, NodeMask, TOPOLOGY_MASK_LONGS * sizeof(unsigned long) * 8 + 1, flags) == 0;
+    }
+#endif
+
+    void* NodeAllocate(size_t bytes, uint32_t node) {
+        if (bytes == NULL) return nullptr;
+#if defined(_WIN32)
+        const CpuTopology& Topology = GetCpuTopology();
+        DWORD NodeIndex = Topology.TopologyNodes[node % Topology.TopologyNodes.size()].NodeIndex;
+        return VirtualAllocExNuma(GetCurrentProcess(), NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, NodeIndex);
+#elif defined(__linux__)
+        void* Data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (Data == MAP_FAILED)
+            return nullptr;
+        // preferred: node full => other nodes.
+        if (!NodeMemoryPolicy(Data, bytes, node, TOPOLOGY_MPOL_PREFERRED, NULL))
+            PSAG_LOGGER::PushLogger(LogTrace, MODULE_LABEL_TOPOLOGY, "node memory policy unsupported, node: %u", node);
+        return Data;
+#else
+        return ::operator new(bytes);
+#endif
+    }
+
+    void NodeFree(void* data, size_t bytes) {
+        if (data == nullptr) return;
+#if defined(_WIN32)
+        VirtualFree(data, NULL, MEM_RELEASE);
+#elif defined(__linux__)
+        munmap(data, bytes);
+#else
+        ::operator delete(data);
+#endif
+    }
+
+    bool NodeBindMemory(void* data, size_t bytes, uint32_t node) {
+#if defined(__linux__)
+        // whole pages inside range(owned by data only), heap neighbours untouched.
+        uintptr_t PageBytes = (uintptr_t)sysconf(_SC_PAGESIZE);
+        uintptr_t Begin = ((uintptr_t)data + PageBytes - 1) & ~(PageBytes - 1);
+        uintptr_t End   = ((uintptr_t)data + bytes) & ~(PageBytes - 1);
+        if (End <= Begin)
+            return false;
+        // preferred & move => migrate, reset default: policy not kept(freed pages => heap reuse).
+        bool PolicyStatus = NodeMemoryPolicy((void*)Begin, End - Begin, node, TOPOLOGY_MPOL_PREFERRED, TOPOLOGY_MPOL_MF_MOVE);
+        if (PolicyStatus)
+            syscall(SYS_mbind, (void*)Begin, End - Begin, TOPOLOGY_MPOL_DEFAULT, nullptr, 0, 0);
+        return PolicyStatus;
+#else
+        return false;
+#endif
+    }
+}
@@ -0,0 +1,40 @@
+// spca_tool_topology, (numa nodes, thread affinity, node memory), v0.1, RCSZ 2026.10.19
+// linux: sysfs nodes + mbind(syscall), windows: numa api(processor group 0).
+
+#ifndef _SPCA_TOOL_TOPOLOGY_H
+#define _SPCA_TOOL_TOPOLOGY_H
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+
+namespace SpcaTopology {
+    struct NumaNodeInfo {
+        uint32_t NodeIndex;
+        // logical cpu index(ascending).
+        std::vector<uint32_t> NodeCPUs;
+    };
+
+    struct CpuTopology {
+        std::vector<NumaNodeInfo> TopologyNodes;
+        uint32_t LogicalCPUs;
+    };
+    // process cached, non-numa => 1 node(all cpus).
+    const CpuTopology& GetCpuTopology();
+    // cpu => node(position in nodes), not found: 0.
+    uint32_t CpuNodePosition(uint32_t cpu);
+
+    using ThreadHandle = std::thread::native_handle_type;
+    // empty cpus => all cpus(reset), true:success, false:failed.
+    bool SetThreadAffinity(ThreadHandle handle, const std::vector<uint32_t>& cpus);
+    bool SetCurrentThreadAffinity(const std::vector<uint32_t>& cpus);
+
+    // node(position) memory: page aligned, pages => node at first touch.
+    void* NodeAllocate(size_t bytes, uint32_t node);
+    void  NodeFree(void* data, size_t bytes);
+    // existing pages(aligned inside range) => node(migrate), no policy kept(later faults: default).
+    // false: unsupported | failed.
+    bool NodeBindMemory(void* data, size_t bytes, uint32_t node);
+}
+
+#endif
@@ -0,0 +1,148 @@
+// spca_tool_tracer.
+#include "spca_tool_tracer.h"
+
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <unordered_map>
+
+using namespace std;
+
+namespace SpcaTracer {
+    atomic<bool> TraceEnableFlag = false;
+    atomic<size_t> TraceDropped = {};
+
+    mutex TraceMutex = {};
+    vector<TraceEvent> TraceEvents = {};
+    size_t TraceCapacity = SPCA_TRACE_CAPACITY;
+    unordered_map<uint32_t, string> TraceTrackNames = {};
+
+    atomic<uint32_t> TraceTrackCounter = {};
+
+    void TraceEnable(bool enable, size_t capacity) {
+        {
+            lock_guard<mutex> Lock(TraceMutex);
+            TraceCapacity = capacity;
+        }
+        TraceEnableFlag.store(enable, memory_order_release);
+    }
+
+    bool TraceEnabled() {
+        return TraceEnableFlag.load(memory_order_relaxed);
+    }
+
+    uint64_t TraceTimeNow() {
+        return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    uint32_t TraceThreadTrack() {
+        thread_local uint32_t TrackIndex = TraceTrackCounter.fetch_add(1, memory_order_relaxed) + 1;
+        return TrackIndex;
+    }
+
+    void TraceSetTrackName(uint32_t track, const string& name) {
+        lock_guard<mutex> Lock(TraceMutex);
+        TraceTrackNames[track] = name;
+    }
+
+    void TracePushSpan(
+        const char* name, const char* category, uint64_t start, uint64_t duration,
+        uint32_t track, const string& args
+    ) {
+        if (!TraceEnabled()) return;
+        lock_guard<mutex> Lock(TraceMutex);
+        if (TraceEvents.size() >= TraceCapacity) {
+            TraceDropped.fetch_add(1, memory_order_relaxed);
+            return;
+        }
+        TraceEvents.push_back(TraceEvent{ name, category, start, duration, track, args });
+    }
+
+    // json string escape: quote, backslash, control.
+    static void TraceJsonString(string& out, const char* str) {
+        out.push_back('"');
+        for (const char* Char = str; *Char != '\0'; ++Char) {
+            if (*Char == '"' || *Char == '\\') {
+                out.push_back('\\');
+                out.push_back(*Char);
+            }
+            else if ((unsigned char)*Char < 0x20)
+                out.push_back(' ');
+            else
+                out.push_back(*Char);
+        }
+        out.push_back('"');
+    }
+
+    bool TraceExportChrome(const string& filename) {
+        vector<TraceEvent> EventsTemp = TraceSnapshot();
+        unordered_map<uint32_t, string> TrackNamesTemp = {};
+        {
+            lock_guard<mutex> Lock(TraceMutex);
+            TrackNamesTemp = TraceTrackNames;
+        }
+        ofstream WriteTraceFile(filename, ios::out | ios::trunc);
+        if (!WriteTraceFile.is_open())
+            return false;
+        // ts, dur: microseconds(ns precision).
+        string TraceJson = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        char NumberTemp[96] = {};
+        bool FirstItem = true;
+
+        for (const auto& Track : TrackNamesTemp) {
+            TraceJson.append(FirstItem ? "" : ",\n");
+            snprintf(NumberTemp, sizeof(NumberTemp), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,", Track.first);
+            TraceJson.append(NumberTemp).append("\"name\":\"thread_name\",\"args\":{\"name\":");
+            TraceJsonString(TraceJson, Track.second.c_str());
+            TraceJson.append("}}");
+            FirstItem = false;
+        }
+        for (const auto& Event : EventsTemp) {
+            TraceJson.append(FirstItem ? "{\"name\":" : ",\n{\"name\":");
+            TraceJsonString(TraceJson, Event.EventName);
+            TraceJson.append(",\"cat\":");
+            TraceJsonString(TraceJson, Event.EventCategory);
+
+            snprintf(NumberTemp, sizeof(NumberTemp), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                Event.TrackIndex, (double)Event.TimeStart * 1e-3, (double)Event.TimeDuration * 1e-3);
+            TraceJson.append(NumberTemp);
+            if (!Event.EventArgs.empty())
+                TraceJson.append(",\"args\":{").append(Event.EventArgs).append("}");
+            TraceJson.append("}");
+            FirstItem = false;
+        }
+        TraceJson.append("\n]}\n");
+        WriteTraceFile.write(TraceJson.data(), TraceJson.size());
+        return WriteTraceFile.good();
+    }
+
+    vector<TraceEvent> TraceSnapshot() {
+        lock_guard<mutex> Lock(TraceMutex);
+        return TraceEvents;
+    }
+
+    size_t TraceDroppedCount() {
+        return TraceDropped.load(memory_order_relaxed);
+    }
+
+    void TraceClear() {
+        lock_guard<mutex> Lock(TraceMutex);
+        TraceEvents.clear();
+        TraceDropped.store(0, memory_order_relaxed);
+    }
+
+    TraceScope::TraceScope(const char* name, const char* category) :
+        ScopeName(name), ScopeCategory(category)
+    {
+        if (TraceEnabled()) ScopeStart = TraceTimeNow();
+    }
+
+    TraceScope::~TraceScope() {
+        // enabled during scope => skip(start = 0).
+        if (ScopeStart != 0 && TraceEnabled())
+            TracePushSpan(ScopeName, ScopeCategory, ScopeStart, TraceTimeNow() - ScopeStart, TraceThreadTrack());
+    }
+}
@@ -0,0 +1,67 @@
+// spca_tool_tracer, (timeline: host spans + device events), v0.1, RCSZ 2026.10.19
+// export: chrome trace json(chrome://tracing, ui.perfetto.dev), time: ns.
+
+#ifndef _SPCA_TOOL_TRACER_H
+#define _SPCA_TOOL_TRACER_H
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// default capacity(events), full => dropped(count).
+#define SPCA_TRACE_CAPACITY ((size_t)1 << 20)
+// device tracks: track id = base + queue index.
+#define SPCA_TRACE_TRACK_DEVICE ((uint32_t)1000)
+
+namespace SpcaTracer {
+    struct TraceEvent {
+        // static strings(literal).
+        const char* EventName;
+        const char* EventCategory;
+        // steady clock ns.
+        uint64_t TimeStart, TimeDuration;
+        uint32_t TrackIndex;
+        // json object members: "\"bytes\":1024".
+        std::string EventArgs;
+    };
+
+    // disabled(default): trace calls => one atomic load.
+    void TraceEnable(bool enable, size_t capacity = SPCA_TRACE_CAPACITY);
+    bool TraceEnabled();
+
+    uint64_t TraceTimeNow();
+    // host thread => track index(1, 2, 3...).
+    uint32_t TraceThreadTrack();
+    void TraceSetTrackName(uint32_t track, const std::string& name);
+
+    // complete span [start, start + duration).
+    void TracePushSpan(
+        const char* name, const char* category, uint64_t start, uint64_t duration,
+        uint32_t track, const std::string& args = {}
+    );
+    // events => chrome trace json, true:success, false:failed.
+    bool TraceExportChrome(const std::string& filename);
+
+    std::vector<TraceEvent> TraceSnapshot();
+    size_t TraceDroppedCount();
+    void   TraceClear();
+
+    // host span: construct => destruct.
+    class TraceScope {
+    protected:
+        const char* ScopeName;
+        const char* ScopeCategory;
+        uint64_t    ScopeStart = 0;
+    public:
+        TraceScope(const char* name, const char* category);
+        ~TraceScope();
+    };
+}
+
+#define SPCA_TRACE_JOIN_IMPL(a, b) a##b
+#define SPCA_TRACE_JOIN(a, b) SPCA_TRACE_JOIN_IMPL(a, b)
+// host scope span, "name" & "category": literal.
+#define SPCA_TRACE_SCOPE(name, category) \
+    SpcaTracer::TraceScope SPCA_TRACE_JOIN(SpcaTraceScopeTemp, __LINE__)(name, category)
+
+#endif
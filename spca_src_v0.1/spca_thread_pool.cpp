@@ -21,51 +21,671 @@ namespace SpcaTasks {
         }
     }
 
+    // process lifetime(leak): thread caches free after statics destruct.
+    struct TaskBlockGlobal {
+        mutex         BatchMutex;
+        vector<void*> BatchHeads;
+    };
+    static TaskBlockGlobal* TaskBlockGlobals() {
+        static TaskBlockGlobal* Globals = new TaskBlockGlobal[SPCA_TASKS_BLOCK_CLASSES];
+        return Globals;
+    }
+
+    // thread cache: blocks list(next: first word).
+    struct TaskBlockCache {
+        void*  CacheHead[SPCA_TASKS_BLOCK_CLASSES]  = {};
+        size_t CacheCount[SPCA_TASKS_BLOCK_CLASSES] = {};
+
+        ~TaskBlockCache() {
+            for (size_t i = 0; i < SPCA_TASKS_BLOCK_CLASSES; ++i) {
+                while (CacheHead[i] != nullptr) {
+                    void* Block = CacheHead[i];
+                    CacheHead[i] = *(void**)Block;
+                    ::operator delete(Block);
+                }
+                CacheCount[i] = NULL;
+            }
+        }
+    };
+    static thread_local TaskBlockCache ThisBlockCache = {};
+
+    static inline size_t TaskBlockClass(size_t bytes) {
+        size_t Index = NULL;
+        while (Index < SPCA_TASKS_BLOCK_CLASSES && (size_t(64) << Index) < bytes)
+            ++Index;
+        return Index;
+    }
+
+    void* PoolBlockAllocate(size_t bytes) {
+        size_t Index = TaskBlockClass(bytes);
+        if (Index >= SPCA_TASKS_BLOCK_CLASSES)
+            return ::operator new(bytes);
+
+        TaskBlockCache& Cache = ThisBlockCache;
+        if (Cache.CacheHead[Index] == nullptr) {
+            // refill: global batch.
+            TaskBlockGlobal& Global = TaskBlockGlobals()[Index];
+            unique_lock<mutex> Lock(Global.BatchMutex);
+            if (!Global.BatchHeads.empty()) {
+                Cache.CacheHead[Index]  = Global.BatchHeads.back();
+                Cache.CacheCount[Index] = SPCA_TASKS_BLOCK_BATCH;
+                Global.BatchHeads.pop_back();
+            }
+        }
+        if (Cache.CacheHead[Index] == nullptr)
+            return ::operator new(size_t(64) << Index);
+
+        void* Block = Cache.CacheHead[Index];
+        Cache.CacheHead[Index] = *(void**)Block;
+        --Cache.CacheCount[Index];
+        return Block;
+    }
+
+    void PoolBlockFree(void* block, size_t bytes) {
+        size_t Index = TaskBlockClass(bytes);
+        if (Index >= SPCA_TASKS_BLOCK_CLASSES) {
+            ::operator delete(block);
+            return;
+        }
+        TaskBlockCache& Cache = ThisBlockCache;
+        *(void**)block = Cache.CacheHead[Index];
+        Cache.CacheHead[Index] = block;
+        if (++Cache.CacheCount[Index] <= SPCA_TASKS_BLOCK_CACHE)
+            return;
+
+        // cache full => batch(global), producer thread refill.
+        void* BatchHead = Cache.CacheHead[Index];
+        void* BatchTail = BatchHead;
+        for (size_t i = 1; i < SPCA_TASKS_BLOCK_BATCH; ++i)
+            BatchTail = *(void**)BatchTail;
+        Cache.CacheHead[Index] = *(void**)BatchTail;
+        Cache.CacheCount[Index] -= SPCA_TASKS_BLOCK_BATCH;
+        *(void**)BatchTail = nullptr;
+        {
+            TaskBlockGlobal& Global = TaskBlockGlobals()[Index];
+            unique_lock<mutex> Lock(Global.BatchMutex);
+            if (Global.BatchHeads.size() < SPCA_TASKS_BLOCK_GLOBAL) {
+                Global.BatchHeads.push_back(BatchHead);
+                return;
+            }
+        }
+        // global full => free batch.
+        while (BatchHead != nullptr) {
+            void* Block = BatchHead;
+            BatchHead = *(void**)Block;
+            ::operator delete(Block);
+        }
+    }
+
+    void PoolTaskRelease(PoolTaskNode* task, bool execute) {
+        task->TaskHandler(task, execute);
+        PoolBlockFree(task, sizeof(PoolTaskNode));
+    }
+
+#define TASK_STATE_READY   ((uint32_t)1 << 0)
+#define TASK_STATE_WAITING ((uint32_t)1 << 1)
+
+    bool TaskStateBase::IsReady() const {
+        return StateFlags.load(memory_order_acquire) & TASK_STATE_READY;
+    }
+
+// continuations closed(ready), non-node address.
+#define TASK_STATE_CLOSED ((PoolTaskNode*)uintptr_t(1))
+
+    void TaskStateBase::SetReady() {
+        uint32_t FlagsTemp = StateFlags.fetch_or(TASK_STATE_READY, memory_order_acq_rel);
+        if (FlagsTemp & TASK_STATE_WAITING) {
+            unique_lock<mutex> Lock(StateMutex);
+            StateCondition.notify_all();
+        }
+        // continuation may release last future ref => no member access after.
+        PoolTaskNode* Continuations = StateContinuations.exchange(TASK_STATE_CLOSED, memory_order_acq_rel);
+        // stack(lifo) => registration order.
+        PoolTaskNode* Ordered = nullptr;
+        while (Continuations != nullptr) {
+            PoolTaskNode* Next = Continuations->TaskNext;
+            Continuations->TaskNext = Ordered;
+            Ordered = Continuations;
+            Continuations = Next;
+        }
+        while (Ordered != nullptr) {
+            PoolTaskNode* Next = Ordered->TaskNext;
+            PoolTaskRelease(Ordered, true);
+            Ordered = Next;
+        }
+    }
+
+    void TaskStateBase::AddContinuation(PoolTaskNode* continuation) {
+        PoolTaskNode* Head = StateContinuations.load(memory_order_acquire);
+        do {
+            if (Head == TASK_STATE_CLOSED) {
+                PoolTaskRelease(continuation, true);
+                return;
+            }
+            continuation->TaskNext = Head;
+        } while (!StateContinuations.compare_exchange_weak(Head, continuation, memory_order_acq_rel, memory_order_acquire));
+    }
+
+    void TaskStateBase::WaitReady() {
+        if (IsReady()) return;
+        unique_lock<mutex> Lock(StateMutex);
+        StateFlags.fetch_or(TASK_STATE_WAITING, memory_order_acq_rel);
+        StateCondition.wait(Lock, [this] { return IsReady(); });
+    }
+
+    // current thread => pool worker(deque push).
+    static thread_local ThreadTasks* ThisThreadPool   = nullptr;
+    static thread_local size_t       ThisThreadWorker = NULL;
+
+    WorkStealingDeque::WorkStealingDeque(int64_t capacity) {
+        DequeBuffer.store(new DequeArray(capacity), memory_order_relaxed);
+    }
+
+    WorkStealingDeque::~WorkStealingDeque() {
+        delete DequeBuffer.load(memory_order_relaxed);
+    }
+
+    void WorkStealingDeque::PushTask(PoolTaskNode* task) {
+        int64_t Bottom = DequeBottom.load(memory_order_relaxed);
+        int64_t Top    = DequeTop.load(memory_order_acquire);
+        DequeArray* Array = DequeBuffer.load(memory_order_relaxed);
+
+        if (Bottom - Top > Array->ArrayCapacity - 1) {
+            // full => grow(x2), copy [top, bottom).
+            DequeArray* ArrayTemp = new DequeArray(Array->ArrayCapacity * 2);
+            for (int64_t i = Top; i < Bottom; ++i)
+                ArrayTemp->SetSlot(i, Array->GetSlot(i));
+            RetiredArrays.emplace_back(Array);
+            DequeBuffer.store(ArrayTemp, memory_order_release);
+            Array = ArrayTemp;
+        }
+        Array->SetSlot(Bottom, task);
+        atomic_thread_fence(memory_order_release);
+        DequeBottom.store(Bottom + 1, memory_order_relaxed);
+    }
+
+    PoolTaskNode* WorkStealingDeque::PopTask() {
+        int64_t Bottom = DequeBottom.load(memory_order_relaxed) - 1;
+        DequeArray* Array = DequeBuffer.load(memory_order_relaxed);
+        DequeBottom.store(Bottom, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t Top = DequeTop.load(memory_order_relaxed);
+
+        PoolTaskNode* Task = nullptr;
+        if (Top <= Bottom) {
+            Task = Array->GetSlot(Bottom);
+            if (Top == Bottom) {
+                // last task => race thieves(top).
+                if (!DequeTop.compare_exchange_strong(Top, Top + 1, memory_order_seq_cst, memory_order_relaxed))
+                    Task = nullptr;
+                DequeBottom.store(Bottom + 1, memory_order_relaxed);
+            }
+        }
+        else
+            DequeBottom.store(Bottom + 1, memory_order_relaxed);
+        return Task;
+    }
+
+    PoolTaskNode* WorkStealingDeque::StealTask(bool& retry) {
+        int64_t Top = DequeTop.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t Bottom = DequeBottom.load(memory_order_acquire);
+
+        if (Top < Bottom) {
+            DequeArray* Array = DequeBuffer.load(memory_order_acquire);
+            PoolTaskNode* Task = Array->GetSlot(Top);
+            if (!DequeTop.compare_exchange_strong(Top, Top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+                retry = true;
+                return nullptr;
+            }
+            return Task;
+        }
+        return nullptr;
+    }
+
+    int64_t WorkStealingDeque::GetDequeSize() const {
+        int64_t DequeSize = DequeBottom.load(memory_order_relaxed) - DequeTop.load(memory_order_relaxed);
+        return DequeSize > 0 ? DequeSize : NULL;
+    }
+
+    void ThreadTasks::PoolMetricsRegister() {
+        static atomic<uint32_t> PoolIndexCount = {};
+        PoolMetricsLabel = "{pool=\"" + to_string(PoolIndexCount.fetch_add(1)) + "\"}";
+
+        SpcaMetrics::MetricsRegistry& Registry = SpcaMetrics::GlobalMetrics();
+        TasksExecutedCounter = &Registry.GetCounter("spca_tasks_executed_total", "thread_pool tasks executed.");
+
+        Registry.SetSampler("spca_tasks_queue_depth" + PoolMetricsLabel, "thread_pool tasks queue.", SpcaMetrics::MetricGauge,
+            [this] { return (double)GetTaskQueueCount(); });
+        Registry.SetSampler("spca_tasks_working_threads" + PoolMetricsLabel, "thread_pool working threads.", SpcaMetrics::MetricGauge,
+            [this] { return (double)GetWorkingThreadsCount(); });
+        Registry.SetSampler("spca_tasks_active_workers" + PoolMetricsLabel, "thread_pool active workers.", SpcaMetrics::MetricGauge,
+            [this] { return (double)GetWorkersCount(); });
+    }
+
+    void ThreadTasks::PoolMetricsRemove() {
+        // sampler(this) => remove before free.
+        SpcaMetrics::GlobalMetrics().RemoveSampler("spca_tasks_queue_depth" + PoolMetricsLabel);
+        SpcaMetrics::GlobalMetrics().RemoveSampler("spca_tasks_working_threads" + PoolMetricsLabel);
+        SpcaMetrics::GlobalMetrics().RemoveSampler("spca_tasks_active_workers" + PoolMetricsLabel);
+    }
+
+    void ThreadTasks::CreateInjectQueues() {
+        InjectNodesCount = (uint32_t)SpcaTopology::GetCpuTopology().TopologyNodes.size();
+        // nodes + global + high + low.
+        for (size_t i = 0; i < InjectNodesCount + 3; ++i)
+            InjectQueues.emplace_back(make_unique<InjectQueue>());
+    }
+
+    void ThreadTasks::WorkerPlacement(size_t index, vector<uint32_t>& cpus, uint32_t& node) {
+        const SpcaTopology::CpuTopology& Topology = SpcaTopology::GetCpuTopology();
+        const auto& Nodes = Topology.TopologyNodes;
+        cpus.clear();
+        node = SPCA_TASKS_NODE_ANY;
+
+        switch (PlacementPolicy.load()) {
+        case(AffinityCompact): {
+            // cpus(node order) => index.
+            size_t CpusCount = NULL;
+            for (const auto& Node : Nodes) CpusCount += Node.NodeCPUs.size();
+            size_t Position = index % CpusCount;
+            for (uint32_t i = 0; i < Nodes.size(); ++i) {
+                if (Position < Nodes[i].NodeCPUs.size()) {
+                    cpus.push_back(Nodes[i].NodeCPUs[Position]);
+                    node = i;
+                    break;
+                }
+                Position -= Nodes[i].NodeCPUs.size();
+            }
+            break;
+        }
+        case(AffinityScatter): {
+            node = uint32_t(index % Nodes.size());
+            const vector<uint32_t>& NodeCPUs = Nodes[node].NodeCPUs;
+            cpus.push_back(NodeCPUs[(index / Nodes.size()) % NodeCPUs.size()]);
+            break;
+        }
+        case(AffinityNodeGroups): {
+            node = uint32_t(index % Nodes.size());
+            cpus = Nodes[node].NodeCPUs;
+            break;
+        }
+        default: break;
+        }
+    }
+
+    void ThreadTasks::ApplyPlacement(size_t index, bool this_thread) {
+        vector<uint32_t> CpusTemp = {};
+        uint32_t NodeTemp = NULL;
+        WorkerPlacement(index, CpusTemp, NodeTemp);
+        // none: reset(all cpus), only re-pinned workers.
+        if (CpusTemp.empty() && this_thread)
+            return;
+        if (this_thread)
+            SpcaTopology::SetCurrentThreadAffinity(CpusTemp);
+        else
+            SpcaTopology::SetThreadAffinity(WorkerContexts[index]->WorkerThread.native_handle(), CpusTemp);
+        WorkerContexts[index]->WorkerNode.store(NodeTemp, memory_order_relaxed);
+    }
+
+    void ThreadTasks::SetAffinityPolicy(AffinityPolicy policy) {
+        unique_lock<mutex> Lock(WorkersMutex);
+        PlacementPolicy.store(policy);
+        for (size_t i = 0; i < WorkerSlotsCount.load(); ++i)
+            if (WorkerContexts[i]->WorkerState.load() == WorkerRunning)
+                ApplyPlacement(i, false);
+        PSAG_LOGGER::PushLogger(LogInfo, MODULE_LABEL_THDPOOL, "thread_pool affinity policy: %u, workers: %u",
+            (uint32_t)policy, WorkersActive.load());
+    }
+
+    uint32_t ThreadTasks::GetNodesCount() {
+        return InjectNodesCount;
+    }
+
+    uint32_t ThreadTasks::ThisWorkerNode() {
+        if (ThisThreadPool != this)
+            return SPCA_TASKS_NODE_ANY;
+        return WorkerContexts[ThisThreadWorker]->WorkerNode.load(memory_order_relaxed);
+    }
+
     void ThreadTasks::ThreadsTaskExecution(uint32_t workers_num) {
-        // start threads(workers).
-        for (size_t i = 0; i < workers_num; ++i) {
+        for (size_t i = 0; i < SPCA_TASKS_MAX_WORKERS && WorkersActive.load() < workers_num; ++i) {
+            // context before publish: thieves index [0, slots count).
+            if (WorkerContexts[i] == nullptr) {
+                WorkerContexts[i] = make_unique<WorkerContext>();
+                WorkerSlotsCount.store(i + 1, memory_order_release);
+            }
+            WorkerContext& Context = *WorkerContexts[i];
+            // retiring(not exiting) => cancel, thread keeps running.
+            uint32_t Expected = WorkerRetiring;
+            if (Context.WorkerState.compare_exchange_strong(Expected, WorkerRunning)) {
+                ++WorkersActive;
+                continue;
+            }
+            if (Expected != WorkerIdle)
+                continue;
+            // start thread(worker).
+            Context.WorkerState.store(WorkerRunning);
             try {
-                ThreadWorkers.emplace_back([this] {
-                    // loop execution task.
-                    while (true) {
-                        function<void()> WorkTaskExecution;
-                        {
-                            unique_lock<mutex> Lock(PoolMutex);
-                            WorkersCondition.wait(Lock, [this] { return PauseFlag || !PoolTasks.empty(); });
-                            // loop exit.
-                            if (PauseFlag && PoolTasks.empty())
-                                break;
-                            WorkTaskExecution = move(PoolTasks.front());
-                            // queue => delete task.
-                            PoolTasks.pop();
-                        }
-                        ++WorkingThreadsCount;
-                        WorkTaskExecution();
-                        --WorkingThreadsCount;
-                    }
-                    });
+                Context.WorkerThread = thread([this, i] { WorkerExecution(i); });
             }
             catch (...) {
+                Context.WorkerState.store(WorkerIdle);
                 throw Error::TPerror("failed create thread.", ThisThreadID(), "EXEC_TASK");
             }
+            ++WorkersActive;
         }
     }
 
-    void ThreadTasks::ThreadsTaskFree() {
+    void ThreadTasks::ThreadsTaskRetire(uint32_t workers_num) {
+        for (size_t i = WorkerSlotsCount.load(); i > 0 && WorkersActive.load() > workers_num; --i) {
+            uint32_t Expected = WorkerRunning;
+            if (WorkerContexts[i - 1]->WorkerState.compare_exchange_strong(Expected, WorkerRetiring))
+                --WorkersActive;
+        }
+        // parked retiring => wake(exit).
+        WakeWorkers(true);
+    }
+
+    void ThreadTasks::ThreadsTaskCollect() {
+        for (size_t i = 0; i < WorkerSlotsCount.load(); ++i) {
+            WorkerContext& Context = *WorkerContexts[i];
+            if (Context.WorkerState.load() != WorkerExiting)
+                continue;
+            // exiting: own deque drained, join short.
+            if (Context.WorkerThread.joinable())
+                Context.WorkerThread.join();
+            Context.WorkerState.store(WorkerIdle);
+        }
+    }
+
+    bool ThreadTasks::WorkerRetire(size_t index) {
+        WorkerContext& Context = *WorkerContexts[index];
+        uint32_t Expected = WorkerRetiring;
+        // resize(grow) cancel => keep running.
+        if (!Context.WorkerState.compare_exchange_strong(Expected, WorkerExiting))
+            return false;
+
+        // own deque => global queue(pending unchanged), thieves may race(deque safe).
+        size_t MovedCount = NULL;
+        {
+            InjectQueue& Queue = *InjectQueues[InjectNodesCount];
+            unique_lock<mutex> Lock(Queue.QueueMutex);
+            while (PoolTaskNode* Task = Context.TaskDeque.PopTask()) {
+                Queue.QueueTasks.push_back(Task);
+                Queue.QueueCount.fetch_add(1, memory_order_relaxed);
+                ++MovedCount;
+            }
+        }
+        if (MovedCount > NULL && SleepingThreadsCount.load() > NULL)
+            WakeWorkers(MovedCount > 1);
+        return true;
+    }
+
+    void ThreadTasks::WorkerExecution(size_t index) {
+        ThisThreadPool   = this;
+        ThisThreadWorker = index;
+        WorkerContexts[index]->StealRandom = (uint64_t)ThisThreadID() | 1;
+        ApplyPlacement(index, true);
+
+        // loop execution task.
+        while (true) {
+            // retire: after current task(outermost), resize non-stall.
+            if (WorkerContexts[index]->WorkerState.load() == WorkerRetiring && WorkerRetire(index))
+                break;
+            PoolTaskNode* Task = nullptr;
+            // spin: find rounds(yield) => park.
+            for (uint32_t i = 0; i < SPCA_TASKS_SPIN_ROUNDS; ++i) {
+                if ((Task = WorkerFindTask(index)) != nullptr)
+                    break;
+                this_thread::yield();
+            }
+            if (Task != nullptr) {
+                ExecuteTask(Task);
+                continue;
+            }
+            // loop exit: paused & drained.
+            if (PauseFlag.load() && PendingTasksCount.load() == NULL)
+                break;
+
+            // park: sleeping(sc) => pending(sc), push: pending(sc) => sleeping(sc).
+            uint64_t Epoch = WakeEpoch.load();
+            SleepingThreadsCount.fetch_add(1);
+            if (PendingTasksCount.load() == NULL && !PauseFlag.load() &&
+                WorkerContexts[index]->WorkerState.load() != WorkerRetiring
+            ) {
+                unique_lock<mutex> Lock(PoolMutex);
+                WorkersCondition.wait(Lock, [&] { return WakeEpoch.load() != Epoch; });
+            }
+            SleepingThreadsCount.fetch_sub(1);
+        }
+        ThisThreadPool = nullptr;
+    }
+
+    PoolTaskNode* ThreadTasks::WorkerFindTask(size_t index) {
+        // high queue => own deque(lifo) => node & global queue(fifo) => steal(random victim)
+        // => other nodes => low queue.
+        PoolTaskNode* Task = InjectPopTask(InjectNodesCount + 1);
+        if (Task == nullptr)
+            Task = WorkerContexts[index]->TaskDeque.PopTask();
+        uint32_t WorkerNode = WorkerContexts[index]->WorkerNode.load(memory_order_relaxed);
+        if (Task == nullptr)
+            Task = InjectPopNode(WorkerNode, false);
+
+        size_t WorkersCount = WorkerSlotsCount.load(memory_order_acquire);
+        uint64_t& Random = WorkerContexts[index]->StealRandom;
+
+        bool RetryFlag = true;
+        while (Task == nullptr && RetryFlag) {
+            RetryFlag = false;
+            // xorshift64 => start victim.
+            Random ^= Random << 13;
+            Random ^= Random >> 7;
+            Random ^= Random << 17;
+            for (size_t i = 0; i < WorkersCount && Task == nullptr; ++i) {
+                size_t Victim = size_t(Random + i) % WorkersCount;
+                if (Victim != index)
+                    Task = WorkerContexts[Victim]->TaskDeque.StealTask(RetryFlag);
+            }
+        }
+        if (Task == nullptr)
+            Task = InjectPopNode(WorkerNode, true);
+        if (Task == nullptr)
+            Task = InjectPopTask(InjectNodesCount + 2);
+        if (Task != nullptr)
+            PendingTasksCount.fetch_sub(1);
+        return Task;
+    }
+
+    PoolTaskNode* ThreadTasks::InjectPopTask(size_t queue) {
+        InjectQueue& Queue = *InjectQueues[queue];
+        if (Queue.QueueCount.load(memory_order_relaxed) == NULL)
+            return nullptr;
+        PoolTaskNode* Task = nullptr;
+        {
+            unique_lock<mutex> Lock(Queue.QueueMutex);
+            if (Queue.QueueTasks.empty())
+                return nullptr;
+            Task = Queue.QueueTasks.front();
+            Queue.QueueTasks.pop_front();
+            Queue.QueueCount.fetch_sub(1, memory_order_relaxed);
+        }
+        return Task;
+    }
+
+    PoolTaskNode* ThreadTasks::InjectPopNode(uint32_t node, bool others) {
+        size_t NodesCount = InjectNodesCount;
+        PoolTaskNode* Task = nullptr;
+        if (!others) {
+            if (node < NodesCount)
+                Task = InjectPopTask(node);
+            return Task != nullptr ? Task : InjectPopTask(NodesCount);
+        }
+        for (size_t i = 0; i < NodesCount && Task == nullptr; ++i)
+            if (i != node)
+                Task = InjectPopTask(i);
+        return Task;
+    }
+
+    void ThreadTasks::ScheduleTask(PoolTaskNode* task, uint32_t node, TaskPriority priority) {
+        // pending before pause check: exit(paused & pending = 0) can't drop task.
+        PendingTasksCount.fetch_add(1);
+        if (PauseFlag.load()) {
+            PendingTasksCount.fetch_sub(1);
+            PoolTaskRelease(task, false);
+            throw Error::TPerror("failed thread pool stop.", ThisThreadID(), "CREATE_OBJ");
+        }
+        size_t NodesCount = InjectNodesCount;
+        if (node != SPCA_TASKS_NODE_ANY)
+            node = uint32_t(node % NodesCount);
+        // high | low => class queue(shared, fifo).
+        if (priority != PriorityNormal) {
+            InjectQueue& Queue = *InjectQueues[NodesCount + (priority == PriorityHigh ? 1 : 2)];
+            {
+                unique_lock<mutex> Lock(Queue.QueueMutex);
+                Queue.QueueTasks.push_back(task);
+                Queue.QueueCount.fetch_add(1, memory_order_relaxed);
+            }
+        }
+        // worker thread(any | same node) => own deque, other => injection queue.
+        else if (ThisThreadPool == this && (node == SPCA_TASKS_NODE_ANY ||
+            WorkerContexts[ThisThreadWorker]->WorkerNode.load(memory_order_relaxed) == node)
+        )
+            WorkerContexts[ThisThreadWorker]->TaskDeque.PushTask(task);
+        else {
+            InjectQueue& Queue = *InjectQueues[node == SPCA_TASKS_NODE_ANY ? NodesCount : node];
+            unique_lock<mutex> Lock(Queue.QueueMutex);
+            Queue.QueueTasks.push_back(task);
+            Queue.QueueCount.fetch_add(1, memory_order_relaxed);
+        }
+        if (SleepingThreadsCount.load() > NULL)
+            WakeWorkers(false);
+    }
+
+    void ThreadTasks::WakeWorkers(bool all) {
         {
             unique_lock<mutex> Lock(PoolMutex);
-            PauseFlag = true;
+            WakeEpoch.fetch_add(1);
         }
-        try {
+        if (all)
             WorkersCondition.notify_all();
-            for (thread& Worker : ThreadWorkers) {
-                // free all workers(threads).
-                Worker.join();
+        else
+            WorkersCondition.notify_one();
+    }
+
+    void ThreadTasks::ExecuteTask(PoolTaskNode* task) {
+        ++WorkingThreadsCount;
+        PoolTaskRelease(task, true);
+        --WorkingThreadsCount;
+        TasksExecutedCounter->Add();
+    }
+
+    bool ThreadTasks::TryExecuteTask() {
+        PoolTaskNode* Task = nullptr;
+        if (ThisThreadPool == this)
+            Task = WorkerFindTask(ThisThreadWorker);
+        else {
+            // external: high => injection queues => steal => low.
+            Task = InjectPopTask(InjectNodesCount + 1);
+            if (Task == nullptr)
+                Task = InjectPopNode(SPCA_TASKS_NODE_ANY, false);
+            if (Task == nullptr)
+                Task = InjectPopNode(SPCA_TASKS_NODE_ANY, true);
+            size_t WorkersCount = WorkerSlotsCount.load(memory_order_acquire);
+            size_t VictimStart  = (size_t)ThisThreadID();
+            for (size_t i = 0; i < WorkersCount && Task == nullptr; ++i) {
+                bool RetryFlag = false;
+                Task = WorkerContexts[(VictimStart + i) % WorkersCount]->TaskDeque.StealTask(RetryFlag);
+            }
+            if (Task == nullptr)
+                Task = InjectPopTask(InjectNodesCount + 2);
+            if (Task != nullptr)
+                PendingTasksCount.fetch_sub(1);
+        }
+        if (Task == nullptr)
+            return false;
+        ExecuteTask(Task);
+        return true;
+    }
+
+    size_t ThreadTasks::AutoGrainSize(size_t count) {
+        size_t PartsCount = (WorkersActive.load(memory_order_relaxed) + 1) * SPCA_TASKS_PARALLEL_PARTS;
+        return max(count / PartsCount, (size_t)1);
+    }
+
+    void ThreadTasks::ParallelSplitRange(ParallelGroup* group, size_t begin, size_t end) {
+        // failed group => skip ranges.
+        if (group->GroupFailed.load(memory_order_relaxed))
+            return;
+        try {
+            while (end - begin > group->GroupGrain) {
+                size_t Middle = begin + (end - begin) / 2;
+                group->GroupPending.fetch_add(1, memory_order_relaxed);
+
+                auto SplitCall = [this, group, Middle, end]() {
+                    ParallelSplitRange(group, Middle, end);
+                    group->GroupPending.fetch_sub(1, memory_order_release);
+                };
+                try {
+                    ScheduleTask(CreateTaskNode<decltype(SplitCall)>(SplitCall));
+                }
+                catch (...) {
+                    // paused pool => serial(right half).
+                    group->GroupPending.fetch_sub(1, memory_order_relaxed);
+                    ParallelSplitRange(group, Middle, end);
+                }
+                end = Middle;
+            }
+            group->GroupCall(group->GroupContext, begin, end);
+        }
+        catch (...) {
+            if (!group->GroupFailed.exchange(true))
+                group->GroupException = current_exception();
+        }
+    }
+
+    void ThreadTasks::ParallelRangeExecute(size_t begin, size_t end, size_t grain, void* context, ParallelRangeCall call) {
+        if (begin >= end) return;
+        ParallelGroup Group = {};
+        Group.GroupGrain   = grain != NULL ? grain : AutoGrainSize(end - begin);
+        Group.GroupContext = context;
+        Group.GroupCall    = call;
+
+        ParallelSplitRange(&Group, begin, end);
+        // caller helps: execute tasks(nested: own deque) => group done.
+        while (Group.GroupPending.load(memory_order_acquire) != NULL) {
+            if (!TryExecuteTask())
+                this_thread::yield();
+        }
+        if (Group.GroupException != nullptr)
+            rethrow_exception(Group.GroupException);
+    }
+
+    void ThreadTasks::ThreadsTaskFree() {
+        unique_lock<mutex> Lock(WorkersMutex);
+        PauseFlag = true;
+        try {
+            WakeWorkers(true);
+            for (size_t i = 0; i < WorkerSlotsCount.load(); ++i) {
+                // free all workers(threads), running & retiring.
+                if (WorkerContexts[i]->WorkerThread.joinable())
+                    WorkerContexts[i]->WorkerThread.join();
+                WorkerContexts[i]->WorkerState.store(WorkerIdle);
             }
         }
         catch (...) {
             throw Error::TPerror("failed delete thread.", ThisThreadID(), "FREE_POOL");
         }
+        WorkersActive = NULL;
+
+        // non-workers(push) => discard nodes(future: broken_promise).
+        for (size_t i = 0; i < InjectQueues.size(); ++i)
+            while (PoolTaskNode* Task = InjectPopTask(i))
+                PoolTaskRelease(Task, false);
+        for (size_t i = 0; i < WorkerSlotsCount.load(); ++i)
+            while (PoolTaskNode* Task = WorkerContexts[i]->TaskDeque.PopTask())
+                PoolTaskRelease(Task, false);
+        PendingTasksCount = NULL;
     }
 
     uint32_t ThreadTasks::GetWorkingThreadsCount() {
@@ -73,23 +693,221 @@ namespace SpcaTasks {
     }
 
     uint32_t ThreadTasks::GetTaskQueueCount() {
-        uint32_t TasksCount = NULL;
-        {
-            unique_lock<mutex> Lock(PoolMutex);
-            TasksCount = (uint32_t)PoolTasks.size();
-        }
-        return TasksCount;
+        int64_t TasksCount = PendingTasksCount.load();
+        return TasksCount > 0 ? (uint32_t)TasksCount : NULL;
     }
 
     void ThreadTasks::ResizeWorkers(uint32_t resize) {
+        unique_lock<mutex> Lock(WorkersMutex);
+        if (PauseFlag.load()) return;
+        if (resize > SPCA_TASKS_MAX_WORKERS) {
+            PSAG_LOGGER::PushLogger(LogWarning, MODULE_LABEL_THDPOOL, "thread_pool resize: %u > max: %u", resize, SPCA_TASKS_MAX_WORKERS);
+            resize = SPCA_TASKS_MAX_WORKERS;
+        }
+        // exited(retired) => idle slots, reuse.
+        ThreadsTaskCollect();
+        if (resize > WorkersActive.load())
+            ThreadsTaskExecution(resize);
+        else
+            ThreadsTaskRetire(resize);
+    }
+
+    uint32_t ThreadTasks::GetWorkersCount() {
+        return WorkersActive.load();
+    }
+
+    void ThreadTasks::ScaleMonitorExecution(uint32_t min_workers, uint32_t max_workers, uint32_t idle_ms) {
+        uint32_t IdleTime = NULL;
+        unique_lock<mutex> Lock(ScaleMutex);
+        while (!ScaleCondition.wait_for(Lock, chrono::milliseconds(SPCA_TASKS_SCALE_SAMPLE_MS), [this] { return ScaleStopFlag; })) {
+            int64_t  Pending  = PendingTasksCount.load();
+            uint32_t Sleeping = SleepingThreadsCount.load();
+            uint32_t Active   = WorkersActive.load();
+            // manual resize => back into range.
+            uint32_t Target = clamp(Active, min_workers, max_workers);
+
+            // burst: backlog >= workers & none parked => grow(half, at least 1).
+            if (Pending > 0 && Sleeping == NULL && Pending >= (int64_t)Active && Active < max_workers) {
+                Target = min(max_workers, Active + max(Active / 2, 1u));
+                IdleTime = NULL;
+            }
+            // idle: empty & parked workers "idle_ms" => shrink(half parked, at least 1).
+            else if (Pending <= 0 && Sleeping > NULL) {
+                IdleTime += SPCA_TASKS_SCALE_SAMPLE_MS;
+                if (IdleTime >= idle_ms && Active > min_workers) {
+                    uint32_t Retire = max(min(Sleeping, Active) / 2, 1u);
+                    Target = max(min_workers, Active - min(Retire, Active));
+                    IdleTime = NULL;
+                }
+            }
+            else
+                IdleTime = NULL;
+
+            if (Target == Active)
+                continue;
+            Lock.unlock();
+            try {
+                ResizeWorkers(Target);
+                PSAG_LOGGER::PushLogger(LogTrace, MODULE_LABEL_THDPOOL, "thread_pool auto scaling: %u => %u", Active, Target);
+            }
+            catch (...) {
+                PSAG_LOGGER::PushLogger(LogError, MODULE_LABEL_THDPOOL, "thread_pool auto scaling failed resize: %u", Target);
+            }
+            Lock.lock();
+        }
+    }
+
+    bool ThreadTasks::SetAutoScaling(uint32_t min_workers, uint32_t max_workers, uint32_t idle_ms) {
+        if (min_workers > max_workers || max_workers == NULL || max_workers > SPCA_TASKS_MAX_WORKERS) {
+            PSAG_LOGGER::PushLogger(LogError, MODULE_LABEL_THDPOOL, "thread_pool invalid auto scaling: %u - %u", min_workers, max_workers);
+            return false;
+        }
+        StopAutoScaling();
+        ScaleStopFlag = false;
+        try {
+            ScaleMonitor = thread([this, min_workers, max_workers, idle_ms] {
+                ScaleMonitorExecution(min_workers, max_workers, idle_ms);
+            });
+        }
+        catch (...) {
+            PSAG_LOGGER::PushLogger(LogError, MODULE_LABEL_THDPOOL, "thread_pool failed create scaling monitor.");
+            return false;
+        }
+        PSAG_LOGGER::PushLogger(LogInfo, MODULE_LABEL_THDPOOL, "thread_pool auto scaling: %u - %u, idle: %u ms",
+            min_workers, max_workers, idle_ms);
+        return true;
+    }
+
+    void ThreadTasks::StopAutoScaling() {
         {
-            unique_lock<mutex> Lock(PoolMutex);
-            WorkersCondition.notify_all();
+            unique_lock<mutex> Lock(ScaleMutex);
+            ScaleStopFlag = true;
         }
-        ThreadsTaskFree();
+        ScaleCondition.notify_all();
+        if (ScaleMonitor.joinable())
+            ScaleMonitor.join();
+    }
+
+    size_t TaskGraph::AddNode(function<void()> function, const vector<size_t>& predecessors, TaskPriority priority) {
+        size_t NodeIndex = GraphNodes.size();
+        GraphNodes.emplace_back(make_unique<GraphNode>());
+        GraphNodes.back()->NodeFunction     = move(function);
+        GraphNodes.back()->NodePriority     = priority;
+        GraphNodes.back()->NodePredecessors = NULL;
+        for (size_t Predecessor : predecessors)
+            AddEdge(Predecessor, NodeIndex);
+        return NodeIndex;
+    }
+
+    bool TaskGraph::AddEdge(size_t before, size_t after) {
+        if (before >= GraphNodes.size() || after >= GraphNodes.size()) {
+            PSAG_LOGGER::PushLogger(LogError, MODULE_LABEL_THDPOOL, "task_graph invalid edge: %u => %u", (uint32_t)before, (uint32_t)after);
+            return false;
+        }
+        GraphNodes[before]->NodeSuccessors.push_back(after);
+        ++GraphNodes[after]->NodePredecessors;
+        return true;
+    }
+
+    bool TaskGraph::ScheduleNode(size_t index) {
+        try {
+            ExecutePool->PostPriority(GraphNodes[index]->NodePriority, [this, index]() { RunNode(index); });
+            return true;
+        }
+        catch (...) {
+            bool Expected = false;
+            if (ExecuteFailed.compare_exchange_strong(Expected, true, memory_order_acq_rel))
+                ExecuteException = current_exception();
+            return false;
+        }
+    }
+
+    void TaskGraph::RunNode(size_t index) {
+        // post failed successors => run here(loop, no recursion).
+        vector<size_t> InlineNodes = {};
+        while (true) {
+            GraphNode* Node = GraphNodes[index].get();
+            // failed => skip function, successors still counted.
+            if (!ExecuteFailed.load(memory_order_acquire)) {
+                try {
+                    Node->NodeFunction();
+                }
+                catch (...) {
+                    bool Expected = false;
+                    if (ExecuteFailed.compare_exchange_strong(Expected, true, memory_order_acq_rel))
+                        ExecuteException = current_exception();
+                }
+            }
+            for (size_t Successor : Node->NodeSuccessors)
+                if (GraphNodes[Successor]->NodePending.fetch_sub(1, memory_order_acq_rel) == 1 && !ScheduleNode(Successor))
+                    InlineNodes.push_back(Successor);
+
+            if (ExecuteRemaining.fetch_sub(1, memory_order_acq_rel) == 1)
+                break;
+            // inline nodes counted in remaining => graph alive.
+            if (InlineNodes.empty())
+                return;
+            index = InlineNodes.back();
+            InlineNodes.pop_back();
+        }
+        // last node: promise => local, future waiter may reuse | destroy graph.
+        TaskPromise<void> Promise = move(ExecutePromise);
+        exception_ptr Exception = ExecuteException;
+        if (Exception != nullptr)
+            Promise.SetException(Exception);
+        else
+            Promise.SetValue();
+    }
+
+    TaskFuture<void> TaskGraph::Execute(ThreadTasks& pool) {
+        ExecutePromise = TaskPromise<void>();
+        TaskFuture<void> ResultFuture = ExecutePromise.GetFuture();
+
+        // kahn(cycle check) => roots.
+        vector<uint32_t> InDegree(GraphNodes.size());
+        vector<size_t> Roots = {}, Ready = {};
+        for (size_t i = 0; i < GraphNodes.size(); ++i) {
+            InDegree[i] = GraphNodes[i]->NodePredecessors;
+            GraphNodes[i]->NodePending.store(InDegree[i], memory_order_relaxed);
+            if (InDegree[i] == NULL)
+                Roots.push_back(i);
+        }
+        Ready = Roots;
+        size_t Visited = NULL;
+        while (!Ready.empty()) {
+            size_t Index = Ready.back();
+            Ready.pop_back();
+            ++Visited;
+            for (size_t Successor : GraphNodes[Index]->NodeSuccessors)
+                if (--InDegree[Successor] == NULL)
+                    Ready.push_back(Successor);
+        }
+        if (Visited != GraphNodes.size()) {
+            PSAG_LOGGER::PushLogger(LogError, MODULE_LABEL_THDPOOL, "task_graph cycle, nodes: %u", (uint32_t)GraphNodes.size());
+            ExecutePromise.SetException(make_exception_ptr(
+                Error::TPerror("failed task_graph cycle.", ThisThreadID(), "EXEC_GRAPH")
+            ));
+            return ResultFuture;
+        }
+        if (GraphNodes.empty()) {
+            ExecutePromise.SetValue();
+            return ResultFuture;
+        }
+        ExecutePool = &pool;
+        ExecuteFailed = false;
+        ExecuteException = nullptr;
+        ExecuteRemaining.store(GraphNodes.size(), memory_order_release);
+
+        // post failed(pool paused) => root inline, promise still completed(exception).
+        for (size_t Root : Roots)
+            if (!ScheduleNode(Root))
+                RunNode(Root);
+        return ResultFuture;
+    }
 
-        ThreadWorkers.resize(resize);
-        PauseFlag = false;
-        ThreadsTaskExecution(resize);
+    void TaskGraph::Run(ThreadTasks& pool) {
+        TaskFuture<void> Future = Execute(pool);
+        pool.WaitFuture(Future);
+        Future.Get();
     }
-}
\ No newline at end of file
+}
@@ -6,15 +6,56 @@
 #ifndef _SPCA_THREAD_POOL_HPP
 #define _SPCA_THREAD_POOL_HPP
 #include <queue>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <cstring>
+#include <algorithm>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <future>
 
 #include "spca_system_tool/spca_tool_logger.hpp"
+#include "spca_system_tool/spca_tool_metrics.h"
+#include "spca_system_tool/spca_tool_matrix.hpp"
+#include "spca_system_tool/spca_tool_topology.h"
 
 #define MODULE_LABEL_THDPOOL "SPCA_TASKS"
 
+// worker idle: steal rounds(yield) => park.
+#define SPCA_TASKS_SPIN_ROUNDS 64
+// worker deque init capacity(pow2).
+#define SPCA_TASKS_DEQUE_INIT 256
+
+// task node inline callable bytes(node: 64 bytes), larger => heap.
+#define SPCA_TASKS_INLINE_BYTES 48
+// block pool: classes 64 << i bytes, thread cache => global batches.
+#define SPCA_TASKS_BLOCK_CLASSES 4
+#define SPCA_TASKS_BLOCK_CACHE   256
+#define SPCA_TASKS_BLOCK_BATCH   128
+#define SPCA_TASKS_BLOCK_GLOBAL  64
+
+// parallel: auto grain => (workers + 1) * parts ranges.
+#define SPCA_TASKS_PARALLEL_PARTS 8
+// parallel tiles: auto tile cols(elements).
+#define SPCA_TASKS_TILE_COLS (size_t)1024
+
+// task node hint: any worker.
+#define SPCA_TASKS_NODE_ANY UINT32_MAX
+
+// worker slots(contexts) max, resize clamp.
+#define SPCA_TASKS_MAX_WORKERS 256
+// auto scaling: monitor sample period(ms).
+#define SPCA_TASKS_SCALE_SAMPLE_MS 5
+
 // run_time_type_information.
 struct SpcaRttiObject {
     std::string ObjectName;
@@ -54,27 +95,506 @@ namespace SpcaTasks {
         return ReturnInfo;
     }
 
+    // fixed size blocks(pooled), bytes > 512 => operator new.
+    void* PoolBlockAllocate(size_t bytes);
+    void  PoolBlockFree(void* block, size_t bytes);
+
+    // scheduled task(pooled node), owner: pool(execute => release).
+    struct PoolTaskNode {
+        // execute = false: discard(destroy callable only).
+        void (*TaskHandler)(PoolTaskNode* node, bool execute);
+        // continuations list(state).
+        PoolTaskNode* TaskNext;
+        alignas(std::max_align_t) unsigned char TaskStorage[SPCA_TASKS_INLINE_BYTES];
+    };
+    void PoolTaskRelease(PoolTaskNode* task, bool execute);
+
+    template<typename CallType>
+    constexpr bool TaskNodeInline =
+        sizeof(CallType) <= SPCA_TASKS_INLINE_BYTES && alignof(CallType) <= alignof(std::max_align_t);
+
+    template<typename CallType>
+    void TaskNodeHandler(PoolTaskNode* node, bool execute) {
+        CallType* Callable = nullptr;
+        if constexpr (TaskNodeInline<CallType>)
+            Callable = std::launder(reinterpret_cast<CallType*>(node->TaskStorage));
+        else
+            std::memcpy(&Callable, node->TaskStorage, sizeof(CallType*));
+
+        if (execute) (*Callable)();
+        if constexpr (TaskNodeInline<CallType>)
+            Callable->~CallType();
+        else
+            delete Callable;
+    }
+
+    // callable(construct in node storage) => task node.
+    template<typename CallType, typename... ArgsType>
+    PoolTaskNode* CreateTaskNode(ArgsType&&... args) {
+        PoolTaskNode* Node = new (PoolBlockAllocate(sizeof(PoolTaskNode))) PoolTaskNode;
+        try {
+            if constexpr (TaskNodeInline<CallType>)
+                new (Node->TaskStorage) CallType(std::forward<ArgsType>(args)...);
+            else {
+                CallType* Callable = new CallType(std::forward<ArgsType>(args)...);
+                std::memcpy(Node->TaskStorage, &Callable, sizeof(CallType*));
+            }
+        }
+        catch (...) {
+            PoolBlockFree(Node, sizeof(PoolTaskNode));
+            throw;
+        }
+        Node->TaskHandler = &TaskNodeHandler<CallType>;
+        return Node;
+    }
+
+    // future state(pooled block), refs: future + task.
+    class TaskStateBase {
+    protected:
+        std::atomic<uint32_t>   StateFlags{NULL};
+        std::mutex              StateMutex;
+        std::condition_variable StateCondition;
+        // continuations(lock-free stack), ready => closed.
+        std::atomic<PoolTaskNode*> StateContinuations{nullptr};
+    public:
+        std::atomic<uint32_t> StateRefCount{2};
+        std::exception_ptr    StateException = nullptr;
+
+        bool IsReady() const;
+        // waiter flag => completer notify(lock), no waiter => no lock.
+        // then continuations(registration order), completer thread.
+        void SetReady();
+        void WaitReady();
+        // ready => execute now(this thread), keep continuations short(schedule work).
+        void AddContinuation(PoolTaskNode* continuation);
+    };
+
+    struct TaskVoidResult {};
+
+    template<typename ResultType>
+    class TaskState :public TaskStateBase {
+    public:
+        std::optional<std::conditional_t<std::is_void_v<ResultType>, TaskVoidResult, ResultType>> StateResult = {};
+
+        static TaskState* CreateState() {
+            return new (PoolBlockAllocate(sizeof(TaskState))) TaskState();
+        }
+        void ReleaseState() {
+            if (StateRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                this->~TaskState();
+                PoolBlockFree(this, sizeof(TaskState));
+            }
+        }
+    };
+
+    // submit result, get: once(move result | rethrow).
+    template<typename ResultType>
+    class TaskFuture {
+    protected:
+        TaskState<ResultType>* FutureState = nullptr;
+    public:
+        TaskFuture() = default;
+        explicit TaskFuture(TaskState<ResultType>* state) : FutureState(state) {}
+        TaskFuture(TaskFuture&& other) noexcept : FutureState(other.FutureState) { other.FutureState = nullptr; }
+        TaskFuture& operator=(TaskFuture&& other) noexcept {
+            if (this != &other) {
+                if (FutureState != nullptr) FutureState->ReleaseState();
+                FutureState = other.FutureState;
+                other.FutureState = nullptr;
+            }
+            return *this;
+        }
+        TaskFuture(const TaskFuture&) = delete;
+        TaskFuture& operator=(const TaskFuture&) = delete;
+        ~TaskFuture() {
+            if (FutureState != nullptr) FutureState->ReleaseState();
+        }
+
+        bool Valid() const { return FutureState != nullptr; }
+        bool IsReady() const { return FutureState != nullptr && FutureState->IsReady(); }
+        TaskState<ResultType>* GetFutureState() const { return FutureState; }
+        void Wait() {
+            if (FutureState != nullptr) FutureState->WaitReady();
+        }
+
+        ResultType Get() {
+            if (FutureState == nullptr)
+                throw std::future_error(std::future_errc::no_state);
+            FutureState->WaitReady();
+
+            TaskState<ResultType>* State = FutureState;
+            FutureState = nullptr;
+            if (State->StateException != nullptr) {
+                std::exception_ptr ExceptionTemp = State->StateException;
+                State->ReleaseState();
+                std::rethrow_exception(ExceptionTemp);
+            }
+            if constexpr (std::is_void_v<ResultType>)
+                State->ReleaseState();
+            else {
+                ResultType ResultTemp = std::move(*State->StateResult);
+                State->ReleaseState();
+                return ResultTemp;
+            }
+        }
+    };
+
+    // external completion => future, destruct(non-set) => broken_promise.
+    template<typename ResultType>
+    class TaskPromise {
+    protected:
+        TaskState<ResultType>* PromiseState = nullptr;
+        bool FutureRetrieved = false;
+
+        void SetComplete() {
+            if (PromiseState == nullptr)
+                throw std::future_error(std::future_errc::no_state);
+            PromiseState->SetReady();
+        }
+        void CheckSatisfied() {
+            if (PromiseState == nullptr)
+                throw std::future_error(std::future_errc::no_state);
+            if (PromiseState->IsReady())
+                throw std::future_error(std::future_errc::promise_already_satisfied);
+        }
+    public:
+        TaskPromise() : PromiseState(TaskState<ResultType>::CreateState()) {}
+        TaskPromise(TaskPromise&& other) noexcept :
+            PromiseState(other.PromiseState), FutureRetrieved(other.FutureRetrieved)
+        {
+            other.PromiseState = nullptr;
+        }
+        TaskPromise(const TaskPromise&) = delete;
+        TaskPromise& operator=(const TaskPromise&) = delete;
+        TaskPromise& operator=(TaskPromise&& other) noexcept {
+            if (this != &other) {
+                TaskPromise Previous(std::move(*this));
+                PromiseState    = other.PromiseState;
+                FutureRetrieved = other.FutureRetrieved;
+                other.PromiseState = nullptr;
+            }
+            return *this;
+        }
+        ~TaskPromise() {
+            if (PromiseState == nullptr) return;
+            if (!PromiseState->IsReady()) {
+                PromiseState->StateException = std::make_exception_ptr(std::future_error(std::future_errc::broken_promise));
+                PromiseState->SetReady();
+            }
+            // future ref(never retrieved).
+            if (!FutureRetrieved)
+                PromiseState->ReleaseState();
+            PromiseState->ReleaseState();
+        }
+
+        TaskFuture<ResultType> GetFuture() {
+            if (PromiseState == nullptr || FutureRetrieved)
+                throw std::future_error(std::future_errc::future_already_retrieved);
+            FutureRetrieved = true;
+            return TaskFuture<ResultType>(PromiseState);
+        }
+
+        template<typename... ValueType>
+        void SetValue(ValueType&&... value) {
+            CheckSatisfied();
+            PromiseState->StateResult.emplace(std::forward<ValueType>(value)...);
+            SetComplete();
+        }
+        void SetException(std::exception_ptr exception) {
+            CheckSatisfied();
+            PromiseState->StateException = exception;
+            SetComplete();
+        }
+    };
+
+    // all ready => future(ready futures, get each), empty => ready.
+    template<typename ResultType>
+    TaskFuture<std::vector<TaskFuture<ResultType>>> WhenAll(std::vector<TaskFuture<ResultType>> futures) {
+        struct WhenAllContext {
+            std::atomic<size_t> Remaining{NULL};
+            std::vector<TaskFuture<ResultType>> Futures;
+            TaskPromise<std::vector<TaskFuture<ResultType>>> Promise;
+        };
+        auto Context = std::make_shared<WhenAllContext>();
+        // remaining: futures + registration.
+        Context->Remaining = futures.size() + 1;
+        auto ResultFuture = Context->Promise.GetFuture();
+
+        std::vector<TaskStateBase*> States = {};
+        for (const auto& Future : futures)
+            States.push_back(Future.GetFutureState());
+        Context->Futures = std::move(futures);
+
+        auto CompleteOne = [](const std::shared_ptr<WhenAllContext>& context) {
+            if (context->Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                context->Promise.SetValue(std::move(context->Futures));
+        };
+        for (TaskStateBase* State : States) {
+            if (State == nullptr) {
+                CompleteOne(Context);
+                continue;
+            }
+            auto Continuation = [Context, CompleteOne]() { CompleteOne(Context); };
+            State->AddContinuation(CreateTaskNode<decltype(Continuation)>(Continuation));
+        }
+        CompleteOne(Context);
+        return ResultFuture;
+    }
+
+    template<typename ResultType>
+    struct WhenAnyResult {
+        // empty futures: SIZE_MAX.
+        size_t ReadyIndex;
+        std::vector<TaskFuture<ResultType>> Futures;
+    };
+
+    // first ready => future(index + futures).
+    template<typename ResultType>
+    TaskFuture<WhenAnyResult<ResultType>> WhenAny(std::vector<TaskFuture<ResultType>> futures) {
+        struct WhenAnyContext {
+            std::atomic<size_t> ReadyIndex{SIZE_MAX};
+            // gate: first ready + registration.
+            std::atomic<uint32_t> Gate{2};
+            std::vector<TaskFuture<ResultType>> Futures;
+            TaskPromise<WhenAnyResult<ResultType>> Promise;
+        };
+        auto Context = std::make_shared<WhenAnyContext>();
+        auto ResultFuture = Context->Promise.GetFuture();
+
+        std::vector<TaskStateBase*> States = {};
+        for (const auto& Future : futures)
+            States.push_back(Future.GetFutureState());
+        Context->Futures = std::move(futures);
+
+        auto PassGate = [](const std::shared_ptr<WhenAnyContext>& context) {
+            if (context->Gate.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                context->Promise.SetValue(WhenAnyResult<ResultType>{
+                    context->ReadyIndex.load(std::memory_order_acquire), std::move(context->Futures)
+                });
+        };
+        auto ReadyOne = [PassGate](const std::shared_ptr<WhenAnyContext>& context, size_t index) {
+            size_t Expected = SIZE_MAX;
+            if (context->ReadyIndex.compare_exchange_strong(Expected, index, std::memory_order_acq_rel))
+                PassGate(context);
+        };
+        // registration: states alive(futures in context) until gate passed.
+        for (size_t i = 0; i < States.size(); ++i) {
+            if (States[i] == nullptr) {
+                ReadyOne(Context, i);
+                continue;
+            }
+            auto Continuation = [Context, ReadyOne, i]() { ReadyOne(Context, i); };
+            States[i]->AddContinuation(CreateTaskNode<decltype(Continuation)>(Continuation));
+        }
+        if (States.empty())
+            Context->Gate.fetch_sub(1, std::memory_order_acq_rel);
+        PassGate(Context);
+        return ResultFuture;
+    }
+
+    // submit callable: result => state, discarded(never run) => broken_promise.
+    template<typename ResultType, typename FuncType, typename ArgsTuple>
+    struct SubmitCallable {
+        TaskState<ResultType>* CallState;
+        FuncType  CallFunction;
+        ArgsTuple CallArgs;
+
+        template<typename FuncParam, typename... ArgsParam>
+        SubmitCallable(TaskState<ResultType>* state, FuncParam&& function, ArgsParam&&... args) :
+            CallState(state), CallFunction(std::forward<FuncParam>(function)), CallArgs(std::forward<ArgsParam>(args)...)
+        {}
+        ~SubmitCallable() {
+            if (CallState == nullptr) return;
+            CallState->StateException = std::make_exception_ptr(std::future_error(std::future_errc::broken_promise));
+            CallState->SetReady();
+            CallState->ReleaseState();
+        }
+
+        void operator()() {
+            try {
+                if constexpr (std::is_void_v<ResultType>) {
+                    std::apply(std::move(CallFunction), std::move(CallArgs));
+                    CallState->StateResult.emplace();
+                }
+                else
+                    CallState->StateResult.emplace(std::apply(std::move(CallFunction), std::move(CallArgs)));
+            }
+            catch (...) {
+                CallState->StateException = std::current_exception();
+            }
+            CallState->SetReady();
+            CallState->ReleaseState();
+            CallState = nullptr;
+        }
+    };
+
+    // chase-lev deque(Le, Pop, Cohen, Nardelli 2013).
+    // owner: push / pop bottom, thieves: steal top.
+    class WorkStealingDeque {
+    protected:
+        struct DequeArray {
+            int64_t ArrayCapacity;
+            std::unique_ptr<std::atomic<PoolTaskNode*>[]> ArraySlots;
+
+            DequeArray(int64_t capacity) :
+                ArrayCapacity(capacity), ArraySlots(new std::atomic<PoolTaskNode*>[capacity])
+            {}
+            PoolTaskNode* GetSlot(int64_t index) {
+                return ArraySlots[index & (ArrayCapacity - 1)].load(std::memory_order_relaxed);
+            }
+            void SetSlot(int64_t index, PoolTaskNode* task) {
+                ArraySlots[index & (ArrayCapacity - 1)].store(task, std::memory_order_relaxed);
+            }
+        };
+        alignas(64) std::atomic<int64_t> DequeTop    = {};
+        alignas(64) std::atomic<int64_t> DequeBottom = {};
+        std::atomic<DequeArray*> DequeBuffer = {};
+        // grown arrays: thieves may still read, free => destruct.
+        std::vector<std::unique_ptr<DequeArray>> RetiredArrays = {};
+    public:
+        WorkStealingDeque(int64_t capacity = SPCA_TASKS_DEQUE_INIT);
+        ~WorkStealingDeque();
+
+        void PushTask(PoolTaskNode* task);
+        PoolTaskNode* PopTask();
+        // nullptr: empty, "retry" = true: lost race.
+        PoolTaskNode* StealTask(bool& retry);
+
+        int64_t GetDequeSize() const;
+    };
+
+    // scheduling class: high => before local work, low => idle only.
+    enum TaskPriority {
+        PriorityHigh   = 1 << 1,
+        PriorityNormal = 1 << 2,
+        PriorityLow    = 1 << 3
+    };
+
+    // workers placement(numa topology).
+    enum AffinityPolicy {
+        AffinityNone       = 1 << 1, // os scheduler.
+        AffinityCompact    = 1 << 2, // worker => cpu, fill node by node.
+        AffinityScatter    = 1 << 3, // worker => cpu, round robin nodes.
+        AffinityNodeGroups = 1 << 4  // worker => node(all node cpus), round robin.
+    };
+
+    // work-stealing pool: worker deques + injection queues(external push, node hint).
     class ThreadTasks {
     protected:
-        std::vector<std::thread>          ThreadWorkers;
-        std::queue<std::function<void()>> PoolTasks;
-        std::mutex                        PoolMutex;
-        std::condition_variable           WorkersCondition;
-        std::atomic_uint32_t              WorkingThreadsCount{NULL};
+        // slot status: idle(no thread) => running => retiring(resize) => exiting(join).
+        enum WorkerStatus {
+            WorkerIdle     = 0,
+            WorkerRunning  = 1,
+            WorkerRetiring = 2,
+            WorkerExiting  = 3
+        };
+        struct alignas(64) WorkerContext {
+            WorkStealingDeque     TaskDeque    = {};
+            uint64_t              StealRandom  = NULL;
+            std::atomic<uint32_t> WorkerNode   = SPCA_TASKS_NODE_ANY;
+            std::atomic<uint32_t> WorkerState  = WorkerIdle;
+            std::thread           WorkerThread = {};
+        };
+        // slots: fixed capacity, [0, slots count) published(thieves), never freed(pool lifetime).
+        std::vector<std::unique_ptr<WorkerContext>> WorkerContexts;
+        std::atomic<size_t>   WorkerSlotsCount{NULL};
+        std::atomic<uint32_t> WorkersActive{NULL};
+        // resize, placement, scaling => slots(thread handles).
+        std::mutex WorkersMutex;
 
+        struct alignas(64) InjectQueue {
+            std::deque<PoolTaskNode*> QueueTasks;
+            std::mutex                QueueMutex;
+            std::atomic<size_t>       QueueCount{NULL};
+        };
+        // queues: [0, nodes): node hint, [nodes]: global, [nodes + 1]: high, [nodes + 2]: low.
+        std::vector<std::unique_ptr<InjectQueue>> InjectQueues;
+        uint32_t InjectNodesCount = NULL;
+        std::atomic<AffinityPolicy> PlacementPolicy = AffinityNone;
+
+        void CreateInjectQueues();
+        // policy => worker cpus & node(position).
+        void WorkerPlacement(size_t index, std::vector<uint32_t>& cpus, uint32_t& node);
+        void ApplyPlacement(size_t index, bool this_thread);
+
+        // pending: scheduled & not taken(queue depth).
+        std::atomic<int64_t>    PendingTasksCount{NULL};
+        std::atomic<uint32_t>   SleepingThreadsCount{NULL};
+        std::atomic<uint64_t>   WakeEpoch{NULL};
+        std::mutex              PoolMutex;
+        std::condition_variable WorkersCondition;
+        std::atomic_uint32_t    WorkingThreadsCount{NULL};
+
+        // lock: workers mutex, grow: idle slots(low index) | retiring(cancel) => running.
         void ThreadsTaskExecution(uint32_t workers_num);
+        // lock: workers mutex, shrink: running(high index) => retiring, non-blocking.
+        void ThreadsTaskRetire(uint32_t workers_num);
+        // lock: workers mutex, exiting => join => idle.
+        void ThreadsTaskCollect();
         void ThreadsTaskFree();
 
-        bool PauseFlag = false;
-        // current creation object_info.
-        SpcaRttiObject OBJECT_INFO = {};
+        void WorkerExecution(size_t index);
+        // retiring worker: own deque => global queue, exit.
+        bool WorkerRetire(size_t index);
+        PoolTaskNode* WorkerFindTask(size_t index);
+        PoolTaskNode* InjectPopTask(size_t queue);
+        // node hint: this node queue => global => other nodes.
+        PoolTaskNode* InjectPopNode(uint32_t node, bool others);
+        // push => this worker deque(node match) | injection queue, wake parked.
+        // priority(high, low) => class queue(node hint ignored).
+        void ScheduleTask(PoolTaskNode* task, uint32_t node = SPCA_TASKS_NODE_ANY, TaskPriority priority = PriorityNormal);
+        void WakeWorkers(bool all);
+        void ExecuteTask(PoolTaskNode* task);
+
+        // parallel range(type erased), group: stack of caller.
+        using ParallelRangeCall = void (*)(void* context, size_t begin, size_t end);
+        struct ParallelGroup {
+            std::atomic<size_t> GroupPending{NULL};
+            std::atomic<bool>   GroupFailed{false};
+            std::exception_ptr  GroupException = nullptr;
+
+            size_t            GroupGrain   = NULL;
+            void*             GroupContext = nullptr;
+            ParallelRangeCall GroupCall    = nullptr;
+        };
+        // split: right half => task(stealable), left half => continue.
+        void ParallelSplitRange(ParallelGroup* group, size_t begin, size_t end);
+        // caller: split & help(execute tasks) => group done, rethrow first exception.
+        void ParallelRangeExecute(size_t begin, size_t end, size_t grain, void* context, ParallelRangeCall call);
+
+        // metrics: {pool="index"} => queue depth, working threads.
+        std::string PoolMetricsLabel = {};
+        SpcaMetrics::Counter* TasksExecutedCounter = nullptr;
+
+        void PoolMetricsRegister();
+        void PoolMetricsRemove();
+
+        // auto scaling: monitor thread(samples) => resize.
+        std::thread             ScaleMonitor;
+        std::mutex              ScaleMutex;
+        std::condition_variable ScaleCondition;
+        bool                    ScaleStopFlag = false;
+
+        void ScaleMonitorExecution(uint32_t min_workers, uint32_t max_workers, uint32_t idle_ms);
+
+        std::atomic<bool> PauseFlag = false;
+        // current creation object_info(type, static storage).
+        std::atomic<const std::type_info*> OBJECT_INFO = nullptr;
 
     public:
         ThreadTasks(uint32_t init_workers) {
-            ThreadsTaskExecution(init_workers);
+            CreateInjectQueues();
+            PoolMetricsRegister();
+            WorkerContexts.resize(SPCA_TASKS_MAX_WORKERS);
+            {
+                std::unique_lock<std::mutex> Lock(WorkersMutex);
+                ThreadsTaskExecution(init_workers);
+            }
             PSAG_LOGGER::PushLogger(LogInfo, MODULE_LABEL_THDPOOL, "create thread_pool workers: %u", init_workers);
         };
         ~ThreadTasks() {
+            StopAutoScaling();
+            PoolMetricsRemove();
             ThreadsTaskFree();
             PSAG_LOGGER::PushLogger(LogInfo, MODULE_LABEL_THDPOOL, "close(free) thread_pool workers.");
         };
@@ -82,7 +602,7 @@ namespace SpcaTasks {
         // thread_pool: push => tasks queue.
         template<typename InClass, typename... ArgsParam>
         std::future<std::shared_ptr<InClass>> PushTask(ArgsParam... Args) {
-            auto TaskObject = std::make_shared<std::packaged_task<std::shared_ptr<InClass>()>>(
+            std::packaged_task<std::shared_ptr<InClass>()> TaskObject(
                 [Args = std::make_tuple(std::forward<ArgsParam>(Args)...), this]() mutable {
                     try {
                         return std::apply([](auto&&... Args) {
@@ -95,33 +615,327 @@ namespace SpcaTasks {
                     }
                 });
             // create object => get object_info.
-            OBJECT_INFO = _OBJECT_RTTI(TaskObject);
+            OBJECT_INFO.store(&typeid(TaskObject), std::memory_order_relaxed);
 
-            std::future<std::shared_ptr<InClass>> ResultAsync = TaskObject->get_future();
-            {
-                std::unique_lock<std::mutex> Lock(PoolMutex);
-                if (PauseFlag) {
-                    // disable push task.
-                    throw Error::TPerror("failed thread pool stop.", ThisThreadID(), "CREATE_OBJ");
-                    return ResultAsync;
+            std::future<std::shared_ptr<InClass>> ResultAsync = TaskObject.get_future();
+            auto TaskCall = [TaskObject = std::move(TaskObject)]() mutable { TaskObject(); };
+            // paused => throw(disable push task).
+            ScheduleTask(CreateTaskNode<decltype(TaskCall)>(std::move(TaskCall)));
+            return ResultAsync;
+        }
+
+        // thread_pool: callable(args: decay copy | move) => future(pooled state).
+        template<typename FuncType, typename... ArgsType>
+        auto Submit(FuncType&& function, ArgsType&&... args) {
+            return SubmitTask(SPCA_TASKS_NODE_ANY, PriorityNormal, std::forward<FuncType>(function), std::forward<ArgsType>(args)...);
+        }
+
+        // node hint(position, topology): node workers first, idle others steal.
+        template<typename FuncType, typename... ArgsType>
+        auto SubmitNode(uint32_t node, FuncType&& function, ArgsType&&... args) {
+            return SubmitTask(node, PriorityNormal, std::forward<FuncType>(function), std::forward<ArgsType>(args)...);
+        }
+
+        template<typename FuncType, typename... ArgsType>
+        auto SubmitPriority(TaskPriority priority, FuncType&& function, ArgsType&&... args) {
+            return SubmitTask(SPCA_TASKS_NODE_ANY, priority, std::forward<FuncType>(function), std::forward<ArgsType>(args)...);
+        }
+
+        template<typename FuncType, typename... ArgsType>
+        auto SubmitTask(uint32_t node, TaskPriority priority, FuncType&& function, ArgsType&&... args) {
+            using ResultType = std::invoke_result_t<std::decay_t<FuncType>, std::decay_t<ArgsType>...>;
+            using CallType   = SubmitCallable<ResultType, std::decay_t<FuncType>, std::tuple<std::decay_t<ArgsType>...>>;
+
+            TaskState<ResultType>* State = TaskState<ResultType>::CreateState();
+            TaskFuture<ResultType> ResultFuture(State);
+            PoolTaskNode* Node = nullptr;
+            try {
+                Node = CreateTaskNode<CallType>(State, std::forward<FuncType>(function), std::forward<ArgsType>(args)...);
+            }
+            catch (...) {
+                // task ref(never created).
+                State->ReleaseState();
+                throw;
+            }
+            ScheduleTask(Node, node, priority);
+            return ResultFuture;
+        }
+
+        // thread_pool: callable, non-future(fire and forget), exception => log.
+        template<typename FuncType, typename... ArgsType>
+        void Post(FuncType&& function, ArgsType&&... args) {
+            PostTask(SPCA_TASKS_NODE_ANY, PriorityNormal, std::forward<FuncType>(function), std::forward<ArgsType>(args)...);
+        }
+
+        template<typename FuncType, typename... ArgsType>
+        void PostNode(uint32_t node, FuncType&& function, ArgsType&&... args) {
+            PostTask(node, PriorityNormal, std::forward<FuncType>(function), std::forward<ArgsType>(args)...);
+        }
+
+        template<typename FuncType, typename... ArgsType>
+        void PostPriority(TaskPriority priority, FuncType&& function, ArgsType&&... args) {
+            PostTask(SPCA_TASKS_NODE_ANY, priority, std::forward<FuncType>(function), std::forward<ArgsType>(args)...);
+        }
+
+        template<typename FuncType, typename... ArgsType>
+        void PostTask(uint32_t node, TaskPriority priority, FuncType&& function, ArgsType&&... args) {
+            auto TaskCall = [Function = std::decay_t<FuncType>(std::forward<FuncType>(function)),
+                Args = std::tuple<std::decay_t<ArgsType>...>(std::forward<ArgsType>(args)...)]() mutable {
+                try {
+                    std::apply(std::move(Function), std::move(Args));
+                }
+                catch (...) {
+                    PSAG_LOGGER::PushLogger(LogError, MODULE_LABEL_THDPOOL, "post task exception.");
+                }
+            };
+            ScheduleTask(CreateTaskNode<decltype(TaskCall)>(std::move(TaskCall)), node, priority);
+        }
+
+        // continuation: future ready => function(result) task, exception => result future.
+        // non-blocking(worker not waiting), future(void) => function().
+        template<typename ResultType, typename FuncType>
+        auto Then(TaskFuture<ResultType>&& future, FuncType&& function, TaskPriority priority = PriorityNormal) {
+            TaskStateBase* State = future.GetFutureState();
+            auto ThenCall = [Future = std::move(future), Function = std::decay_t<FuncType>(std::forward<FuncType>(function))]() mutable {
+                if constexpr (std::is_void_v<ResultType>) {
+                    Future.Get();
+                    return Function();
                 }
                 else
-                    PoolTasks.emplace([TaskObject]() { (*TaskObject)(); });
+                    return Function(Future.Get());
+            };
+            using ThenResult = std::invoke_result_t<decltype(ThenCall)&>;
+            using CallType   = SubmitCallable<ThenResult, decltype(ThenCall), std::tuple<>>;
+
+            TaskState<ThenResult>* ResultState = TaskState<ThenResult>::CreateState();
+            TaskFuture<ThenResult> ResultFuture(ResultState);
+            PoolTaskNode* Node = nullptr;
+            try {
+                Node = CreateTaskNode<CallType>(ResultState, std::move(ThenCall));
+            }
+            catch (...) {
+                ResultState->ReleaseState();
+                throw;
+            }
+            // non-state => schedule(get: no_state exception).
+            if (State == nullptr) {
+                ScheduleTask(Node, SPCA_TASKS_NODE_ANY, priority);
+                return ResultFuture;
             }
-            WorkersCondition.notify_one();
+            auto Continuation = [this, Node, priority]() {
+                try {
+                    ScheduleTask(Node, SPCA_TASKS_NODE_ANY, priority);
+                }
+                // paused pool: discarded => broken_promise.
+                catch (...) {}
+            };
+            State->AddContinuation(CreateTaskNode<decltype(Continuation)>(Continuation));
+            return ResultFuture;
+        }
 
-            return ResultAsync;
+        // caller helps(execute tasks) => future ready, non-blocking workers.
+        template<typename ResultType>
+        void WaitFuture(TaskFuture<ResultType>& future) {
+            while (future.Valid() && !future.IsReady()) {
+                if (!TryExecuteTask())
+                    std::this_thread::yield();
+            }
         }
 
         SpcaRttiObject GetCreateObjectInfo() {
-            std::unique_lock<std::mutex> Lock(PoolMutex);
-            return OBJECT_INFO;
+            const std::type_info* InfoGet = OBJECT_INFO.load(std::memory_order_relaxed);
+            if (InfoGet == nullptr)
+                return SpcaRttiObject();
+            return SpcaRttiObject{ InfoGet->name(), InfoGet->hash_code() };
         }
 
         uint32_t GetWorkingThreadsCount();
         uint32_t GetTaskQueueCount();
+        // live resize: grow => start workers, shrink => retire(after current task), non-stall.
+        // push during resize: non-throw, retired deque => global queue.
         void     ResizeWorkers(uint32_t resize);
+        uint32_t GetWorkersCount();
+
+        // queue depth >= workers(non-sleeping) => grow, idle(sleeping & empty) "idle_ms" => shrink.
+        // manual resize: monitor adjusts back into [min, max].
+        bool SetAutoScaling(uint32_t min_workers, uint32_t max_workers, uint32_t idle_ms = 200);
+        void StopAutoScaling();
+
+        // placement: running workers => re-pin, new workers => pin at start.
+        void     SetAffinityPolicy(AffinityPolicy policy);
+        uint32_t GetNodesCount();
+        // this thread(pool worker) => node position, other: SPCA_TASKS_NODE_ANY.
+        uint32_t ThisWorkerNode();
+
+        // caller thread: execute one pool task(worker: own deque first), false: none.
+        bool   TryExecuteTask();
+        size_t AutoGrainSize(size_t count);
+
+        // [begin, end) => function(sub_begin, sub_end), grain = 0: auto.
+        // nested calls(in tasks) => splits on worker deque, waiting caller helps.
+        template<typename FuncType>
+        void ParallelForRange(size_t begin, size_t end, const FuncType& function, size_t grain = NULL) {
+            ParallelRangeExecute(begin, end, grain, const_cast<void*>(static_cast<const void*>(&function)),
+                [](void* context, size_t sub_begin, size_t sub_end) {
+                    (*static_cast<const FuncType*>(context))(sub_begin, sub_end);
+                });
+        }
+
+        // [begin, end) => function(index).
+        template<typename FuncType>
+        void ParallelFor(size_t begin, size_t end, const FuncType& function, size_t grain = NULL) {
+            ParallelForRange(begin, end, [&function](size_t sub_begin, size_t sub_end) {
+                for (size_t i = sub_begin; i < sub_end; ++i)
+                    function(i);
+            }, grain);
+        }
+
+        // per-block value(one cache line): concurrent writes, no false sharing(& vector<bool>).
+        template<typename ValueType>
+        struct alignas(64) ParallelBlockValue {
+            ValueType Value;
+        };
+
+        // blocks(grain) => range_function(begin, end, identity), combine: block order(deterministic).
+        template<typename ValueType, typename RangeFunc, typename CombineFunc>
+        ValueType ParallelReduce(
+            size_t begin, size_t end, const ValueType& identity, const RangeFunc& range_function,
+            const CombineFunc& combine, size_t grain = NULL
+        ) {
+            if (begin >= end) return identity;
+            size_t GrainSize   = grain != NULL ? grain : AutoGrainSize(end - begin);
+            size_t BlocksCount = (end - begin + GrainSize - 1) / GrainSize;
+
+            std::vector<ParallelBlockValue<ValueType>> BlockValues(BlocksCount, { identity });
+            ParallelFor(0, BlocksCount, [&](size_t block) {
+                size_t BlockBegin = begin + block * GrainSize;
+                BlockValues[block].Value = range_function(BlockBegin, std::min(BlockBegin + GrainSize, end), identity);
+            }, 1);
+
+            ValueType ResultValue = identity;
+            for (const auto& Block : BlockValues)
+                ResultValue = combine(ResultValue, Block.Value);
+            return ResultValue;
+        }
+
+        // prefix(combine: associative), inclusive | exclusive, input == output allowed.
+        // pass 1: block totals, offsets(serial), pass 2: block scan + offset.
+        template<typename ValueType, typename CombineFunc>
+        void ParallelScan(
+            const ValueType* input, ValueType* output, size_t count, const ValueType& identity,
+            const CombineFunc& combine, bool inclusive = true, size_t grain = NULL
+        ) {
+            if (count == NULL) return;
+            size_t GrainSize   = grain != NULL ? grain : AutoGrainSize(count);
+            size_t BlocksCount = (count + GrainSize - 1) / GrainSize;
+
+            std::vector<ParallelBlockValue<ValueType>> BlockOffsets(BlocksCount, { identity });
+            ParallelFor(0, BlocksCount - 1, [&](size_t block) {
+                ValueType BlockTotal = identity;
+                for (size_t i = block * GrainSize; i < (block + 1) * GrainSize; ++i)
+                    BlockTotal = combine(BlockTotal, input[i]);
+                BlockOffsets[block].Value = BlockTotal;
+            }, 1);
+
+            ValueType CarryValue = identity;
+            for (auto& Offset : BlockOffsets) {
+                ValueType BlockTotal = Offset.Value;
+                Offset.Value = CarryValue;
+                CarryValue = combine(CarryValue, BlockTotal);
+            }
+            ParallelFor(0, BlocksCount, [&](size_t block) {
+                ValueType RunningValue = BlockOffsets[block].Value;
+                for (size_t i = block * GrainSize; i < std::min((block + 1) * GrainSize, count); ++i) {
+                    ValueType Value = input[i];
+                    if (inclusive) {
+                        RunningValue = combine(RunningValue, Value);
+                        output[i] = RunningValue;
+                    }
+                    else {
+                        output[i] = RunningValue;
+                        RunningValue = combine(RunningValue, Value);
+                    }
+                }
+            }, 1);
+        }
+
+        // 2d tiles => function(row_begin, row_end, col_begin, col_end), tile = 0: auto.
+        template<typename FuncType>
+        void ParallelForTiles(
+            size_t rows, size_t cols, const FuncType& function, size_t tile_rows = NULL, size_t tile_cols = NULL
+        ) {
+            if (rows == NULL || cols == NULL) return;
+            if (tile_cols == NULL) tile_cols = std::min(cols, SPCA_TASKS_TILE_COLS);
+            if (tile_rows == NULL) tile_rows = std::max(AutoGrainSize(rows * cols) / tile_cols, (size_t)1);
+
+            size_t TilesCols = (cols + tile_cols - 1) / tile_cols;
+            size_t TilesRows = (rows + tile_rows - 1) / tile_rows;
+            ParallelFor(0, TilesRows * TilesCols, [&](size_t tile) {
+                size_t RowBegin = (tile / TilesCols) * tile_rows;
+                size_t ColBegin = (tile % TilesCols) * tile_cols;
+                function(RowBegin, std::min(RowBegin + tile_rows, rows), ColBegin, std::min(ColBegin + tile_cols, cols));
+            }, 1);
+        }
+
+        // index_matrix tiles: rows = dim x, cols = elements / dim x(1d: 1 row).
+        // 2d: element(row, col) = IMatrixAddressing2D(row, col).
+        template<typename DataType, typename FuncType>
+        void ParallelForMatrix(
+            SpcaIndexMatrix<DataType>& matrix, const FuncType& function, size_t tile_rows = NULL, size_t tile_cols = NULL
+        ) {
+            size_t Elements = matrix.GetIMatrixRawData()->size();
+            size_t Rows = matrix.GetIMatrixMode() == SPCA_TYPE_MATRIX1D ? 1 : matrix.GetIMatrixDimParam(0);
+            if (Rows == NULL || Elements == NULL) return;
+            ParallelForTiles(Rows, Elements / Rows, function, tile_rows, tile_cols);
+        }
     };
+
+    // static dependency graph: nodes(function, predecessors) => pool tasks.
+    // ready node => scheduled(priority), first exception => skip rest & result future.
+    // execute: serial reuse(previous completed), graph lifetime > execution.
+    class TaskGraph {
+    protected:
+        struct GraphNode {
+            std::function<void()> NodeFunction;
+            TaskPriority          NodePriority;
+            std::vector<size_t>   NodeSuccessors;
+            uint32_t              NodePredecessors;
+            std::atomic<uint32_t> NodePending;
+        };
+        std::vector<std::unique_ptr<GraphNode>> GraphNodes = {};
+
+        ThreadTasks*        ExecutePool = nullptr;
+        std::atomic<size_t> ExecuteRemaining{NULL};
+        std::atomic<bool>   ExecuteFailed{false};
+        std::exception_ptr  ExecuteException = nullptr;
+        TaskPromise<void>   ExecutePromise;
+
+        void RunNode(size_t index);
+        // false: post failed(pool paused) => graph failed, caller runs node inline.
+        bool ScheduleNode(size_t index);
+    public:
+        // return node index, predecessors: added nodes.
+        size_t AddNode(
+            std::function<void()> function, const std::vector<size_t>& predecessors = {},
+            TaskPriority priority = PriorityNormal
+        );
+        // before => after, false: invalid index.
+        bool AddEdge(size_t before, size_t after);
+        size_t GetNodesCount() { return GraphNodes.size(); }
+
+        // roots => pool, cycle => future(exception).
+        TaskFuture<void> Execute(ThreadTasks& pool);
+        // execute & caller helps => done, rethrow.
+        void Run(ThreadTasks& pool);
+    };
+
+    // index_matrix data pages => node(position), migrate: allocated & touched pages.
+    template<typename DataType>
+    bool NodeLocalMatrix(SpcaIndexMatrix<DataType>& matrix, uint32_t node) {
+        return SpcaTopology::NodeBindMemory(
+            matrix.GetIMatrixRawData()->data(), matrix.GetIMatrixSizeBytes(), node
+        );
+    }
 }
 
 #endif
\ No newline at end of file